@@ -0,0 +1,298 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+/*
+ * Benchmark of the signal trace backends. A synthetic design with a configurable number of signals, width mix and
+ * toggle rate is traced by each backend. As SystemC cannot be elaborated twice in a process each backend is run in a
+ * child process and the results are collected into a table.
+ */
+
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <scc/report.h>
+#include <scc/trace.h>
+#include <sstream>
+#include <systemc>
+#include <vector>
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#else
+#include <sys/resource.h>
+#endif
+
+namespace po = boost::program_options;
+
+namespace {
+const size_t ERROR_IN_COMMAND_LINE = 1;
+const size_t SUCCESS = 0;
+const size_t ERROR_UNHANDLED_EXCEPTION = 2;
+
+#ifdef WITH_FST
+std::vector<std::string> const backends{"sc_vcd", "pull_vcd", "push_vcd", "fst", "vcd_mt", "iwf"};
+#else
+std::vector<std::string> const backends{"sc_vcd", "pull_vcd", "push_vcd", "iwf"};
+#endif
+std::vector<std::string> const file_extensions{".vcd", ".vcd.gz", ".fst", ".iwf"};
+
+struct bench_config {
+    unsigned signals{1000};
+    unsigned steps{10000};
+    double toggle_rate{0.1};
+    //! relative weights of bool, 32bit, 64bit and 128bit bit vector signals
+    unsigned weights[4]{4, 2, 1, 1};
+};
+
+struct synthetic_design : public sc_core::sc_module {
+    SC_HAS_PROCESS(synthetic_design);
+
+    synthetic_design(sc_core::sc_module_name const& nm, bench_config const& cfg)
+    : sc_core::sc_module(nm)
+    , cfg(cfg)
+    , threshold(static_cast<uint32_t>(cfg.toggle_rate * 4294967295.0)) {
+        auto sum = cfg.weights[0] + cfg.weights[1] + cfg.weights[2] + cfg.weights[3];
+        unsigned counts[4];
+        for(auto i = 1; i < 4; ++i)
+            counts[i] = sum ? cfg.signals * cfg.weights[i] / sum : 0;
+        counts[0] = cfg.signals - counts[1] - counts[2] - counts[3];
+        for(unsigned i = 0; i < counts[0]; ++i)
+            bool_sigs.emplace_back(new sc_core::sc_signal<bool>(sc_core::sc_gen_unique_name("b")));
+        for(unsigned i = 0; i < counts[1]; ++i)
+            u32_sigs.emplace_back(new sc_core::sc_signal<uint32_t>(sc_core::sc_gen_unique_name("w")));
+        for(unsigned i = 0; i < counts[2]; ++i)
+            u64_sigs.emplace_back(new sc_core::sc_signal<uint64_t>(sc_core::sc_gen_unique_name("d")));
+        for(unsigned i = 0; i < counts[3]; ++i)
+            bv_sigs.emplace_back(new sc_core::sc_signal<sc_dt::sc_bv<128>>(sc_core::sc_gen_unique_name("v")));
+        SC_THREAD(run);
+    }
+
+    void trace(sc_core::sc_trace_file* tf) const {
+        for(auto& s : bool_sigs)
+            sc_core::sc_trace(tf, *s, s->name());
+        for(auto& s : u32_sigs)
+            sc_core::sc_trace(tf, *s, s->name());
+        for(auto& s : u64_sigs)
+            sc_core::sc_trace(tf, *s, s->name());
+        for(auto& s : bv_sigs)
+            sc_core::sc_trace(tf, *s, s->name());
+    }
+
+private:
+    inline uint64_t rnd() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    inline bool toggle() { return (rnd() >> 32) < threshold; }
+
+    void run() {
+        for(unsigned step = 0; step < cfg.steps; ++step) {
+            wait(1, sc_core::SC_NS);
+            for(auto& s : bool_sigs)
+                if(toggle())
+                    s->write(!s->read());
+            for(auto& s : u32_sigs)
+                if(toggle())
+                    s->write(static_cast<uint32_t>(rnd()));
+            for(auto& s : u64_sigs)
+                if(toggle())
+                    s->write(rnd());
+            for(auto& s : bv_sigs)
+                if(toggle()) {
+                    sc_dt::sc_bv<128> v;
+                    v.range(63, 0) = rnd();
+                    v.range(127, 64) = rnd();
+                    s->write(v);
+                }
+        }
+        sc_core::sc_stop();
+    }
+
+    bench_config const cfg;
+    uint32_t const threshold;
+    uint64_t state{0x2545F4914F6CDD1DULL};
+    std::vector<std::unique_ptr<sc_core::sc_signal<bool>>> bool_sigs;
+    std::vector<std::unique_ptr<sc_core::sc_signal<uint32_t>>> u32_sigs;
+    std::vector<std::unique_ptr<sc_core::sc_signal<uint64_t>>> u64_sigs;
+    std::vector<std::unique_ptr<sc_core::sc_signal<sc_dt::sc_bv<128>>>> bv_sigs;
+};
+
+sc_core::sc_trace_file* create_trace_file(std::string const& backend, std::string const& name) {
+    if(backend == "sc_vcd")
+        return sc_core::sc_create_vcd_trace_file(name.c_str());
+    if(backend == "pull_vcd")
+        return scc::create_vcd_pull_trace_file(name.c_str());
+    if(backend == "push_vcd")
+        return scc::create_vcd_push_trace_file(name.c_str());
+#ifdef WITH_FST
+    if(backend == "fst")
+        return scc::create_fst_trace_file(name.c_str());
+    if(backend == "vcd_mt")
+        return scc::create_vcd_mt_trace_file(name.c_str());
+#endif
+    if(backend == "iwf")
+        return scc::create_iwf_trace_file(name.c_str());
+    return nullptr;
+}
+
+void close_trace_file(std::string const& backend, sc_core::sc_trace_file* tf) {
+    if(backend == "sc_vcd")
+        sc_core::sc_close_vcd_trace_file(tf);
+    else if(backend == "pull_vcd")
+        scc::close_vcd_pull_trace_file(tf);
+    else if(backend == "push_vcd")
+        scc::close_vcd_push_trace_file(tf);
+#ifdef WITH_FST
+    else if(backend == "fst")
+        scc::close_fst_trace_file(tf);
+    else if(backend == "vcd_mt")
+        scc::close_vcd_mt_trace_file(tf);
+#endif
+    else if(backend == "iwf")
+        scc::close_iwf_trace_file(tf);
+}
+
+uint64_t file_size(std::string const& name) {
+    std::ifstream is(name, std::ios::binary | std::ios::ate);
+    return is.is_open() ? static_cast<uint64_t>(is.tellg()) : 0;
+}
+
+long peak_rss_kb() {
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+int run_backend(std::string const& backend, bench_config const& cfg) {
+    auto const name = "trace_bench_" + backend;
+    for(auto& ext : file_extensions)
+        std::remove((name + ext).c_str());
+    synthetic_design design("design", cfg);
+    auto* tf = create_trace_file(backend, name);
+    if(!tf) {
+        SCCERR() << "unknown trace backend " << backend;
+        return ERROR_IN_COMMAND_LINE;
+    }
+    design.trace(tf);
+    auto wall_start = std::chrono::steady_clock::now();
+    auto cpu_start = std::clock();
+    sc_core::sc_start();
+    close_trace_file(backend, tf);
+    auto cpu_time = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    auto wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    uint64_t bytes = 0;
+    for(auto& ext : file_extensions)
+        bytes += file_size(name + ext);
+    std::cout << "RESULT " << backend << " " << cfg.signals << " " << cfg.steps << " " << wall_time << " " << cpu_time << " "
+              << bytes << " " << peak_rss_kb() << std::endl;
+    return SUCCESS;
+}
+
+int run_all(std::string const& self, std::string const& args, std::vector<std::string> const& selected) {
+    std::cout << std::left << std::setw(10) << "backend" << std::right << std::setw(10) << "signals" << std::setw(10) << "steps"
+              << std::setw(12) << "wall[s]" << std::setw(12) << "cpu[s]" << std::setw(14) << "bytes" << std::setw(14)
+              << "peak RSS[kB]" << std::endl;
+    int ret = SUCCESS;
+    for(auto& backend : selected) {
+        auto cmd = self + " --backend " + backend + args;
+        auto* pipe = popen(cmd.c_str(), "r");
+        if(!pipe) {
+            SCCERR() << "could not run " << cmd;
+            return ERROR_UNHANDLED_EXCEPTION;
+        }
+        char line[1024];
+        bool found = false;
+        while(fgets(line, sizeof(line), pipe)) {
+            std::istringstream is(line);
+            std::string tag, be;
+            unsigned signals, steps;
+            double wall, cpu;
+            uint64_t bytes;
+            long rss;
+            if(is >> tag >> be >> signals >> steps >> wall >> cpu >> bytes >> rss && tag == "RESULT") {
+                std::cout << std::left << std::setw(10) << be << std::right << std::setw(10) << signals << std::setw(10) << steps
+                          << std::setw(12) << std::fixed << std::setprecision(3) << wall << std::setw(12) << cpu
+                          << std::setw(14) << bytes << std::setw(14) << rss << std::endl;
+                found = true;
+            }
+        }
+        if(pclose(pipe) != 0 || !found) {
+            SCCERR() << "benchmark of backend " << backend << " failed";
+            ret = ERROR_UNHANDLED_EXCEPTION;
+        }
+    }
+    return ret;
+}
+} // namespace
+
+int sc_main(int argc, char* argv[]) {
+    sc_core::sc_report_handler::set_actions("/IEEE_Std_1666/deprecated", sc_core::SC_DO_NOTHING);
+    ///////////////////////////////////////////////////////////////////////////
+    // CLI argument parsing
+    ///////////////////////////////////////////////////////////////////////////
+    bench_config cfg;
+    std::string backend, mix;
+    po::options_description desc("Options");
+    // clang-format off
+    desc.add_options()
+            ("help,h", "Print help message")
+            ("backend,b", po::value<std::string>(&backend)->default_value("all"), "trace backend to run (sc_vcd, pull_vcd, push_vcd, fst, vcd_mt, iwf or all)")
+            ("signals,s", po::value<unsigned>(&cfg.signals)->default_value(cfg.signals), "number of signals")
+            ("steps,n", po::value<unsigned>(&cfg.steps)->default_value(cfg.steps), "number of time steps")
+            ("toggle-rate,r", po::value<double>(&cfg.toggle_rate)->default_value(cfg.toggle_rate), "probability of a signal changing per time step")
+            ("width-mix,m", po::value<std::string>(&mix)->default_value("4:2:1:1"), "relative weights of bool:uint32:uint64:sc_bv<128> signals");
+    // clang-format on
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm); // can throw
+        // --help option
+        if(vm.count("help")) {
+            std::cout << "trace backend benchmark" << std::endl << desc << std::endl;
+            return SUCCESS;
+        }
+        po::notify(vm); // throws on error, so do after help in case
+        // there are any problems
+        char sep;
+        std::istringstream is(mix);
+        if(!(is >> cfg.weights[0] >> sep >> cfg.weights[1] >> sep >> cfg.weights[2] >> sep >> cfg.weights[3]))
+            throw po::error("invalid width mix '" + mix + "'");
+    } catch(po::error& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return ERROR_IN_COMMAND_LINE;
+    }
+    scc::init_logging(scc::log::WARNING);
+    if(backend != "all")
+        return run_backend(backend, cfg);
+    std::ostringstream args;
+    args << " --signals " << cfg.signals << " --steps " << cfg.steps << " --toggle-rate " << cfg.toggle_rate << " --width-mix " << mix;
+    return run_all(argv[0], args.str(), backends);
+}
@@ -58,7 +58,7 @@ void ahb_initiator_b::invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt
 
 tlm::tlm_phase ahb_initiator_b::send(payload_type& trans, ahb_initiator_b::tx_state* txs, tlm::tlm_phase phase) {
     sc_core::sc_time delay;
-    SCCTRACE(SCMOD) << "Send REQ";
+    SCCTRACE(log_hndl) << "Send REQ";
     tlm::tlm_sync_enum ret = socket_fw->nb_transport_fw(trans, phase, delay);
     if(ret == tlm::TLM_UPDATED) {
         wait(delay);
@@ -71,7 +71,7 @@ tlm::tlm_phase ahb_initiator_b::send(payload_type& trans, ahb_initiator_b::tx_st
 }
 
 void ahb_initiator_b::transport(payload_type& trans, bool blocking) {
-    SCCTRACE(SCMOD) << "got transport req for id=" << &trans;
+    SCCTRACE(log_hndl) << "got transport req for id=" << &trans;
     if(blocking) {
         sc_time t;
         socket_fw->b_transport(trans, t);
@@ -85,7 +85,7 @@ void ahb_initiator_b::transport(payload_type& trans, bool blocking) {
         auto timing_e = trans.set_extension<atp::timing_params>(nullptr);
 
         txs->active_tx = &trans;
-        SCCTRACE(SCMOD) << "start transport req for id=" << &trans;
+        SCCTRACE(log_hndl) << "start transport req for id=" << &trans;
 
         auto* ext = trans.get_extension<ahb::ahb_extension>();
         /// Timing
@@ -117,7 +117,7 @@ void ahb_initiator_b::transport(payload_type& trans, bool blocking) {
         }
         tlm::tlm_phase next_phase{tlm::UNINITIALIZED_PHASE};
         addr_chnl.wait();
-        SCCTRACE(SCMOD) << "starting read address phase of tx with id=" << &trans;
+        SCCTRACE(log_hndl) << "starting read address phase of tx with id=" << &trans;
         auto res = send(trans, txs, tlm::BEGIN_REQ);
         if(res == tlm::BEGIN_RESP)
             next_phase = res;
@@ -134,7 +134,7 @@ void ahb_initiator_b::transport(payload_type& trans, bool blocking) {
             next_phase = tlm::UNINITIALIZED_PHASE;
             // Handle optional CRESP response
             if(std::get<0>(entry) == &trans && std::get<1>(entry) == tlm::BEGIN_RESP) {
-                SCCTRACE(SCMOD) << "received last beat of tx with id=" << &trans;
+                SCCTRACE(log_hndl) << "received last beat of tx with id=" << &trans;
                 auto delay_in_cycles = timing_e ? (trans.is_read() ? timing_e->rbr : timing_e->br) : br.value;
                 for(unsigned i = 0; i < delay_in_cycles; ++i)
                     wait(clk_i.posedge_event());
@@ -144,16 +144,16 @@ void ahb_initiator_b::transport(payload_type& trans, bool blocking) {
                 sc_time delay = clk_if ? clk_if->period() - 1_ps : SC_ZERO_TIME;
                 socket_fw->nb_transport_fw(trans, phase, delay);
                 if(burst_length)
-                    SCCWARN(SCMOD) << "got wrong number of burst beats, expected " << exp_burst_length << ", got "
-                                   << exp_burst_length - burst_length;
+                    SCCWARN(log_hndl) << "got wrong number of burst beats, expected " << exp_burst_length << ", got "
+                                      << exp_burst_length - burst_length;
                 wait(clk_i.posedge_event());
                 finished = true;
             }
         } while(!finished);
         data_chnl.post();
-        SCCTRACE(SCMOD) << "finished non-blocking protocol";
+        SCCTRACE(log_hndl) << "finished non-blocking protocol";
         txs->active_tx = nullptr;
         any_tx_finished.notify(SC_ZERO_TIME);
     }
-    SCCTRACE(SCMOD) << "finished transport req for id=" << &trans;
+    SCCTRACE(log_hndl) << "finished transport req for id=" << &trans;
 }
@@ -118,6 +118,7 @@ private:
 
     unsigned m_clock_counter{0};
     unsigned m_prev_clk_cnt{0};
+    scc::log_verbosity_handle log_hndl{this->name()};
 };
 
 /**
@@ -68,6 +68,7 @@ private:
 
     tlm_utils::peq_with_get<tlm::tlm_generic_payload> inqueue{"inqueue"};
     tlm_utils::peq_with_get<tlm::tlm_generic_payload> tx_in_flight{"tx_in_flight"};
+    scc::log_verbosity_handle log_hndl{this->name()};
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -102,7 +103,7 @@ template <unsigned DATA_WIDTH, unsigned ADDR_WIDTH> inline void initiator<DATA_W
         wait(inqueue.get_event());
         while(auto trans = inqueue.get_next_transaction()) {
             sc_assert(trans->get_data_length() * 8 <= DATA_WIDTH && "Transaction length larger than bus width, this is not supported");
-            SCCDEBUG(SCMOD) << "Recv beg req for read to addr 0x" << std::hex << trans->get_address();
+            SCCDEBUG(log_hndl) << "Recv beg req for read to addr 0x" << std::hex << trans->get_address();
             auto bytes_exp = scc::ilog2(trans->get_data_length());
             auto width_exp = scc::ilog2(DATA_WIDTH / 8);
             size_t size = 0;
@@ -120,7 +121,7 @@ template <unsigned DATA_WIDTH, unsigned ADDR_WIDTH> inline void initiator<DATA_W
             do {
                 wait(HCLK_i.posedge_event());
             } while(!hready);
-            SCCDEBUG(SCMOD) << "Send end req for read to addr 0x" << std::hex << trans->get_address();
+            SCCDEBUG(log_hndl) << "Send end req for read to addr 0x" << std::hex << trans->get_address();
             tlm::tlm_phase phase{tlm::END_REQ};
             sc_core::sc_time delay;
             auto res = tsckt->nb_transport_bw(*trans, phase, delay);
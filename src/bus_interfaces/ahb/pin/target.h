@@ -72,6 +72,7 @@ private:
     tlm_utils::peq_with_get<tlm::tlm_generic_payload> resp_que{"resp_que"};
     tlm_utils::peq_with_get<tlm::tlm_generic_payload> tx_in_flight{"tx_in_flight"};
     bool waiting4end_req{false};
+    scc::log_verbosity_handle log_hndl{this->name()};
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -158,8 +159,8 @@ template <unsigned DATA_WIDTH, unsigned ADDR_WIDTH> void target<DATA_WIDTH, ADDR
                 for(size_t i = start_offs * 8, j = 0; i < DATA_WIDTH; i += 8, ++j)
                     *(uint8_t*)(gp->get_data_ptr() + j) = wdata.range(i + 7, i).to_uint();
             }
-            SCCDEBUG(SCMOD) << "Send beg req for " << (gp->is_write() ? "write to" : "read from") << " addr 0x" << std::hex
-                            << gp->get_address();
+            SCCDEBUG(log_hndl) << "Send beg req for " << (gp->is_write() ? "write to" : "read from") << " addr 0x" << std::hex
+                               << gp->get_address();
             sc_core::sc_time delay;
             tlm::tlm_phase phase{tlm::BEGIN_REQ};
             auto res = isckt->nb_transport_fw(*gp, phase, delay);
@@ -168,14 +169,14 @@ template <unsigned DATA_WIDTH, unsigned ADDR_WIDTH> void target<DATA_WIDTH, ADDR
                 wait(end_req_evt);
                 phase = tlm::END_REQ;
             }
-            SCCDEBUG(SCMOD) << "Recv end req for " << (gp->is_write() ? "write to" : "read from") << " addr 0x" << std::hex
-                            << gp->get_address();
+            SCCDEBUG(log_hndl) << "Recv end req for " << (gp->is_write() ? "write to" : "read from") << " addr 0x" << std::hex
+                               << gp->get_address();
             if(phase != tlm::BEGIN_RESP) {
                 auto resp = wait4tx(resp_que);
                 sc_assert(gp == resp);
             }
-            SCCDEBUG(SCMOD) << "Recv beg resp for " << (gp->is_write() ? "write to" : "read from") << " addr 0x" << std::hex
-                            << gp->get_address();
+            SCCDEBUG(log_hndl) << "Recv beg resp for " << (gp->is_write() ? "write to" : "read from") << " addr 0x" << std::hex
+                               << gp->get_address();
             if(gp->is_read()) {
                 data_t data{0};
                 for(size_t i = start_offs * 8, j = 0; j < len; i += 8, ++j)
@@ -184,8 +185,8 @@ template <unsigned DATA_WIDTH, unsigned ADDR_WIDTH> void target<DATA_WIDTH, ADDR
             }
             delay = sc_core::SC_ZERO_TIME;
             phase = tlm::END_RESP;
-            SCCDEBUG(SCMOD) << "Send end resp for " << (gp->is_write() ? "write to" : "read from") << " addr 0x" << std::hex
-                            << gp->get_address();
+            SCCDEBUG(log_hndl) << "Send end resp for " << (gp->is_write() ? "write to" : "read from") << " addr 0x" << std::hex
+                               << gp->get_address();
             res = isckt->nb_transport_fw(*gp, phase, delay);
             gp->release();
             HREADY_o.write(true);
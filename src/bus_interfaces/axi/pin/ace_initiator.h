@@ -196,6 +196,7 @@ private:
     void write_ar(tlm::tlm_generic_payload& trans);
     void write_aw(tlm::tlm_generic_payload& trans);
     void write_wdata(tlm::tlm_generic_payload& trans, unsigned beat);
+    scc::log_verbosity_handle log_hndl{this->name()};
 };
 
 } // namespace pin
@@ -308,7 +309,7 @@ template <typename CFG> inline void axi::pin::ace_initiator<CFG>::write_wdata(tl
 
 template <typename CFG> typename CFG::data_t axi::pin::ace_initiator<CFG>::get_cache_data_for_beat(fsm_handle* fsm_hndl) {
     auto beat_count = fsm_hndl->beat_count;
-    // SCCTRACE(SCMOD) << " " ;
+    // SCCTRACE(log_hndl) << " " ;
     auto size = axi::get_burst_size(*fsm_hndl->trans);
     auto byte_offset = beat_count * size;
     auto offset = (fsm_hndl->trans->get_address() + byte_offset) & (CFG::BUSWIDTH / 8 - 1);
@@ -342,7 +343,7 @@ template <typename CFG> typename CFG::data_t axi::pin::ace_initiator<CFG>::get_c
 template <typename CFG> inline void axi::pin::ace_initiator<CFG>::setup_callbacks(fsm_handle* fsm_hndl) {
     fsm_hndl->fsm->cb[RequestPhaseBeg] = [this, fsm_hndl]() -> void {
         if(fsm_hndl->is_snoop) {
-            SCCTRACE(SCMOD) << " for snoop in RequestPhaseBeg ";
+            SCCTRACE(log_hndl) << " for snoop in RequestPhaseBeg ";
         } else {
             fsm_hndl->beat_count = 0;
             outstanding_cnt[fsm_hndl->trans->get_command()]++;
@@ -470,7 +471,7 @@ template <typename CFG> inline void axi::pin::ace_initiator<CFG>::setup_callback
         }
     };
     fsm_hndl->fsm->cb[Ack] = [this, fsm_hndl]() -> void {
-        SCCTRACE(SCMOD) << "in ACK of setup_cb for " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << "in ACK of setup_cb for " << *fsm_hndl->trans;
         if(fsm_hndl->trans->is_read()) {
             rack_vl.notify(sc_core::SC_ZERO_TIME);
         }
@@ -572,7 +573,7 @@ template <typename CFG> inline void axi::pin::ace_initiator<CFG>::r_t() {
             /* for Make Trans, Clean Trans and Read barrier Trans, no  read data transfer on r_t, only response on r_t
              *  */
             if(axi::is_dataless(e)) {
-                SCCTRACE(SCMOD) << " r_t() for Make/Clean/Barrier Trans" << *fsm_hndl->trans;
+                SCCTRACE(log_hndl) << " r_t() for Make/Clean/Barrier Trans" << *fsm_hndl->trans;
                 react(axi::fsm::protocol_time_point_e::BegRespE, fsm_hndl);
             } else {
                 auto tp = CFG::IS_LITE || this->r_last->read() ? axi::fsm::protocol_time_point_e::BegRespE
@@ -674,8 +675,8 @@ template <typename CFG> inline void axi::pin::ace_initiator<CFG>::ac_t() {
     while(true) {
         wait(this->ac_valid.posedge_event() | clk_delayed);
         if(this->ac_valid.read()) {
-            SCCTRACE(SCMOD) << "ACVALID detected, for address 0x" << std::hex << this->ac_addr.read();
-            SCCTRACE(SCMOD) << "in ac_t(), create snoop trans with data_len= " << data_len;
+            SCCTRACE(log_hndl) << "ACVALID detected, for address 0x" << std::hex << this->ac_addr.read();
+            SCCTRACE(log_hndl) << "in ac_t(), create snoop trans with data_len= " << data_len;
             auto gp = tlm::scc::tlm_mm<>::get().allocate<axi::ace_extension>(data_len, true);
             gp->set_address(this->ac_addr.read());
             gp->set_command(tlm::TLM_READ_COMMAND); // snoop command
@@ -712,13 +713,13 @@ template <typename CFG> inline void axi::pin::ace_initiator<CFG>::cd_t() {
     while(true) {
         // cd_vl notified in BEGIN_PARTIAL_REQ ( val=1 ??)or in BEG_RESP(val=3??)
         std::tie(val, fsm_hndl) = cd_vl.get();
-        SCCTRACE(SCMOD) << __FUNCTION__ << " val = " << (uint16_t)val << " beat_count = " << fsm_hndl->beat_count;
-        SCCTRACE(SCMOD) << __FUNCTION__ << " got snoop beat of trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << __FUNCTION__ << " val = " << (uint16_t)val << " beat_count = " << fsm_hndl->beat_count;
+        SCCTRACE(log_hndl) << __FUNCTION__ << " got snoop beat of trans " << *fsm_hndl->trans;
         // data already packed in Trans in END_REQ via calling operation_cb
         auto ext = fsm_hndl->trans->get_extension<axi::ace_extension>();
         this->cd_data.write(get_cache_data_for_beat(fsm_hndl));
         this->cd_valid.write(val & 0x1);
-        SCCTRACE(SCMOD) << __FUNCTION__ << "() write cd_valid high ";
+        SCCTRACE(log_hndl) << __FUNCTION__ << "() write cd_valid high ";
         this->cd_last->write(val & 0x2);
         do {
             wait(this->cd_ready.posedge_event() | clk_delayed);
@@ -728,12 +729,12 @@ template <typename CFG> inline void axi::pin::ace_initiator<CFG>::cd_t() {
 
                 // here only schedule EndPartResp for cache data because EndResp is scheduled in cr_resp_t() when last beat is transferred
                 if(!(val & 0x2)) { // BEGIN_PARTIAL_REQ ( val=1 ) or in BEG_RESP(val=3)
-                    SCCTRACE(SCMOD) << __FUNCTION__ << "() receives cd_ready high, schedule evt " << evt2str(evt);
+                    SCCTRACE(log_hndl) << __FUNCTION__ << "() receives cd_ready high, schedule evt " << evt2str(evt);
                     react(evt, active_resp_beat[SNOOP]);
                 }
             }
         } while(!this->cd_ready.read());
-        SCCTRACE(SCMOD) << __FUNCTION__ << " finished snoop beat of trans [" << fsm_hndl->trans << "]";
+        SCCTRACE(log_hndl) << __FUNCTION__ << " finished snoop beat of trans [" << fsm_hndl->trans << "]";
         wait(clk_i.posedge_event());
         this->cd_valid.write(false);
         if(val & 0x2) // if last beat, after one clock cd_last shouldbe low
@@ -748,8 +749,8 @@ template <typename CFG> inline void axi::pin::ace_initiator<CFG>::cr_resp_t() {
     while(true) {
         // cr_resp_vl notified in BEG_RESP(val=3??)
         std::tie(val, fsm_hndl) = cr_resp_vl.get();
-        SCCTRACE(SCMOD) << __FUNCTION__ << " (), generate snoop response in cr channel, val = " << (uint16_t)val
-                        << " total beat_num = " << fsm_hndl->beat_count;
+        SCCTRACE(log_hndl) << __FUNCTION__ << " (), generate snoop response in cr channel, val = " << (uint16_t)val
+                           << " total beat_num = " << fsm_hndl->beat_count;
         // data already packed in Trans in END_REQ via bw_o
         auto ext = fsm_hndl->trans->get_extension<axi::ace_extension>();
         this->cr_resp.write((ext->get_cresp()));
@@ -758,11 +759,11 @@ template <typename CFG> inline void axi::pin::ace_initiator<CFG>::cr_resp_t() {
             wait(this->cr_ready.posedge_event() | clk_delayed);
             if(this->cr_ready.read()) {
                 auto evt = axi::fsm::protocol_time_point_e::EndRespE;
-                SCCTRACE(SCMOD) << __FUNCTION__ << "(), schedule EndRespE ";
+                SCCTRACE(log_hndl) << __FUNCTION__ << "(), schedule EndRespE ";
                 react(evt, active_resp_beat[SNOOP]);
             }
         } while(!this->cr_ready.read());
-        SCCTRACE(SCMOD) << "finished snoop response ";
+        SCCTRACE(log_hndl) << "finished snoop response ";
         wait(clk_i.posedge_event());
         this->cr_valid.write(false);
     }
@@ -166,6 +166,7 @@ private:
     void write_ar(tlm::tlm_generic_payload& trans);
     void write_aw(tlm::tlm_generic_payload& trans);
     void write_wdata(tlm::tlm_generic_payload& trans, unsigned beat);
+    scc::log_verbosity_handle log_hndl{this->name()};
 };
 
 } // namespace pin
@@ -286,7 +287,7 @@ template <typename CFG> inline void axi::pin::ace_lite_initiator<CFG>::write_wda
 
 template <typename CFG> typename CFG::data_t axi::pin::ace_lite_initiator<CFG>::get_cache_data_for_beat(fsm_handle* fsm_hndl) {
     auto beat_count = fsm_hndl->beat_count;
-    // SCCTRACE(SCMOD) << " " ;
+    // SCCTRACE(log_hndl) << " " ;
     auto size = axi::get_burst_size(*fsm_hndl->trans);
     auto byte_offset = beat_count * size;
     auto offset = (fsm_hndl->trans->get_address() + byte_offset) & (CFG::BUSWIDTH / 8 - 1);
@@ -320,7 +321,7 @@ template <typename CFG> typename CFG::data_t axi::pin::ace_lite_initiator<CFG>::
 template <typename CFG> inline void axi::pin::ace_lite_initiator<CFG>::setup_callbacks(fsm_handle* fsm_hndl) {
     fsm_hndl->fsm->cb[RequestPhaseBeg] = [this, fsm_hndl]() -> void {
         if(fsm_hndl->is_snoop) {
-            SCCTRACE(SCMOD) << " for snoop in RequestPhaseBeg ";
+            SCCTRACE(log_hndl) << " for snoop in RequestPhaseBeg ";
         } else {
             fsm_hndl->beat_count = 0;
             outstanding_cnt[fsm_hndl->trans->get_command()]++;
@@ -478,7 +479,7 @@ template <typename CFG> inline void axi::pin::ace_lite_initiator<CFG>::r_t() {
             e->add_to_response_array(*e);
             /* dataless trans * */
             if(axi::is_dataless(e)) {
-                SCCTRACE(SCMOD) << " r_t() for Make/Clean/Barrier Trans" << *fsm_hndl->trans;
+                SCCTRACE(log_hndl) << " r_t() for Make/Clean/Barrier Trans" << *fsm_hndl->trans;
                 react(axi::fsm::protocol_time_point_e::BegRespE, fsm_hndl);
             } else {
                 auto tp = CFG::IS_LITE || this->r_last->read() ? axi::fsm::protocol_time_point_e::BegRespE
@@ -124,6 +124,7 @@ private:
     scc::peq<aw_data> aw_que;
     scc::peq<std::tuple<uint8_t, fsm_handle*>> rresp_vl;
     scc::peq<std::tuple<uint8_t, fsm_handle*>> wresp_vl;
+    scc::log_verbosity_handle log_hndl{this->name()};
 };
 } // namespace pin
 } // namespace axi
@@ -131,7 +132,7 @@ private:
 template <typename CFG>
 inline tlm::tlm_sync_enum axi::pin::ace_lite_target<CFG>::nb_transport_bw(payload_type& trans, phase_type& phase, sc_core::sc_time& t) {
     auto ret = tlm::TLM_ACCEPTED;
-    SCCTRACE(SCMOD) << "nb_transport_bw with " << phase << " with delay= " << t << " of trans " << trans;
+    SCCTRACE(log_hndl) << "nb_transport_bw with " << phase << " with delay= " << t << " of trans " << trans;
     if(phase == END_PARTIAL_REQ || phase == tlm::END_REQ) { // read/write
         schedule(phase == tlm::END_REQ ? EndReqE : EndPartReqE, &trans, t, false);
     } else if(phase == axi::BEGIN_PARTIAL_RESP || phase == tlm::BEGIN_RESP) { // read/write response
@@ -146,7 +147,7 @@ inline void axi::pin::ace_lite_target<CFG>::invalidate_direct_mem_ptr(sc_dt::uin
 
 template <typename CFG> typename CFG::data_t axi::pin::ace_lite_target<CFG>::get_read_data_for_beat(fsm_handle* fsm_hndl) {
     auto beat_count = fsm_hndl->beat_count;
-    // SCCTRACE(SCMOD) << " " ;
+    // SCCTRACE(log_hndl) << " " ;
     auto size = axi::get_burst_size(*fsm_hndl->trans);
     auto byte_offset = beat_count * size;
     auto offset = (fsm_hndl->trans->get_address() + byte_offset) & (CFG::BUSWIDTH / 8 - 1);
@@ -231,7 +232,7 @@ template <typename CFG> inline void axi::pin::ace_lite_target<CFG>::setup_callba
         fsm_hndl->beat_count++;
     };
     fsm_hndl->fsm->cb[BegRespE] = [this, fsm_hndl]() -> void {
-        SCCTRACE(SCMOD) << "processing event BegRespE for trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << "processing event BegRespE for trans " << *fsm_hndl->trans;
         auto size = axi::get_burst_size(*fsm_hndl->trans);
         active_resp_beat[fsm_hndl->trans->get_command()] = fsm_hndl;
         switch(fsm_hndl->trans->get_command()) {
@@ -250,7 +251,7 @@ template <typename CFG> inline void axi::pin::ace_lite_target<CFG>::setup_callba
         tlm::tlm_phase phase = tlm::END_RESP;
         sc_core::sc_time t(sc_core::SC_ZERO_TIME);
         auto ret = isckt->nb_transport_fw(*fsm_hndl->trans, phase, t);
-        SCCTRACE(SCMOD) << "EndResp of setup_cb with coherent = " << coherent;
+        SCCTRACE(log_hndl) << "EndResp of setup_cb with coherent = " << coherent;
         fsm_hndl->finish.notify();
         active_resp_beat[fsm_hndl->trans->get_command()] = nullptr;
     };
@@ -266,7 +267,7 @@ template <typename CFG> inline void axi::pin::ace_lite_target<CFG>::ar_t() {
     while(true) {
         wait(this->ar_valid.posedge_event() | clk_delayed);
         if(this->ar_valid.read()) {
-            SCCTRACE(SCMOD) << "ARVALID detected for 0x" << std::hex << this->ar_addr.read();
+            SCCTRACE(log_hndl) << "ARVALID detected for 0x" << std::hex << this->ar_addr.read();
             arid = this->ar_id->read().to_uint();
             arlen = this->ar_len->read().to_uint();
             arsize = this->ar_size->read().to_uint();
@@ -309,8 +310,8 @@ template <typename CFG> inline void axi::pin::ace_lite_target<CFG>::rresp_t() {
     while(true) {
         // rresp_vl notified in BEGIN_PARTIAL_REQ ( val=1 ??)or in BEG_RESP(val=3??)
         std::tie(val, fsm_hndl) = rresp_vl.get();
-        SCCTRACE(SCMOD) << __FUNCTION__ << " val = " << (uint16_t)val << " beat count = " << fsm_hndl->beat_count;
-        SCCTRACE(SCMOD) << __FUNCTION__ << " got read response beat of trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << __FUNCTION__ << " val = " << (uint16_t)val << " beat count = " << fsm_hndl->beat_count;
+        SCCTRACE(log_hndl) << __FUNCTION__ << " got read response beat of trans " << *fsm_hndl->trans;
         auto ext = fsm_hndl->trans->get_extension<axi::ace_extension>();
         this->r_data.write(get_read_data_for_beat(fsm_hndl));
         this->r_resp.write(ext->get_cresp());
@@ -327,7 +328,7 @@ template <typename CFG> inline void axi::pin::ace_lite_target<CFG>::rresp_t() {
                 react(evt, active_resp_beat[tlm::TLM_READ_COMMAND]);
             }
         } while(!this->r_ready.read());
-        SCCTRACE(SCMOD) << "finished read response beat of trans [" << fsm_hndl->trans << "]";
+        SCCTRACE(log_hndl) << "finished read response beat of trans [" << fsm_hndl->trans << "]";
         wait(clk_i.posedge_event());
         this->r_valid.write(false);
         if(!CFG::IS_LITE)
@@ -342,7 +343,7 @@ template <typename CFG> inline void axi::pin::ace_lite_target<CFG>::aw_t() {
     while(true) {
         wait(this->aw_valid.posedge_event() | clk_delayed);
         if(this->aw_valid.event() || (!active_req_beat[tlm::TLM_IGNORE_COMMAND] && this->aw_valid.read())) {
-            SCCTRACE(SCMOD) << "AWVALID detected for 0x" << std::hex << this->aw_addr.read();
+            SCCTRACE(log_hndl) << "AWVALID detected for 0x" << std::hex << this->aw_addr.read();
             // clang-format off
             aw_data awd = {CFG::IS_LITE ? 0U : this->aw_id->read().to_uint(),
                     this->aw_addr.read().to_uint64(),
@@ -407,7 +408,7 @@ template <typename CFG> inline void axi::pin::ace_lite_target<CFG>::wdata_t() {
                 active_req[tlm::TLM_WRITE_COMMAND] = active_req_beat[tlm::TLM_WRITE_COMMAND];
             }
             auto* fsm_hndl = active_req[tlm::TLM_WRITE_COMMAND];
-            SCCTRACE(SCMOD) << "WDATA detected for 0x" << std::hex << this->ar_addr.read();
+            SCCTRACE(log_hndl) << "WDATA detected for 0x" << std::hex << this->ar_addr.read();
             auto& gp = fsm_hndl->trans;
             auto data = this->w_data.read();
             auto strb = this->w_strb.read();
@@ -478,20 +479,20 @@ template <typename CFG> inline void axi::pin::ace_lite_target<CFG>::bresp_t() {
     uint8_t val;
     while(true) {
         std::tie(val, fsm_hndl) = wresp_vl.get();
-        SCCTRACE(SCMOD) << "got write response of trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << "got write response of trans " << *fsm_hndl->trans;
         auto ext = fsm_hndl->trans->get_extension<axi::ace_extension>();
         this->b_resp.write(axi::to_int(ext->get_resp()));
         this->b_valid.write(true);
         if(!CFG::IS_LITE)
             this->b_id->write(ext->get_id());
-        SCCTRACE(SCMOD) << "got write response";
+        SCCTRACE(log_hndl) << "got write response";
         do {
             wait(this->b_ready.posedge_event() | clk_delayed);
             if(this->b_ready.read()) {
                 react(axi::fsm::protocol_time_point_e::EndRespE, active_resp_beat[tlm::TLM_WRITE_COMMAND]);
             }
         } while(!this->b_ready.read());
-        SCCTRACE(SCMOD) << "finished write response of trans [" << fsm_hndl->trans << "]";
+        SCCTRACE(log_hndl) << "finished write response of trans [" << fsm_hndl->trans << "]";
         wait(clk_i.posedge_event());
         this->b_valid.write(false);
     }
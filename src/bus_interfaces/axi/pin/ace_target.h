@@ -145,6 +145,7 @@ private:
 
     unsigned int SNOOP = 3; // TBD??
     void write_ac(tlm::tlm_generic_payload& trans);
+    scc::log_verbosity_handle log_hndl{this->name()};
 };
 
 } // namespace pin
@@ -153,7 +154,7 @@ private:
 template <typename CFG>
 inline tlm::tlm_sync_enum axi::pin::ace_target<CFG>::nb_transport_bw(payload_type& trans, phase_type& phase, sc_core::sc_time& t) {
     auto ret = tlm::TLM_ACCEPTED;
-    SCCTRACE(SCMOD) << "nb_transport_bw with " << phase << " with delay= " << t << " of trans " << trans;
+    SCCTRACE(log_hndl) << "nb_transport_bw with " << phase << " with delay= " << t << " of trans " << trans;
     if(phase == END_PARTIAL_REQ || phase == tlm::END_REQ) { // read/write
         schedule(phase == tlm::END_REQ ? EndReqE : EndPartReqE, &trans, t, false);
     } else if(phase == axi::BEGIN_PARTIAL_RESP || phase == tlm::BEGIN_RESP) { // read/write response
@@ -173,7 +174,7 @@ inline void axi::pin::ace_target<CFG>::invalidate_direct_mem_ptr(sc_dt::uint64 s
 
 template <typename CFG> typename CFG::data_t axi::pin::ace_target<CFG>::get_read_data_for_beat(fsm_handle* fsm_hndl) {
     auto beat_count = fsm_hndl->beat_count;
-    // SCCTRACE(SCMOD) << " " ;
+    // SCCTRACE(log_hndl) << " " ;
     auto size = axi::get_burst_size(*fsm_hndl->trans);
     auto byte_offset = beat_count * size;
     auto offset = (fsm_hndl->trans->get_address() + byte_offset) & (CFG::BUSWIDTH / 8 - 1);
@@ -222,7 +223,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::setup_callbacks(f
     };
     fsm_hndl->fsm->cb[BegReqE] = [this, fsm_hndl]() -> void {
         if(fsm_hndl->is_snoop) {
-            SCCTRACE(SCMOD) << "in BegReq of setup_cb, call write_ac() ";
+            SCCTRACE(log_hndl) << "in BegReq of setup_cb, call write_ac() ";
             active_req[SNOOP] = fsm_hndl;
             write_ac(*fsm_hndl->trans);
             ac_evt.notify(sc_core::SC_ZERO_TIME);
@@ -239,7 +240,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::setup_callbacks(f
 
     fsm_hndl->fsm->cb[EndReqE] = [this, fsm_hndl]() -> void {
         if(fsm_hndl->is_snoop) {
-            SCCTRACE(SCMOD) << "snoop with EndReq evt";
+            SCCTRACE(log_hndl) << "snoop with EndReq evt";
             auto latency = 0;
             snp_resp_queue.push_back(fsm_hndl);
             active_req[SNOOP] = nullptr;
@@ -294,7 +295,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::setup_callbacks(f
         }
     };
     fsm_hndl->fsm->cb[BegRespE] = [this, fsm_hndl]() -> void {
-        SCCTRACE(SCMOD) << "processing event BegRespE for trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << "processing event BegRespE for trans " << *fsm_hndl->trans;
         if(fsm_hndl->is_snoop) {
             tlm::tlm_phase phase = tlm::BEGIN_RESP;
             sc_core::sc_time t;
@@ -316,7 +317,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::setup_callbacks(f
     };
     fsm_hndl->fsm->cb[EndRespE] = [this, fsm_hndl]() -> void {
         if(fsm_hndl->is_snoop) {
-            SCCTRACE(SCMOD) << "  in EndRespE  ";
+            SCCTRACE(log_hndl) << "  in EndRespE  ";
             cd_end_req_evt.notify();
             cr_end_req_evt.notify(); // need to check these two event??
             snp_resp_queue.pop_front();
@@ -327,7 +328,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::setup_callbacks(f
             tlm::tlm_phase phase = tlm::END_RESP;
             sc_core::sc_time t(sc_core::SC_ZERO_TIME);
             auto ret = isckt->nb_transport_fw(*fsm_hndl->trans, phase, t);
-            SCCTRACE(SCMOD) << "EndResp of setup_cb with coherent = " << coherent;
+            SCCTRACE(log_hndl) << "EndResp of setup_cb with coherent = " << coherent;
             if(coherent)
                 schedule(Ack, fsm_hndl->trans, t); // later can add ack_resp_delay to replace t
             else {
@@ -337,7 +338,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::setup_callbacks(f
         }
     };
     fsm_hndl->fsm->cb[Ack] = [this, fsm_hndl]() -> void {
-        SCCTRACE(SCMOD) << " in Ack of setup_cb";
+        SCCTRACE(log_hndl) << " in Ack of setup_cb";
         sc_core::sc_time t(sc_core::SC_ZERO_TIME);
         tlm::tlm_phase phase = axi::ACK;
         auto ret = isckt->nb_transport_fw(*fsm_hndl->trans, phase, t);
@@ -357,7 +358,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::ar_t() {
     while(true) {
         wait(this->ar_valid.posedge_event() | clk_delayed);
         if(this->ar_valid.read()) {
-            SCCTRACE(SCMOD) << "ARVALID detected for 0x" << std::hex << this->ar_addr.read();
+            SCCTRACE(log_hndl) << "ARVALID detected for 0x" << std::hex << this->ar_addr.read();
             if(!CFG::IS_LITE) {
                 arid = this->ar_id->read().to_uint();
                 arlen = this->ar_len->read().to_uint();
@@ -402,8 +403,8 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::rresp_t() {
     while(true) {
         // rresp_vl notified in BEGIN_PARTIAL_REQ ( val=1 ??)or in BEG_RESP(val=3??)
         std::tie(val, fsm_hndl) = rresp_vl.get();
-        SCCTRACE(SCMOD) << __FUNCTION__ << " val = " << (uint16_t)val << " beat count = " << fsm_hndl->beat_count;
-        SCCTRACE(SCMOD) << __FUNCTION__ << " got read response beat of trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << __FUNCTION__ << " val = " << (uint16_t)val << " beat count = " << fsm_hndl->beat_count;
+        SCCTRACE(log_hndl) << __FUNCTION__ << " got read response beat of trans " << *fsm_hndl->trans;
         auto ext = fsm_hndl->trans->get_extension<axi::ace_extension>();
         this->r_data.write(get_read_data_for_beat(fsm_hndl));
         this->r_resp.write(ext->get_cresp());
@@ -420,7 +421,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::rresp_t() {
                 react(evt, active_resp_beat[tlm::TLM_READ_COMMAND]);
             }
         } while(!this->r_ready.read());
-        SCCTRACE(SCMOD) << "finished read response beat of trans [" << fsm_hndl->trans << "]";
+        SCCTRACE(log_hndl) << "finished read response beat of trans [" << fsm_hndl->trans << "]";
         wait(clk_i.posedge_event());
         this->r_valid.write(false);
         if(!CFG::IS_LITE)
@@ -435,7 +436,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::aw_t() {
     while(true) {
         wait(this->aw_valid.posedge_event() | clk_delayed);
         if(this->aw_valid.event() || (!active_req_beat[tlm::TLM_IGNORE_COMMAND] && this->aw_valid.read())) {
-            SCCTRACE(SCMOD) << "AWVALID detected for 0x" << std::hex << this->aw_addr.read();
+            SCCTRACE(log_hndl) << "AWVALID detected for 0x" << std::hex << this->aw_addr.read();
             // clang-format off
             aw_data awd = {CFG::IS_LITE ? 0U : this->aw_id->read().to_uint(),
                     this->aw_addr.read().to_uint64(),
@@ -497,7 +498,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::wdata_t() {
                 active_req[tlm::TLM_WRITE_COMMAND] = active_req_beat[tlm::TLM_WRITE_COMMAND];
             }
             auto* fsm_hndl = active_req[tlm::TLM_WRITE_COMMAND];
-            SCCTRACE(SCMOD) << "WDATA detected for 0x" << std::hex << this->ar_addr.read();
+            SCCTRACE(log_hndl) << "WDATA detected for 0x" << std::hex << this->ar_addr.read();
             auto& gp = fsm_hndl->trans;
             auto data = this->w_data.read();
             auto strb = this->w_strb.read();
@@ -569,20 +570,20 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::bresp_t() {
     uint8_t val;
     while(true) {
         std::tie(val, fsm_hndl) = wresp_vl.get();
-        SCCTRACE(SCMOD) << "got write response of trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << "got write response of trans " << *fsm_hndl->trans;
         auto ext = fsm_hndl->trans->get_extension<axi::ace_extension>();
         this->b_resp.write(axi::to_int(ext->get_resp()));
         this->b_valid.write(true);
         if(!CFG::IS_LITE)
             this->b_id->write(ext->get_id());
-        SCCTRACE(SCMOD) << "got write response";
+        SCCTRACE(log_hndl) << "got write response";
         do {
             wait(this->b_ready.posedge_event() | clk_delayed);
             if(this->b_ready.read()) {
                 react(axi::fsm::protocol_time_point_e::EndRespE, active_resp_beat[tlm::TLM_WRITE_COMMAND]);
             }
         } while(!this->b_ready.read());
-        SCCTRACE(SCMOD) << "finished write response of trans [" << fsm_hndl->trans << "]";
+        SCCTRACE(log_hndl) << "finished write response of trans [" << fsm_hndl->trans << "]";
         wait(clk_i.posedge_event());
         this->b_valid.write(false);
     }
@@ -607,7 +608,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::ac_t() {
         do {
             wait(this->ac_ready.posedge_event() | clk_delayed);
             if(this->ac_ready.read()) {
-                SCCTRACE(SCMOD) << "in ac_t() detect ac_ready high , schedule EndReq";
+                SCCTRACE(log_hndl) << "in ac_t() detect ac_ready high , schedule EndReq";
                 react(axi::fsm::protocol_time_point_e::EndReqE, active_req[SNOOP]);
             }
         } while(!this->ac_ready.read());
@@ -622,14 +623,14 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::cd_t() {
     while(true) {
         wait(this->cd_valid.posedge_event() | clk_delayed);
         if(this->cd_valid.read()) {
-            SCCTRACE(SCMOD) << "in cd_t(), received cd_valid high ";
+            SCCTRACE(log_hndl) << "in cd_t(), received cd_valid high ";
             wait(sc_core::SC_ZERO_TIME);
             auto data = this->cd_data.read();
             if(snp_resp_queue.empty())
                 sc_assert(" snp_resp_queue empty");
             auto* fsm_hndl = snp_resp_queue.front();
             auto beat_count = fsm_hndl->beat_count;
-            SCCTRACE(SCMOD) << "in cd_t(), received beau_count = " << fsm_hndl->beat_count;
+            SCCTRACE(log_hndl) << "in cd_t(), received beau_count = " << fsm_hndl->beat_count;
             auto size = axi::get_burst_size(*fsm_hndl->trans);
             auto byte_offset = beat_count * size;
             auto offset = (fsm_hndl->trans->get_address() + byte_offset) & (CFG::BUSWIDTH / 8 - 1);
@@ -681,7 +682,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::cr_t() {
     while(true) {
         wait(this->cr_valid.posedge_event() | clk_delayed);
         if(this->cr_valid.read()) {
-            SCCTRACE(SCMOD) << "in cr_t()  received cr_valid high ";
+            SCCTRACE(log_hndl) << "in cr_t()  received cr_valid high ";
             wait(sc_core::SC_ZERO_TIME);
 
             auto* fsm_hndl = snp_resp_queue.front();
@@ -690,7 +691,7 @@ template <typename CFG> inline void axi::pin::ace_target<CFG>::cr_t() {
             fsm_hndl->trans->get_extension(e);
             e->set_cresp(crresp);
 
-            SCCTRACE(SCMOD) << " in cr_t()  react() with BegRespE ";
+            SCCTRACE(log_hndl) << " in cr_t()  react() with BegRespE ";
             // hongyu TBD?? schedule BegResp??
             react(axi::fsm::protocol_time_point_e::BegRespE, fsm_hndl);
             wait(cr_end_req_evt); // notify in EndResp
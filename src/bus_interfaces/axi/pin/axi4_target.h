@@ -115,6 +115,7 @@ private:
     scc::peq<aw_data> aw_que;
     scc::peq<std::tuple<uint8_t, fsm_handle*>> rresp_vl;
     scc::peq<std::tuple<uint8_t, fsm_handle*>> wresp_vl;
+    scc::log_verbosity_handle log_hndl{this->name()};
 };
 
 } // namespace pin
@@ -124,7 +125,7 @@ template <typename CFG>
 inline tlm::tlm_sync_enum axi::pin::axi4_target<CFG>::nb_transport_bw(payload_type& trans, phase_type& phase, sc_core::sc_time& t) {
     auto ret = tlm::TLM_ACCEPTED;
     sc_core::sc_time delay = t < clk_if->period() ? sc_core::SC_ZERO_TIME : t; // FIXME: calculate correct time
-    SCCTRACE(SCMOD) << "nb_transport_bw " << phase << " of trans " << trans;
+    SCCTRACE(log_hndl) << "nb_transport_bw " << phase << " of trans " << trans;
     if(phase == axi::END_PARTIAL_REQ || phase == tlm::END_REQ) { // read/write
         schedule(phase == tlm::END_REQ ? EndReqE : EndPartReqE, &trans, delay, false);
     } else if(phase == axi::BEGIN_PARTIAL_RESP || phase == tlm::BEGIN_RESP) { // read/write response
@@ -223,7 +224,7 @@ template <typename CFG> inline void axi::pin::axi4_target<CFG>::setup_callbacks(
         fsm_hndl->beat_count++;
     };
     fsm_hndl->fsm->cb[BegRespE] = [this, fsm_hndl]() -> void {
-        SCCTRACE(SCMOD) << "processing event BegRespE for trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << "processing event BegRespE for trans " << *fsm_hndl->trans;
         auto size = axi::get_burst_size(*fsm_hndl->trans);
         active_resp_beat[fsm_hndl->trans->get_command()] = fsm_hndl;
         switch(fsm_hndl->trans->get_command()) {
@@ -260,7 +261,7 @@ template <typename CFG> inline void axi::pin::axi4_target<CFG>::ar_t() {
             wait(this->ar_valid.posedge_event());
             wait(CLK_DELAY); // verilator might create spurious events
         }
-        SCCTRACE(SCMOD) << "ARVALID detected for 0x" << std::hex << this->ar_addr.read();
+        SCCTRACE(log_hndl) << "ARVALID detected for 0x" << std::hex << this->ar_addr.read();
         if(!CFG::IS_LITE) {
             arid = this->ar_id->read().to_uint();
             arlen = this->ar_len->read().to_uint();
@@ -298,7 +299,7 @@ template <typename CFG> inline void axi::pin::axi4_target<CFG>::rresp_t() {
     uint8_t val;
     while(true) {
         std::tie(val, fsm_hndl) = rresp_vl.get();
-        SCCTRACE(SCMOD) << "got read response beat of trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << "got read response beat of trans " << *fsm_hndl->trans;
         auto ext = fsm_hndl->trans->get_extension<axi::axi4_extension>();
         this->r_data.write(get_read_data_for_beat(fsm_hndl));
         this->r_resp.write(axi::to_int(ext->get_resp()));
@@ -315,7 +316,7 @@ template <typename CFG> inline void axi::pin::axi4_target<CFG>::rresp_t() {
                 react(evt, active_resp_beat[tlm::TLM_READ_COMMAND]);
             }
         } while(!this->r_ready.read());
-        SCCTRACE(SCMOD) << "finished read response beat of trans [" << fsm_hndl->trans << "]";
+        SCCTRACE(log_hndl) << "finished read response beat of trans [" << fsm_hndl->trans << "]";
         wait(clk_i.posedge_event());
         this->r_valid.write(false);
         if(!CFG::IS_LITE)
@@ -330,7 +331,7 @@ template <typename CFG> inline void axi::pin::axi4_target<CFG>::aw_t() {
     while(true) {
         wait(this->aw_valid.posedge_event() | clk_delayed);
         if(this->aw_valid.event() || (!active_req_beat[tlm::TLM_IGNORE_COMMAND] && this->aw_valid.read())) {
-            SCCTRACE(SCMOD) << "AWVALID detected for 0x" << std::hex << this->aw_addr.read();
+            SCCTRACE(log_hndl) << "AWVALID detected for 0x" << std::hex << this->aw_addr.read();
             // clang-format off
             aw_data awd = {CFG::IS_LITE ? 0U : this->aw_id->read().to_uint(),
                     this->aw_addr.read().to_uint64(),
@@ -385,7 +386,7 @@ template <typename CFG> inline void axi::pin::axi4_target<CFG>::wdata_t() {
                 active_req[tlm::TLM_WRITE_COMMAND] = active_req_beat[tlm::TLM_WRITE_COMMAND];
             }
             auto* fsm_hndl = active_req[tlm::TLM_WRITE_COMMAND];
-            SCCTRACE(SCMOD) << "WDATA detected for 0x" << std::hex << this->ar_addr.read();
+            SCCTRACE(log_hndl) << "WDATA detected for 0x" << std::hex << this->ar_addr.read();
             auto& gp = fsm_hndl->trans;
             auto data = this->w_data.read();
             auto strb = this->w_strb.read();
@@ -456,20 +457,20 @@ template <typename CFG> inline void axi::pin::axi4_target<CFG>::bresp_t() {
     uint8_t val;
     while(true) {
         std::tie(val, fsm_hndl) = wresp_vl.get();
-        SCCTRACE(SCMOD) << "got write response of trans " << *fsm_hndl->trans;
+        SCCTRACE(log_hndl) << "got write response of trans " << *fsm_hndl->trans;
         auto ext = fsm_hndl->trans->get_extension<axi::axi4_extension>();
         this->b_resp.write(axi::to_int(ext->get_resp()));
         this->b_valid.write(true);
         if(!CFG::IS_LITE)
             this->b_id->write(ext->get_id());
-        SCCTRACE(SCMOD) << "got write response";
+        SCCTRACE(log_hndl) << "got write response";
         do {
             wait(this->b_ready.posedge_event() | clk_delayed);
             if(this->b_ready.read()) {
                 react(axi::fsm::protocol_time_point_e::EndRespE, active_resp_beat[tlm::TLM_WRITE_COMMAND]);
             }
         } while(!this->b_ready.read());
-        SCCTRACE(SCMOD) << "finished write response of trans [" << fsm_hndl->trans << "]";
+        SCCTRACE(log_hndl) << "finished write response of trans [" << fsm_hndl->trans << "]";
         wait(clk_i.posedge_event());
         this->b_valid.write(false);
     }
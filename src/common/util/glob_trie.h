@@ -0,0 +1,316 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_GLOB_TRIE_H_
+#define _UTIL_GLOB_TRIE_H_
+
+#include "ities.h"
+#include <algorithm>
+#include <deque>
+#include <regex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief matches a single hierarchy segment against a glob pattern
+ *
+ * The pattern supports ?, * and character classes ([a-z] as well as [!a-z]), a backslash quotes the next character.
+ *
+ * @param pat the pattern
+ * @param pat_end end of the pattern
+ * @param str the string to match
+ * @param str_end end of the string
+ * @return true if the string matches the pattern
+ */
+inline bool glob_match_segment(char const* pat, char const* pat_end, char const* str, char const* str_end) {
+    char const* star_pat = nullptr;
+    char const* star_str = nullptr;
+    while(str != str_end) {
+        if(pat != pat_end) {
+            switch(*pat) {
+            case '*':
+                star_pat = ++pat;
+                star_str = str;
+                continue;
+            case '?':
+                ++pat;
+                ++str;
+                continue;
+            case '[': {
+                auto const* p = pat + 1;
+                bool negate = p != pat_end && *p == '!';
+                if(negate)
+                    ++p;
+                bool found = false;
+                bool first = true;
+                while(p != pat_end && (*p != ']' || first)) {
+                    first = false;
+                    if(*p == '\\' && p + 1 != pat_end)
+                        ++p;
+                    if(p + 2 < pat_end && *(p + 1) == '-' && *(p + 2) != ']') {
+                        found |= *str >= *p && *str <= *(p + 2);
+                        p += 3;
+                    } else
+                        found |= *str == *p++;
+                }
+                if(p != pat_end && found != negate) {
+                    pat = p + 1;
+                    ++str;
+                    continue;
+                }
+                break;
+            }
+            case '\\':
+                if(pat + 1 != pat_end && *(pat + 1) == *str) {
+                    pat += 2;
+                    ++str;
+                    continue;
+                }
+                break;
+            default:
+                if(*pat == *str) {
+                    ++pat;
+                    ++str;
+                    continue;
+                }
+                break;
+            }
+        }
+        if(!star_pat)
+            return false;
+        pat = star_pat;
+        str = ++star_str;
+    }
+    while(pat != pat_end && *pat == '*')
+        ++pat;
+    return pat == pat_end;
+}
+/**
+ * @brief a trie of hierarchical glob patterns
+ *
+ * Patterns are split at the hierarchy delimiter and stored segment by segment. Plain segments are looked up by hash,
+ * segments containing wildcards are matched by glob_match_segment() and a segment consisting only of '**' matches one
+ * or more hierarchy levels. This way matching a name costs time proportional to the number of its segments instead of
+ * the number of patterns. The semantic is the same as the one of glob_to_regex(). Patterns which cannot be split into
+ * segments (e.g. 'a**b') as well as regular expressions (starting with a caret '^') are kept as std::regex and checked
+ * in addition.
+ *
+ * Each pattern carries a value and its insertion index so that the user can resolve ambiguities (first or last match
+ * wins).
+ *
+ * @tparam T the value type associated with a pattern
+ */
+template <typename T> class glob_trie {
+public:
+#ifdef MTI_SYSTEMC
+    static constexpr char default_delimiter = '/';
+#else
+    static constexpr char default_delimiter = '.';
+#endif
+    struct node {
+        std::unordered_map<std::string, node*> literal;
+        std::vector<std::pair<std::string, node*>> wildcard;
+        node* many{nullptr};
+        bool is_many{false};
+        std::vector<std::pair<size_t, T>> values;
+    };
+    //! the set of trie nodes being active after consuming a number of segments
+    using state = std::vector<node const*>;
+    /**
+     * @brief constructor
+     *
+     * @param delimiter the hierarchy delimiter
+     */
+    glob_trie(char delimiter = default_delimiter)
+    : delim(delimiter) {}
+
+    glob_trie(glob_trie const&) = delete;
+
+    glob_trie& operator=(glob_trie const&) = delete;
+    /**
+     * @brief adds a pattern
+     *
+     * @param pattern the glob pattern or a regular expression starting with '^'
+     * @param value the value associated with the pattern
+     * @return the insertion index of the pattern
+     * @exception std::regex_error if the pattern is an invalid regular expression
+     */
+    size_t insert(std::string const& pattern, T const& value) {
+        auto idx = count++;
+        if(pattern.size() && pattern[0] == '^') {
+            fallback.emplace_back(std::regex(pattern), idx, value);
+            return idx;
+        }
+        auto segments = split(pattern);
+        for(auto const& seg : segments)
+            if(seg.find("**") != std::string::npos && seg != "**") {
+                fallback.emplace_back(std::regex(glob_to_regex(pattern)), idx, value);
+                return idx;
+            }
+        node* n = &root;
+        for(auto const& seg : segments) {
+            if(seg == "**") {
+                if(!n->many) {
+                    n->many = new_node();
+                    n->many->is_many = true;
+                }
+                n = n->many;
+            } else if(seg.find_first_of("*?[\\") != std::string::npos) {
+                auto it = std::find_if(n->wildcard.begin(), n->wildcard.end(),
+                                       [&seg](std::pair<std::string, node*> const& e) { return e.first == seg; });
+                if(it == n->wildcard.end()) {
+                    n->wildcard.emplace_back(seg, new_node());
+                    n = n->wildcard.back().second;
+                } else
+                    n = it->second;
+            } else {
+                auto& child = n->literal[seg];
+                if(!child)
+                    child = new_node();
+                n = child;
+            }
+        }
+        n->values.emplace_back(idx, value);
+        return idx;
+    }
+    //! the number of patterns being added
+    size_t size() const { return count; }
+    //! true if no pattern has been added
+    bool empty() const { return count == 0; }
+    //! returns the state before consuming any segment
+    state initial() const { return state{&root}; }
+    /**
+     * @brief advances the state by consuming one hierarchy segment
+     *
+     * @param cur the current state
+     * @param seg the segment (without delimiter)
+     * @return the next state, empty if no pattern can match anymore
+     */
+    state step(state const& cur, std::string const& seg) const {
+        state next;
+        auto add = [&next](node const* n) {
+            if(std::find(next.begin(), next.end(), n) == next.end())
+                next.push_back(n);
+        };
+        for(auto const* n : cur) {
+            if(n->is_many)
+                add(n);
+            auto it = n->literal.find(seg);
+            if(it != n->literal.end())
+                add(it->second);
+            for(auto const& w : n->wildcard)
+                if(glob_match_segment(w.first.data(), w.first.data() + w.first.size(), seg.data(), seg.data() + seg.size()))
+                    add(w.second);
+            if(n->many)
+                add(n->many);
+        }
+        return next;
+    }
+    /**
+     * @brief calls the functor for all patterns matching in the given state
+     *
+     * @param cur the state after consuming all segments of name
+     * @param name the full name, used to check the patterns not being part of the trie
+     * @param f the functor being called as f(size_t index, T const& value)
+     */
+    template <typename F> void accept(state const& cur, std::string const& name, F&& f) const {
+        for(auto const* n : cur)
+            for(auto const& v : n->values)
+                f(v.first, v.second);
+        for(auto const& e : fallback)
+            if(std::regex_match(name, std::get<0>(e)))
+                f(std::get<1>(e), std::get<2>(e));
+    }
+    /**
+     * @brief calls the functor for all patterns matching the given name
+     *
+     * @param name the hierarchical name
+     * @param f the functor being called as f(size_t index, T const& value)
+     */
+    template <typename F> void match(std::string const& name, F&& f) const {
+        auto cur = initial();
+        size_t start = 0;
+        while(cur.size()) {
+            auto pos = name.find(delim, start);
+            cur = step(cur, name.substr(start, pos == std::string::npos ? std::string::npos : pos - start));
+            if(pos == std::string::npos)
+                break;
+            start = pos + 1;
+        }
+        accept(cur, name, std::forward<F>(f));
+    }
+    /**
+     * @brief finds the value of the first (or last) added pattern matching the name
+     *
+     * @param name the hierarchical name
+     * @param last if true the last added matching pattern is returned
+     * @return pointer to the value or nullptr if no pattern matches
+     */
+    T const* find(std::string const& name, bool last = false) const {
+        T const* res = nullptr;
+        size_t res_idx = 0;
+        match(name, [&res, &res_idx, last](size_t idx, T const& val) {
+            if(!res || (last ? idx > res_idx : idx < res_idx)) {
+                res = &val;
+                res_idx = idx;
+            }
+        });
+        return res;
+    }
+
+private:
+    node* new_node() {
+        nodes.emplace_back();
+        return &nodes.back();
+    }
+
+    std::vector<std::string> split(std::string const& pattern) const {
+        std::vector<std::string> res;
+        std::string seg;
+        for(size_t i = 0; i < pattern.size(); ++i) {
+            auto c = pattern[i];
+            if(c == '\\' && i + 1 < pattern.size()) {
+                seg += c;
+                seg += pattern[++i];
+            } else if(c == delim) {
+                res.push_back(std::move(seg));
+                seg.clear();
+            } else
+                seg += c;
+        }
+        res.push_back(std::move(seg));
+        return res;
+    }
+
+    char const delim;
+    size_t count{0};
+    node root;
+    std::deque<node> nodes;
+    std::vector<std::tuple<std::regex, size_t, T>> fallback;
+};
+template <typename T> constexpr char glob_trie<T>::default_delimiter;
+} // namespace util
+/** @} */
+#endif /* _UTIL_GLOB_TRIE_H_ */
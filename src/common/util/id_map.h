@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_ID_MAP_H_
+#define _UTIL_ID_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief a hash map from non-zero 64bit ids (e.g. addresses of objects) to values
+ *
+ * The map uses open addressing with linear probing in a single array, erased entries are closed by shifting the
+ * following entries back. Hence inserting and erasing does not allocate memory unless the map needs to grow, a map
+ * holding a bounded number of entries (like the transactions in flight) stops allocating after warm-up.
+ *
+ * @tparam VALUE the value type, needs to be default constructible and move assignable
+ */
+template <typename VALUE> class id_map {
+public:
+    /**
+     * @brief constructor
+     *
+     * @param capacity the initial number of slots, it is rounded up to the next power of 2
+     */
+    explicit id_map(size_t capacity = 64) { entries.resize(round_up(capacity)); }
+    /**
+     * @brief looks up an id
+     *
+     * @param id the id, must not be 0
+     * @return a pointer to the value or nullptr if the id is not in the map
+     */
+    VALUE* find(uint64_t id) {
+        for(auto idx = slot(id);; idx = next(idx)) {
+            auto& e = entries[idx];
+            if(e.id == id)
+                return &e.value;
+            if(e.id == 0)
+                return nullptr;
+        }
+    }
+    /**
+     * @brief looks up an id and inserts a default constructed value if it is not in the map
+     *
+     * @param id the id, must not be 0
+     * @return the value
+     */
+    VALUE& operator[](uint64_t id) {
+        if(2 * (count + 1) > entries.size())
+            grow();
+        for(auto idx = slot(id);; idx = next(idx)) {
+            auto& e = entries[idx];
+            if(e.id == id)
+                return e.value;
+            if(e.id == 0) {
+                e.id = id;
+                ++count;
+                return e.value;
+            }
+        }
+    }
+    /**
+     * @brief removes an id, the value is reset to a default constructed one
+     *
+     * @param id the id, must not be 0
+     * @return true if the id was in the map
+     */
+    bool erase(uint64_t id) {
+        auto idx = slot(id);
+        for(; entries[idx].id != id; idx = next(idx))
+            if(entries[idx].id == 0)
+                return false;
+        // move back entries of the probe sequence so that no lookup runs into the hole
+        for(auto n = next(idx); entries[n].id != 0; n = next(n)) {
+            auto home = slot(entries[n].id);
+            if(((n - home) & mask()) >= ((n - idx) & mask())) {
+                entries[idx] = std::move(entries[n]);
+                idx = n;
+            }
+        }
+        entries[idx] = entry{};
+        --count;
+        return true;
+    }
+    //! removes all entries keeping the capacity
+    void clear() {
+        for(auto& e : entries)
+            e = entry{};
+        count = 0;
+    }
+    //! the number of entries
+    size_t size() const { return count; }
+    //! true if the map has no entries
+    bool empty() const { return count == 0; }
+
+private:
+    struct entry {
+        uint64_t id{0};
+        VALUE value{};
+    };
+
+    static size_t round_up(size_t v) {
+        size_t res = 16;
+        while(res < v)
+            res <<= 1;
+        return res;
+    }
+
+    size_t mask() const { return entries.size() - 1; }
+
+    size_t next(size_t idx) const { return (idx + 1) & mask(); }
+
+    size_t slot(uint64_t id) const {
+        // Fibonacci hashing spreads aligned addresses whose low bits are always zero
+        return static_cast<size_t>((id * 0x9e3779b97f4a7c15ULL) >> 32) & mask();
+    }
+
+    void grow() {
+        std::vector<entry> old(entries.size() * 2);
+        std::swap(old, entries);
+        for(auto& e : old)
+            if(e.id) {
+                auto idx = slot(e.id);
+                while(entries[idx].id)
+                    idx = next(idx);
+                entries[idx] = std::move(e);
+            }
+    }
+
+    std::vector<entry> entries;
+    size_t count{0};
+};
+} // namespace util
+/** @} */
+#endif /* _UTIL_ID_MAP_H_ */
@@ -0,0 +1,395 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "iwf.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <lz4.h>
+#include <stdexcept>
+
+namespace util {
+namespace iwf {
+namespace {
+char const file_magic[8] = {'S', 'C', 'C', '-', 'I', 'W', 'F', '1'};
+char const block_magic[4] = {'I', 'W', 'F', 'B'};
+char const index_magic[4] = {'I', 'W', 'F', 'I'};
+size_t const block_header_size = 32;
+uint32_t const no_alias = UINT32_MAX;
+
+template <typename T> inline void put(std::vector<char>& buf, T const& v) {
+    auto const* p = reinterpret_cast<char const*>(&v);
+    buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+template <typename T> inline void put(std::ofstream& out, T const& v) { out.write(reinterpret_cast<char const*>(&v), sizeof(T)); }
+
+template <typename T> inline T get(std::ifstream& in) {
+    T v{};
+    if(!in.read(reinterpret_cast<char*>(&v), sizeof(T)))
+        throw std::runtime_error("Unexpected end of IWF file");
+    return v;
+}
+
+template <typename T> inline T get(char const* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+} // namespace
+
+writer::writer(std::string const& filename, uint64_t time_unit_fs, size_t block_size)
+: out(filename, std::ios::binary | std::ios::trunc)
+, block_size(block_size) {
+    if(!out.is_open())
+        throw std::runtime_error("Could not open " + filename + " for writing");
+    out.write(file_magic, sizeof(file_magic));
+    put(out, uint64_t(0));
+    put(out, time_unit_fs);
+}
+
+writer::~writer() {
+    // a destructor must not throw, a failing close leaves a file without index which the reader rejects
+    try {
+        close();
+    } catch(std::exception& e) {
+        std::cerr << "Could not close IWF file: " << e.what() << "\n";
+    }
+}
+
+uint32_t writer::add_signal(std::string const& name, value_kind kind, unsigned bits) {
+    auto id = static_cast<uint32_t>(signals.size());
+    signals.push_back({name, kind, bits, id});
+    pending.emplace_back();
+    signal_blocks.emplace_back();
+    return id;
+}
+
+uint32_t writer::add_alias(std::string const& name, uint32_t id) {
+    auto const& s = signals.at(id);
+    auto alias = static_cast<uint32_t>(signals.size());
+    signals.push_back({name, s.kind, s.bits, s.alias_of});
+    pending.emplace_back();
+    signal_blocks.emplace_back();
+    return alias;
+}
+
+size_t writer::value_size(signal_info const& s) {
+    switch(s.kind) {
+    case value_kind::INT:
+        return sizeof(uint64_t);
+    case value_kind::REAL:
+        return sizeof(double);
+    default:
+        return s.bits;
+    }
+}
+
+void writer::append(uint32_t id, uint64_t time, void const* value, size_t size) {
+    if(!out.is_open())
+        return;
+    id = signals[id].alias_of;
+    auto& buf = pending[id];
+    if(buf.empty())
+        dirty.push_back(id);
+    put(buf, time);
+    auto const* p = static_cast<char const*>(value);
+    buf.insert(buf.end(), p, p + size);
+    pending_size += sizeof(time) + size;
+    if(block_empty) {
+        block_start = time;
+        block_empty = false;
+    }
+    block_end = time;
+    if(pending_size >= block_size)
+        flush();
+}
+
+void writer::flush() {
+    if(block_empty || !out.is_open())
+        return;
+    std::sort(std::begin(dirty), std::end(dirty));
+    raw_buf.clear();
+    put(raw_buf, static_cast<uint32_t>(dirty.size()));
+    auto offset = static_cast<uint32_t>(sizeof(uint32_t) + dirty.size() * 3 * sizeof(uint32_t));
+    for(auto id : dirty) {
+        auto const& buf = pending[id];
+        put(raw_buf, id);
+        put(raw_buf, static_cast<uint32_t>(buf.size() / (sizeof(uint64_t) + value_size(signals[id]))));
+        put(raw_buf, offset);
+        offset += static_cast<uint32_t>(buf.size());
+    }
+    auto const block_idx = static_cast<uint32_t>(blocks.size());
+    for(auto id : dirty) {
+        auto& buf = pending[id];
+        raw_buf.insert(raw_buf.end(), buf.begin(), buf.end());
+        buf.clear();
+        signal_blocks[id].push_back(block_idx);
+    }
+    comp_buf.resize(LZ4_compressBound(static_cast<int>(raw_buf.size())));
+    auto comp_size = LZ4_compress_default(raw_buf.data(), comp_buf.data(), static_cast<int>(raw_buf.size()),
+                                          static_cast<int>(comp_buf.size()));
+    if(comp_size <= 0)
+        throw std::runtime_error("LZ4 compression of IWF block failed");
+    block_info blk{static_cast<uint64_t>(out.tellp()), block_start, block_end, static_cast<uint32_t>(comp_size),
+                   static_cast<uint32_t>(raw_buf.size())};
+    out.write(block_magic, sizeof(block_magic));
+    put(out, blk.compressed_size);
+    put(out, blk.raw_size);
+    put(out, uint32_t(0));
+    put(out, blk.start_time);
+    put(out, blk.end_time);
+    out.write(comp_buf.data(), comp_size);
+    if(!out.good())
+        throw std::runtime_error("Could not write IWF block");
+    blocks.push_back(blk);
+    dirty.clear();
+    pending_size = 0;
+    block_empty = true;
+}
+
+void writer::close() {
+    if(!out.is_open())
+        return;
+    try {
+        write_index();
+    } catch(...) {
+        // the file cannot be completed anymore, a later call (e.g. from the destructor) must not try again
+        out.close();
+        throw;
+    }
+    out.close();
+    if(out.fail())
+        throw std::runtime_error("Could not write the index of the IWF file");
+}
+
+void writer::write_index() {
+    flush();
+    uint64_t index_offset = out.tellp();
+    out.write(index_magic, sizeof(index_magic));
+    put(out, static_cast<uint32_t>(signals.size()));
+    for(uint32_t id = 0; id < signals.size(); ++id) {
+        auto const& s = signals[id];
+        put(out, static_cast<uint8_t>(s.kind));
+        put(out, static_cast<uint32_t>(s.bits));
+        put(out, s.alias_of == id ? no_alias : s.alias_of);
+        put(out, static_cast<uint32_t>(s.name.size()));
+        out.write(s.name.data(), s.name.size());
+        put(out, static_cast<uint32_t>(signal_blocks[id].size()));
+        for(auto b : signal_blocks[id])
+            put(out, b);
+    }
+    put(out, static_cast<uint32_t>(blocks.size()));
+    for(auto const& b : blocks) {
+        put(out, b.offset);
+        put(out, b.start_time);
+        put(out, b.end_time);
+        put(out, b.compressed_size);
+        put(out, b.raw_size);
+    }
+    // the index offset is only written if the index is complete, a reader rejects the file otherwise
+    if(!out.good())
+        return;
+    out.seekp(sizeof(file_magic));
+    put(out, index_offset);
+}
+
+reader::reader(std::string const& filename)
+: in(filename, std::ios::binary) {
+    if(!in.is_open())
+        throw std::runtime_error("Could not open " + filename);
+    in.seekg(0, std::ios::end);
+    auto const file_size = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+    char magic[8];
+    if(!in.read(magic, sizeof(magic)) || std::memcmp(magic, file_magic, sizeof(magic)))
+        throw std::runtime_error(filename + " is not an IWF file");
+    auto index_offset = get<uint64_t>(in);
+    time_unit = get<uint64_t>(in);
+    if(!index_offset)
+        throw std::runtime_error(filename + " has not been closed properly, no index found");
+    if(index_offset >= file_size)
+        throw std::runtime_error(filename + " has a corrupt index");
+    // all counts are checked against the size of the index before allocating memory for them
+    auto const index_size = file_size - index_offset;
+    auto check_count = [&filename, index_size](uint64_t count, uint64_t elem_size) {
+        if(count * elem_size > index_size)
+            throw std::runtime_error(filename + " has a corrupt index");
+    };
+    in.seekg(index_offset);
+    if(!in.read(magic, sizeof(index_magic)) || std::memcmp(magic, index_magic, sizeof(index_magic)))
+        throw std::runtime_error(filename + " has a corrupt index");
+    auto nsignals = get<uint32_t>(in);
+    check_count(nsignals, sizeof(uint8_t) + 4 * sizeof(uint32_t));
+    signals.resize(nsignals);
+    signal_blocks.resize(nsignals);
+    for(uint32_t id = 0; id < nsignals; ++id) {
+        auto& s = signals[id];
+        s.kind = static_cast<value_kind>(get<uint8_t>(in));
+        s.bits = get<uint32_t>(in);
+        auto alias = get<uint32_t>(in);
+        if(alias != no_alias && alias >= nsignals)
+            throw std::runtime_error(filename + " has a corrupt index");
+        s.alias_of = alias == no_alias ? id : alias;
+        auto name_len = get<uint32_t>(in);
+        check_count(name_len, 1);
+        s.name.resize(name_len);
+        if(!in.read(&s.name[0], s.name.size()))
+            throw std::runtime_error(filename + " has a corrupt index");
+        auto& sb = signal_blocks[id];
+        auto nblocks = get<uint32_t>(in);
+        check_count(nblocks, sizeof(uint32_t));
+        sb.resize(nblocks);
+        for(auto& b : sb)
+            b = get<uint32_t>(in);
+        name_lut[s.name] = id;
+    }
+    auto nblocks = get<uint32_t>(in);
+    check_count(nblocks, 3 * sizeof(uint64_t) + 2 * sizeof(uint32_t));
+    blocks.resize(nblocks);
+    for(auto& b : blocks) {
+        b.offset = get<uint64_t>(in);
+        b.start_time = get<uint64_t>(in);
+        b.end_time = get<uint64_t>(in);
+        b.compressed_size = get<uint32_t>(in);
+        b.raw_size = get<uint32_t>(in);
+        // LZ4 cannot expand data by more than a factor of 255
+        if(b.offset > index_offset || b.compressed_size > index_offset - b.offset ||
+           block_header_size > index_offset - b.offset - b.compressed_size || b.raw_size > 255ULL * b.compressed_size)
+            throw std::runtime_error(filename + " has a corrupt index");
+    }
+    for(auto const& sb : signal_blocks)
+        for(auto b : sb)
+            if(b >= blocks.size())
+                throw std::runtime_error(filename + " has a corrupt index");
+}
+
+bool reader::find_signal(std::string const& name, uint32_t& id) const {
+    auto it = name_lut.find(name);
+    if(it == name_lut.end())
+        return false;
+    id = it->second;
+    return true;
+}
+
+std::vector<char> const& reader::load_block(uint32_t idx) {
+    if(cached_idx == idx)
+        return cached_block;
+    auto const& b = blocks.at(idx);
+    comp_buf.resize(b.compressed_size);
+    cached_block.resize(b.raw_size);
+    in.clear();
+    in.seekg(b.offset + block_header_size);
+    if(!in.read(comp_buf.data(), b.compressed_size))
+        throw std::runtime_error("Unexpected end of IWF file");
+    auto sz = LZ4_decompress_safe(comp_buf.data(), cached_block.data(), static_cast<int>(b.compressed_size),
+                                  static_cast<int>(b.raw_size));
+    if(sz < 0 || static_cast<uint32_t>(sz) != b.raw_size)
+        throw std::runtime_error("LZ4 decompression of IWF block failed");
+    cached_idx = idx;
+    return cached_block;
+}
+
+bool reader::locate(uint32_t id, uint32_t blk, size_t rec_size, block_entry& e) {
+    auto const& raw = load_block(blk);
+    if(raw.size() < sizeof(uint32_t))
+        throw std::runtime_error("Corrupt IWF block");
+    auto n = get<uint32_t>(raw.data());
+    if(n > (raw.size() - sizeof(uint32_t)) / (3 * sizeof(uint32_t)))
+        throw std::runtime_error("Corrupt IWF block");
+    uint32_t lo = 0, hi = n;
+    while(lo < hi) {
+        auto mid = (lo + hi) / 2;
+        auto const* p = raw.data() + sizeof(uint32_t) + mid * 3 * sizeof(uint32_t);
+        auto mid_id = get<uint32_t>(p);
+        if(mid_id == id) {
+            e.count = get<uint32_t>(p + sizeof(uint32_t));
+            e.offset = get<uint32_t>(p + 2 * sizeof(uint32_t));
+            if(e.offset > raw.size() || e.count > (raw.size() - e.offset) / rec_size)
+                throw std::runtime_error("Corrupt IWF block");
+            return true;
+        }
+        if(mid_id < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return false;
+}
+
+void reader::decode(signal_info const& s, char const* rec, value_change& res) const {
+    res.time = get<uint64_t>(rec);
+    rec += sizeof(uint64_t);
+    switch(s.kind) {
+    case value_kind::INT:
+        res.value = get<uint64_t>(rec);
+        break;
+    case value_kind::REAL:
+        res.real = get<double>(rec);
+        break;
+    default:
+        res.bits.assign(rec, s.bits);
+        break;
+    }
+}
+
+bool reader::value_at(uint32_t id, uint64_t time, value_change& res) {
+    auto const& s = signals.at(signals.at(id).alias_of);
+    auto const& sb = signal_blocks[s.alias_of];
+    auto it = std::upper_bound(std::begin(sb), std::end(sb), time,
+                               [this](uint64_t t, uint32_t b) { return t < blocks[b].start_time; });
+    if(it == std::begin(sb))
+        return false;
+    auto const rec_size = sizeof(uint64_t) + (s.kind == value_kind::BITS ? s.bits : sizeof(uint64_t));
+    for(auto k = std::distance(std::begin(sb), it) - 1; k >= 0; --k) {
+        block_entry e;
+        if(!locate(s.alias_of, sb[k], rec_size, e) || !e.count)
+            continue;
+        auto const* base = cached_block.data() + e.offset;
+        // find the first record later than time
+        uint32_t lo = 0, hi = e.count;
+        while(lo < hi) {
+            auto mid = (lo + hi) / 2;
+            if(get<uint64_t>(base + mid * rec_size) <= time)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if(lo) {
+            decode(s, base + (lo - 1) * rec_size, res);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<value_change> reader::changes(uint32_t id, uint64_t from, uint64_t to) {
+    std::vector<value_change> res;
+    auto const& s = signals.at(signals.at(id).alias_of);
+    auto const rec_size = sizeof(uint64_t) + (s.kind == value_kind::BITS ? s.bits : sizeof(uint64_t));
+    for(auto b : signal_blocks[s.alias_of]) {
+        auto const& blk = blocks[b];
+        if(blk.end_time < from)
+            continue;
+        if(blk.start_time > to)
+            break;
+        block_entry e;
+        if(!locate(s.alias_of, b, rec_size, e))
+            continue;
+        auto const* base = cached_block.data() + e.offset;
+        for(uint32_t i = 0; i < e.count; ++i) {
+            auto t = get<uint64_t>(base + i * rec_size);
+            if(t < from)
+                continue;
+            if(t > to)
+                break;
+            res.emplace_back();
+            decode(s, base + i * rec_size, res.back());
+        }
+    }
+    return res;
+}
+} // namespace iwf
+} // namespace util
@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_IWF_H_
+#define _UTIL_IWF_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief the indexed waveform format (IWF)
+ *
+ * A compact binary waveform format allowing to query the value of a signal at an arbitrary time without scanning
+ * the whole file. The file is laid out as follows (all numbers in host byte order):
+ *
+ *   - header: magic "SCC-IWF1", uint64 offset of the index (0 if the file has not been closed properly), uint64 time
+ *     unit in femto seconds
+ *   - blocks: each block holds all value changes of a time range, it starts with a 32 byte block header (magic
+ *     "IWFB", uint32 compressed size, uint32 raw size, uint32 reserved, uint64 start time, uint64 end time) followed
+ *     by the LZ4 compressed payload. The payload consists of a table of (uint32 signal id, uint32 change count,
+ *     uint32 offset) entries sorted by signal id followed by the change records of each signal. A change record is a
+ *     uint64 time stamp followed by the fixed size value (uint64 for integers, double for reals and one char per bit
+ *     for 4-state values)
+ *   - index: magic "IWFI", the signal table (kind, bit width, alias target, name and the list of blocks containing
+ *     changes of the signal) and the block table (file offset, start and end time, compressed and raw size)
+ *
+ * So a value lookup is a binary search in the block list of a signal followed by decompressing a single block.
+ */
+namespace iwf {
+//! the representation of the values of a signal
+enum class value_kind : uint8_t {
+    INT,  //!< 2-state value with up to 64 bits stored as uint64_t
+    REAL, //!< floating point value stored as double
+    BITS  //!< 4-state or wider value stored as one char ('0', '1', 'x', 'z') per bit, MSB first
+};
+//! the descriptor of a signal
+struct signal_info {
+    std::string name;
+    value_kind kind;
+    unsigned bits;
+    //! the id of the signal holding the values if this one is an alias, the own id otherwise
+    uint32_t alias_of;
+};
+//! the descriptor of a block
+struct block_info {
+    uint64_t offset;
+    uint64_t start_time;
+    uint64_t end_time;
+    uint32_t compressed_size;
+    uint32_t raw_size;
+};
+//! a single value change as returned by the reader
+struct value_change {
+    uint64_t time{0};
+    //! the value if the signal is of kind value_kind::INT
+    uint64_t value{0};
+    //! the value if the signal is of kind value_kind::REAL
+    double real{0.0};
+    //! the value if the signal is of kind value_kind::BITS
+    std::string bits;
+};
+/**
+ * @brief writer of IWF files
+ *
+ * Value changes need to be written with non-decreasing time stamps. They are collected per signal and written as
+ * compressed block once the raw size of a block exceeds the configured block size.
+ */
+class writer {
+public:
+    /**
+     * @brief constructs a writer and opens the file
+     *
+     * @param filename the name of the file to create
+     * @param time_unit_fs the time unit of the time stamps in femto seconds
+     * @param block_size the (uncompressed) size of a block in bytes
+     * @exception std::runtime_error if the file cannot be opened
+     */
+    writer(std::string const& filename, uint64_t time_unit_fs = 1000, size_t block_size = 1 << 20);
+
+    //! closes the file, errors are reported to std::cerr as a destructor must not throw, call close() to get them as exception
+    ~writer();
+
+    writer(const writer&) = delete;
+    writer(writer&&) = delete;
+    writer& operator=(const writer&) = delete;
+    writer& operator=(writer&&) = delete;
+    /**
+     * @brief adds a signal
+     *
+     * @param name the hierarchical name
+     * @param kind the representation of the values
+     * @param bits the width of the signal
+     * @return the id of the signal
+     */
+    uint32_t add_signal(std::string const& name, value_kind kind, unsigned bits);
+    /**
+     * @brief adds a signal sharing the values of another one
+     *
+     * @param name the hierarchical name
+     * @param id the id of the signal holding the values
+     * @return the id of the alias
+     */
+    uint32_t add_alias(std::string const& name, uint32_t id);
+    //! records a value change of a signal of kind value_kind::INT
+    void change(uint32_t id, uint64_t time, uint64_t value) { append(id, time, &value, sizeof(value)); }
+    //! records a value change of a signal of kind value_kind::REAL
+    void change(uint32_t id, uint64_t time, double value) { append(id, time, &value, sizeof(value)); }
+    //! records a value change of a signal of kind value_kind::BITS, bits needs to point to 'width' characters
+    void change(uint32_t id, uint64_t time, char const* bits) { append(id, time, bits, signals[id].bits); }
+    //! writes the pending block, throws std::runtime_error if compressing or writing fails
+    void flush();
+    /**
+     * @brief writes the pending block and the index and closes the file
+     *
+     * @exception std::runtime_error if compressing or writing fails, the file is closed without a valid index then
+     */
+    void close();
+
+private:
+    void append(uint32_t id, uint64_t time, void const* value, size_t size);
+
+    void write_index();
+
+    static size_t value_size(signal_info const& s);
+
+    std::ofstream out;
+    size_t const block_size;
+    std::vector<signal_info> signals;
+    std::vector<std::vector<char>> pending;
+    std::vector<std::vector<uint32_t>> signal_blocks;
+    std::vector<uint32_t> dirty;
+    std::vector<block_info> blocks;
+    std::vector<char> raw_buf, comp_buf;
+    size_t pending_size{0};
+    uint64_t block_start{0}, block_end{0};
+    bool block_empty{true};
+};
+/**
+ * @brief reader of IWF files
+ *
+ * The reader loads the index when opening the file, payload blocks are read on demand. The last decompressed block is
+ * cached so that consecutive queries in the same time range do not need to read the file again.
+ */
+class reader {
+public:
+    /**
+     * @brief opens a file and reads its index
+     *
+     * @param filename the name of the file
+     * @exception std::runtime_error if the file cannot be opened or is not a complete IWF file
+     */
+    explicit reader(std::string const& filename);
+
+    reader(const reader&) = delete;
+    reader(reader&&) = delete;
+    reader& operator=(const reader&) = delete;
+    reader& operator=(reader&&) = delete;
+    //! the time unit of the time stamps in femto seconds
+    uint64_t get_time_unit() const { return time_unit; }
+    //! the signals contained in the file, the index is the id of the signal
+    std::vector<signal_info> const& get_signals() const { return signals; }
+    //! the blocks contained in the file
+    std::vector<block_info> const& get_blocks() const { return blocks; }
+    /**
+     * @brief looks up a signal by its name
+     *
+     * @param name the hierarchical name
+     * @param id the id of the signal if found
+     * @return true if the signal exists
+     */
+    bool find_signal(std::string const& name, uint32_t& id) const;
+    /**
+     * @brief retrieves the value of a signal at a given time
+     *
+     * @param id the id of the signal
+     * @param time the point in time
+     * @param res the last value change at or before time
+     * @return false if the signal did not have a value at this time
+     */
+    bool value_at(uint32_t id, uint64_t time, value_change& res);
+    /**
+     * @brief retrieves all value changes of a signal in a time range
+     *
+     * @param id the id of the signal
+     * @param from the start time (inclusive)
+     * @param to the end time (inclusive)
+     * @return the value changes in time order
+     */
+    std::vector<value_change> changes(uint32_t id, uint64_t from, uint64_t to);
+
+private:
+    struct block_entry {
+        uint32_t count;
+        uint32_t offset;
+    };
+
+    std::vector<char> const& load_block(uint32_t idx);
+
+    bool locate(uint32_t id, uint32_t blk, size_t rec_size, block_entry& e);
+
+    void decode(signal_info const& s, char const* rec, value_change& res) const;
+
+    std::ifstream in;
+    uint64_t time_unit{0};
+    std::vector<signal_info> signals;
+    std::vector<std::vector<uint32_t>> signal_blocks;
+    std::vector<block_info> blocks;
+    std::unordered_map<std::string, uint32_t> name_lut;
+    std::vector<char> comp_buf, cached_block;
+    int64_t cached_idx{-1};
+};
+} // namespace iwf
+} // namespace util
+/** @} */
+#endif /* _UTIL_IWF_H_ */
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <util/mmap_log.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace util;
+
+constexpr size_t mmap_log_writer::default_window_size;
+
+bool mmap_log_writer::open(std::string const& name, size_t size) {
+    close();
+    failed = false;
+    auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    window_size = size < page ? page : (size + page - 1) / page * page;
+    fd = ::open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0)
+        return false;
+    if(!map_window(0)) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool mmap_log_writer::close() {
+    if(fd < 0)
+        return !failed;
+    auto written = size();
+    if(base)
+        munmap(base, window_size);
+    base = cur = end = nullptr;
+    // if truncation fails the file keeps the zero filled tail of the last window
+    auto res = ftruncate(fd, static_cast<off_t>(written));
+    (void)res;
+    ::close(fd);
+    fd = -1;
+    window_offset = 0;
+    return !failed;
+}
+
+void mmap_log_writer::append_slow(void const* data, size_t len) {
+    auto const* src = static_cast<char const*>(data);
+    while(len && base) {
+        auto n = std::min(len, static_cast<size_t>(end - cur));
+        std::memcpy(cur, src, n);
+        cur += n;
+        src += n;
+        len -= n;
+        if(cur == end && !map_window(window_offset + window_size))
+            break;
+    }
+    // the appended data is dropped from now on, remember it so that close() can tell
+    failed |= len > 0;
+}
+
+bool mmap_log_writer::map_window(uint64_t offset) {
+    if(base)
+        munmap(base, window_size);
+    base = cur = end = nullptr;
+    window_offset = offset;
+    // the window is allocated as writing to a sparse page on a full disk raises SIGBUS instead of failing here
+#ifdef __APPLE__
+    if(ftruncate(fd, static_cast<off_t>(offset + window_size)))
+        return false;
+#else
+    auto res = posix_fallocate(fd, static_cast<off_t>(offset), static_cast<off_t>(window_size));
+    if(res == EOPNOTSUPP || res == EINVAL) {
+        if(ftruncate(fd, static_cast<off_t>(offset + window_size)))
+            return false;
+    } else if(res)
+        return false;
+#endif
+    auto* ptr = mmap(nullptr, window_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, static_cast<off_t>(offset));
+    if(ptr == MAP_FAILED)
+        return false;
+    base = cur = static_cast<char*>(ptr);
+    end = base + window_size;
+    return true;
+}
+
+bool mmap_file_reader::open(std::string const& name) {
+    close();
+    fd = ::open(name.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if(fstat(fd, &st) == 0) {
+        if(st.st_size == 0)
+            return true;
+        auto* ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if(ptr != MAP_FAILED) {
+            base = static_cast<char*>(ptr);
+            length = static_cast<size_t>(st.st_size);
+            return true;
+        }
+    }
+    ::close(fd);
+    fd = -1;
+    return false;
+}
+
+void mmap_file_reader::close() {
+    if(base)
+        munmap(base, length);
+    base = nullptr;
+    length = 0;
+    if(fd >= 0)
+        ::close(fd);
+    fd = -1;
+}
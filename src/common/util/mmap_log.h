@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_MMAP_LOG_H_
+#define _UTIL_MMAP_LOG_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief an append-only file written through a memory mapped window
+ *
+ * The file is grown and mapped in windows of a fixed size, appending copies the data into the mapped window so no
+ * system call is needed unless the window is full. Since the mapping is shared the data written so far is in the page
+ * cache and survives a crash of the writing process, the unwritten tail of the last window reads as zeros then. Closing
+ * the log truncates the file to the appended size. The disk space of a window is allocated before it is mapped, if that
+ * fails (e.g. the disk is full) the data appended afterwards is dropped and close() reports it.
+ */
+class mmap_log_writer {
+public:
+    //! the default window size
+    static constexpr size_t default_window_size = 64 * 1024 * 1024;
+
+    mmap_log_writer() = default;
+    /**
+     * @brief constructor opening a file
+     *
+     * @param name the name of the file, an existing file is overwritten
+     * @param window_size the size of the mapped window, it is rounded up to a multiple of the page size
+     */
+    explicit mmap_log_writer(std::string const& name, size_t window_size = default_window_size) { open(name, window_size); }
+
+    mmap_log_writer(mmap_log_writer const&) = delete;
+
+    mmap_log_writer& operator=(mmap_log_writer const&) = delete;
+
+    ~mmap_log_writer() { close(); }
+    /**
+     * @brief opens a file
+     *
+     * @param name the name of the file, an existing file is overwritten
+     * @param window_size the size of the mapped window, it is rounded up to a multiple of the page size
+     * @return true if the file could be created and mapped
+     */
+    bool open(std::string const& name, size_t window_size = default_window_size);
+    //! true if a file is open
+    bool is_open() const { return fd >= 0; }
+    /**
+     * @brief appends data to the log
+     *
+     * @param data the data
+     * @param len the number of bytes
+     */
+    void append(void const* data, size_t len) {
+        if(len <= static_cast<size_t>(end - cur)) {
+            std::memcpy(cur, data, len);
+            cur += len;
+        } else
+            append_slow(data, len);
+    }
+    //! the number of bytes appended so far
+    uint64_t size() const { return window_offset + (cur - base); }
+    /**
+     * @brief unmaps the window and truncates the file to the appended size
+     *
+     * @return false if data has been dropped since a window could not be mapped, the file holds the data appended before
+     */
+    bool close();
+
+private:
+    void append_slow(void const* data, size_t len);
+    bool map_window(uint64_t offset);
+
+    int fd{-1};
+    bool failed{false};
+    char* base{nullptr};
+    char* cur{nullptr};
+    char* end{nullptr};
+    uint64_t window_offset{0};
+    size_t window_size{0};
+};
+/**
+ * @brief a read-only memory mapping of a whole file
+ */
+class mmap_file_reader {
+public:
+    mmap_file_reader() = default;
+    /**
+     * @brief constructor opening a file
+     *
+     * @param name the name of the file
+     */
+    explicit mmap_file_reader(std::string const& name) { open(name); }
+
+    mmap_file_reader(mmap_file_reader const&) = delete;
+
+    mmap_file_reader& operator=(mmap_file_reader const&) = delete;
+
+    ~mmap_file_reader() { close(); }
+    /**
+     * @brief opens and maps a file
+     *
+     * @param name the name of the file
+     * @return true if the file could be opened and mapped
+     */
+    bool open(std::string const& name);
+    //! true if a file is mapped
+    bool is_open() const { return fd >= 0; }
+    //! the mapped content
+    char const* data() const { return base; }
+    //! the size of the file
+    size_t size() const { return length; }
+    //! unmaps and closes the file
+    void close();
+
+private:
+    int fd{-1};
+    char* base{nullptr};
+    size_t length{0};
+};
+} // namespace util
+/** @} */
+#endif /* _UTIL_MMAP_LOG_H_ */
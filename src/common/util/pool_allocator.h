@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <array>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -38,6 +39,23 @@
 /**@{*/
 //! @brief SCC common utilities
 namespace util {
+//! the memory held by pool allocators in bytes
+struct pool_usage {
+    size_t capacity{0};
+    size_t used{0};
+};
+//! the functions adding the usage of the pool allocators of the calling thread
+inline std::vector<std::function<void(pool_usage&)>>& pool_usage_registry() {
+    thread_local std::vector<std::function<void(pool_usage&)>> registry;
+    return registry;
+}
+//! get the memory held by all pool allocators of the calling thread
+inline pool_usage get_pool_usage() {
+    pool_usage res;
+    for(auto& f : pool_usage_registry())
+        f(res);
+    return res;
+}
 //! a generic pool allocator singleton not being MT-safe
 template <size_t ELEM_SIZE, unsigned CHUNK_SIZE = 4096> class pool_allocator {
 public:
@@ -79,7 +97,12 @@ public:
     size_t get_free_entries_count();
 
 private:
-    pool_allocator() = default;
+    pool_allocator() {
+        pool_usage_registry().emplace_back([this](pool_usage& usage) {
+            usage.capacity += get_capacity() * ELEM_SIZE;
+            usage.used += (get_capacity() - get_free_entries_count()) * ELEM_SIZE;
+        });
+    }
     using chunk_type = uint8_t[ELEM_SIZE];
     std::vector<std::array<chunk_type, CHUNK_SIZE>*> chunks{};
     std::deque<void*> free_list{};
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_SLOT_ALLOCATOR_H_
+#define _UTIL_SLOT_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief allocator of the lowest free slot number
+ *
+ * The slots are kept in a bitset, the allocator remembers the lowest word having a free slot so allocation is a
+ * find-first-zero in a single word in the common case.
+ */
+class slot_allocator {
+public:
+    /**
+     * @brief allocates the lowest free slot
+     *
+     * @return the slot number
+     */
+    unsigned allocate() {
+        while(first_free < used.size() && used[first_free] == all_set)
+            ++first_free;
+        if(first_free == used.size())
+            used.push_back(0);
+        auto& word = used[first_free];
+        auto bit = ctz(~word);
+        word |= uint64_t(1) << bit;
+        return static_cast<unsigned>(first_free * 64 + bit);
+    }
+    /**
+     * @brief releases a slot
+     *
+     * @param slot the slot number as returned by allocate()
+     */
+    void release(unsigned slot) {
+        auto idx = slot / 64;
+        if(idx >= used.size())
+            return;
+        used[idx] &= ~(uint64_t(1) << (slot % 64));
+        if(idx < first_free)
+            first_free = idx;
+    }
+
+private:
+    static constexpr uint64_t all_set = std::numeric_limits<uint64_t>::max();
+
+    static inline unsigned ctz(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(v);
+#else
+        unsigned r = 0;
+        while(!(v & 1)) {
+            v >>= 1;
+            ++r;
+        }
+        return r;
+#endif
+    }
+
+    std::vector<uint64_t> used;
+    size_t first_free{0};
+};
+/**
+ * @brief assigns concurrency levels (the row in a waveform viewer) to transactions of streams
+ *
+ * Each stream has its own slot_allocator, a transaction gets the lowest level not occupied by another open transaction
+ * of the same stream at begin and frees it at end.
+ */
+class concurrency_slots {
+public:
+    /**
+     * @brief allocates the concurrency level of a transaction being started
+     *
+     * @param stream_id the id of the stream the transaction belongs to
+     * @param tx_id the id of the transaction
+     * @return the concurrency level
+     */
+    unsigned begin(uint64_t stream_id, uint64_t tx_id) {
+        if(streams.size() <= stream_id)
+            streams.resize(stream_id + 1);
+        auto slot = streams[stream_id].allocate();
+        open_tx[tx_id] = slot;
+        return slot;
+    }
+    /**
+     * @brief frees the concurrency level of a transaction being ended
+     *
+     * @param stream_id the id of the stream the transaction belongs to
+     * @param tx_id the id of the transaction
+     * @return the concurrency level the transaction had, std::numeric_limits<unsigned>::max() if it is not known
+     */
+    unsigned end(uint64_t stream_id, uint64_t tx_id) {
+        auto it = open_tx.find(tx_id);
+        if(it == open_tx.end())
+            return std::numeric_limits<unsigned>::max();
+        auto slot = it->second;
+        open_tx.erase(it);
+        if(stream_id < streams.size())
+            streams[stream_id].release(slot);
+        return slot;
+    }
+
+private:
+    std::vector<slot_allocator> streams;
+    std::unordered_map<uint64_t, unsigned> open_tx;
+};
+} // namespace util
+/** @} */
+#endif /* _UTIL_SLOT_ALLOCATOR_H_ */
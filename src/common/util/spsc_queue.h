@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_SPSC_QUEUE_H_
+#define _UTIL_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief a bounded lock-free single producer single consumer queue
+ *
+ * The queue is a ring buffer of pre-allocated elements, pushing moves the element into its slot so element types
+ * owning memory (like std::string) keep their capacity when being reused. Each side caches the index of the other side
+ * to avoid touching the shared cache line on every operation.
+ *
+ * @tparam T the element type, needs to be default constructible and move assignable
+ */
+template <typename T> class spsc_queue {
+public:
+    /**
+     * @brief constructor
+     *
+     * @param capacity the minimum number of elements the queue can hold, it is rounded up to the next power of 2
+     */
+    explicit spsc_queue(size_t capacity)
+    : buffer(round_up(capacity))
+    , mask(buffer.size() - 1) {}
+
+    spsc_queue(spsc_queue const&) = delete;
+
+    spsc_queue& operator=(spsc_queue const&) = delete;
+    /**
+     * @brief tries to enqueue an element, may only be called by the producer
+     *
+     * @param v the element, it is only moved from if the push succeeds
+     * @return false if the queue is full
+     */
+    bool try_push(T&& v) {
+        auto const h = head.load(std::memory_order_relaxed);
+        if(h - tail_cache == buffer.size()) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            if(h - tail_cache == buffer.size())
+                return false;
+        }
+        buffer[h & mask] = std::move(v);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    /**
+     * @brief enqueues an element yielding the producer thread while the queue is full
+     *
+     * @param v the element
+     */
+    void push(T&& v) {
+        while(!try_push(std::move(v)))
+            std::this_thread::yield();
+    }
+    /**
+     * @brief tries to dequeue an element, may only be called by the consumer
+     *
+     * @param v the element being assigned
+     * @return false if the queue is empty
+     */
+    bool try_pop(T& v) {
+        auto const t = tail.load(std::memory_order_relaxed);
+        if(t == head_cache) {
+            head_cache = head.load(std::memory_order_acquire);
+            if(t == head_cache)
+                return false;
+        }
+        v = std::move(buffer[t & mask]);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    //! true if the queue is empty, the result is only a snapshot if called concurrently
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+    //! the number of elements the queue can hold
+    size_t capacity() const { return buffer.size(); }
+
+private:
+    static size_t round_up(size_t v) {
+        size_t res = 2;
+        while(res < v)
+            res <<= 1;
+        return res;
+    }
+
+    std::vector<T> buffer;
+    size_t const mask;
+    // producer side
+    alignas(64) std::atomic<size_t> head{0};
+    size_t tail_cache{0};
+    // consumer side
+    alignas(64) std::atomic<size_t> tail{0};
+    size_t head_cache{0};
+};
+} // namespace util
+/** @} */
+#endif /* _UTIL_SPSC_QUEUE_H_ */
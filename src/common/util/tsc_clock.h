@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_TSC_CLOCK_H_
+#define _UTIL_TSC_CLOCK_H_
+
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define UTIL_TSC_CLOCK_RDTSC
+#endif
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief a cheap clock to measure short durations
+ *
+ * On x86 the clock reads the time stamp counter, on aarch64 the virtual counter (cntvct_el0), elsewhere it falls back
+ * to std::chrono::steady_clock. The ticks are converted to seconds using a rate which is calibrated once against the
+ * steady clock.
+ */
+struct tsc_clock {
+    //! the current value of the clock in ticks
+    static inline uint64_t now() {
+#if defined(UTIL_TSC_CLOCK_RDTSC)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t res;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(res));
+        return res;
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+    //! the number of ticks per second
+    static double ticks_per_second() {
+        static double const rate = calibrate();
+        return rate;
+    }
+    /**
+     * @brief converts a number of ticks to seconds
+     *
+     * @param ticks the number of ticks
+     * @return the duration in seconds
+     */
+    static double to_seconds(uint64_t ticks) { return static_cast<double>(ticks) / ticks_per_second(); }
+
+private:
+    static double calibrate() {
+#if defined(UTIL_TSC_CLOCK_RDTSC) || defined(__aarch64__)
+        // busy wait for some ms, long enough for a precision well below 1% and short enough to not be noticed
+        using namespace std::chrono;
+        auto start = steady_clock::now();
+        auto start_ticks = now();
+        auto end = start;
+        do
+            end = steady_clock::now();
+        while(end - start < milliseconds(10));
+        auto ticks = now() - start_ticks;
+        return static_cast<double>(ticks) / duration_cast<duration<double>>(end - start).count();
+#else
+        return static_cast<double>(std::chrono::steady_clock::period::den) / std::chrono::steady_clock::period::num;
+#endif
+    }
+};
+} // namespace util
+/** @} */
+#endif /* _UTIL_TSC_CLOCK_H_ */
@@ -98,6 +98,8 @@ public:
 protected:
     //! the real memory structure
     util::sparse_array<uint8_t, SIZE> mem;
+    //! the cached verbosity level of this instance
+    scc::log_verbosity_handle log_hndl{this->name()};
 
 public:
     //!! handle the memory operation independent on interface function used
@@ -154,7 +156,7 @@ int memory<SIZE, BUSWIDTH>::handle_operation(tlm::tlm_generic_payload& trans, sc
         }
     }
     tlm::tlm_command cmd = trans.get_command();
-    SCCTRACE(SCMOD) << (cmd == tlm::TLM_READ_COMMAND ? "read" : "write") << " access to addr 0x" << std::hex << adr;
+    SCCTRACE(log_hndl) << (cmd == tlm::TLM_READ_COMMAND ? "read" : "write") << " access to addr 0x" << std::hex << adr;
     if(cmd == tlm::TLM_READ_COMMAND) {
         delay += clk_i.get_interface() ? clk_i->read() * rd_resp_clk_delay : rd_resp_delay;
         if(mem.is_allocated(adr)) {
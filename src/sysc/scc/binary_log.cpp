@@ -0,0 +1,462 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "binary_log.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fmt/args.h>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sysc/kernel/sc_simcontext.h>
+#include <sysc/kernel/sc_time.h>
+#include <sysc/utils/sc_report.h>
+#include <thread>
+#include <unordered_map>
+#include <util/spsc_queue.h>
+
+namespace scc {
+bool binary_logger::active{false};
+
+namespace {
+/*
+ * the binary log consists of the magic number followed by records. Each record starts with its size (including the
+ * size field) and its kind. Strings are stored as 32bit length followed by the characters.
+ *
+ * RESOLUTION: double time resolution in ps
+ * SITE:       uint32 id, int32 line, int32 verbosity, string file, string format
+ * TYPE:       uint32 id, string name
+ * MESSAGE:    uint32 site id, uint32 type id, uint64 time in resolution ticks, uint64 delta cycle, tagged arguments
+ */
+constexpr char file_magic[8] = {'S', 'C', 'C', '-', 'B', 'L', 'G', '1'};
+
+enum record_kind : uint8_t { RESOLUTION = 1, SITE, TYPE, MESSAGE };
+
+constexpr size_t record_header_size = sizeof(uint32_t) + sizeof(uint8_t);
+
+struct chunk {
+    char data[64];
+};
+
+struct producer {
+    explicit producer(size_t capacity)
+    : queue(capacity) {}
+    util::spsc_queue<chunk> queue;
+    // the record being assembled by the writer thread
+    std::vector<char> pending;
+    size_t expected{0};
+};
+
+struct logger_state {
+    std::mutex mtx;
+    std::vector<std::unique_ptr<producer>> producers;
+    std::ofstream out;
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+    bool started{false};
+    size_t queue_size{binary_logger::default_queue_size};
+    std::atomic<uint32_t> next_site{1};
+    std::atomic<uint32_t> next_type{1};
+    std::atomic<bool> resolution_written{false};
+    // the sites registered in the current file, their ids are reset when the logger is restarted
+    std::vector<log_site*> sites;
+    // incremented at each start to invalidate the per thread type ids
+    std::atomic<uint32_t> session{0};
+    // stops the writer thread at program exit
+    ~logger_state() { stop_writer(); }
+
+    void stop_writer() {
+        if(!writer.joinable())
+            return;
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+        out.close();
+    }
+};
+
+logger_state& get_state() {
+    static logger_state state;
+    return state;
+}
+
+struct type_entry {
+    uint32_t id;
+    std::string name;
+};
+
+struct thread_data {
+    binary_logger::buffer buf;
+    binary_logger::buffer def_buf;
+    producer* prod{nullptr};
+    // the message types are identified by their pointer, the name is checked since temporary strings may reuse it
+    std::unordered_map<char const*, type_entry> types;
+    type_entry* last_type{nullptr};
+    char const* last_type_ptr{nullptr};
+    uint32_t session{0};
+};
+thread_local thread_data tdata;
+
+void append_string(binary_logger::buffer& buf, char const* str) {
+    uint32_t len = str ? std::strlen(str) : 0;
+    buf.append(len);
+    buf.append(str, len);
+}
+
+void begin_record(binary_logger::buffer& buf, record_kind kind) {
+    buf.clear();
+    buf.append<uint32_t>(0);
+    buf.append<uint8_t>(kind);
+}
+
+void push_record(producer& prod, binary_logger::buffer& buf) {
+    uint32_t size = buf.size();
+    std::memcpy(buf.data(), &size, sizeof(size));
+    for(size_t pos = 0; pos < size; pos += sizeof(chunk)) {
+        chunk c;
+        std::memcpy(c.data, buf.data() + pos, std::min(sizeof(chunk), size - pos));
+        prod.queue.push(std::move(c));
+    }
+}
+
+producer& get_producer() {
+    if(!tdata.prod) {
+        auto& state = get_state();
+        std::lock_guard<std::mutex> lock(state.mtx);
+        state.producers.emplace_back(new producer(state.queue_size));
+        tdata.prod = state.producers.back().get();
+    }
+    return *tdata.prod;
+}
+
+uint32_t register_site(log_site& site, producer& prod) {
+    auto& state = get_state();
+    auto& buf = tdata.def_buf;
+    if(!state.resolution_written.exchange(true)) {
+        begin_record(buf, RESOLUTION);
+        buf.append<double>(sc_core::sc_get_time_resolution().to_seconds() * 1e12);
+        push_record(prod, buf);
+    }
+    uint32_t id = state.next_site++;
+    begin_record(buf, SITE);
+    buf.append<uint32_t>(id);
+    buf.append<int32_t>(site.line);
+    buf.append<int32_t>(site.verbosity);
+    append_string(buf, site.file);
+    append_string(buf, site.format);
+    push_record(prod, buf);
+    // if another thread registered the site concurrently its id is used, the record written here is never referenced
+    uint32_t expected = 0;
+    if(!site.id.compare_exchange_strong(expected, id))
+        return expected;
+    std::lock_guard<std::mutex> lock(state.mtx);
+    state.sites.push_back(&site);
+    return id;
+}
+
+uint32_t get_type_id(char const* type, producer& prod) {
+    auto session = get_state().session.load(std::memory_order_relaxed);
+    if(tdata.session != session) {
+        // the types have been written to the file of a previous session
+        tdata.types.clear();
+        tdata.last_type = nullptr;
+        tdata.last_type_ptr = nullptr;
+        tdata.session = session;
+    }
+    // consecutive messages mostly have the same type
+    if(type == tdata.last_type_ptr && tdata.last_type->name == type)
+        return tdata.last_type->id;
+    auto& entry = tdata.types[type];
+    if(!entry.id || entry.name != type) {
+        entry = type_entry{get_state().next_type++, type};
+        auto& buf = tdata.def_buf;
+        begin_record(buf, TYPE);
+        buf.append<uint32_t>(entry.id);
+        append_string(buf, type);
+        push_record(prod, buf);
+    }
+    tdata.last_type_ptr = type;
+    tdata.last_type = &entry;
+    return entry.id;
+}
+// moves the chunks of a producer to the file, returns true if a chunk has been found
+bool drain(producer& prod, std::ostream& out) {
+    chunk c;
+    bool found = false;
+    while(prod.queue.try_pop(c)) {
+        found = true;
+        if(prod.pending.empty()) {
+            uint32_t size;
+            std::memcpy(&size, c.data, sizeof(size));
+            prod.expected = size;
+        }
+        prod.pending.insert(prod.pending.end(), c.data, c.data + std::min(sizeof(chunk), prod.expected - prod.pending.size()));
+        if(prod.pending.size() == prod.expected) {
+            out.write(prod.pending.data(), prod.pending.size());
+            prod.pending.clear();
+        }
+    }
+    return found;
+}
+
+void write_loop() {
+    auto& state = get_state();
+    while(true) {
+        auto stopping = state.stopping.load(std::memory_order_acquire);
+        auto found = false;
+        {
+            std::lock_guard<std::mutex> lock(state.mtx);
+            for(auto& p : state.producers)
+                found |= drain(*p, state.out);
+        }
+        if(!found) {
+            if(stopping)
+                break;
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+    state.out.flush();
+}
+
+class record_reader {
+public:
+    explicit record_reader(std::istream& is)
+    : is(is) {}
+
+    bool next() {
+        uint32_t size;
+        if(!is.read(reinterpret_cast<char*>(&size), sizeof(size)))
+            return false;
+        if(size < record_header_size) {
+            error = true;
+            return false;
+        }
+        data.resize(size - sizeof(size));
+        if(!is.read(data.data(), data.size())) {
+            // a truncated record at the end is the result of an interrupted simulation
+            return false;
+        }
+        pos = 1;
+        return true;
+    }
+
+    record_kind kind() const { return static_cast<record_kind>(data[0]); }
+
+    template <typename T> T get() {
+        T v{};
+        if(pos + sizeof(T) > data.size())
+            error = true;
+        else
+            std::memcpy(&v, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return v;
+    }
+
+    std::string get_string() {
+        auto len = get<uint32_t>();
+        if(error || pos + len > data.size()) {
+            error = true;
+            return {};
+        }
+        std::string res(data.data() + pos, len);
+        pos += len;
+        return res;
+    }
+
+    bool at_end() const { return pos >= data.size(); }
+
+    bool error{false};
+
+private:
+    std::istream& is;
+    std::vector<char> data;
+    size_t pos{0};
+};
+
+struct site_info {
+    int line;
+    int verbosity;
+    std::string file;
+    std::string format;
+};
+
+std::string format_time(uint64_t ticks, double tick_ps) {
+    const std::array<const char*, 6> time_units{"fs", "ps", "ns", "us", "ms", "s "};
+    const std::array<uint64_t, 6> multiplier{
+        1ULL, 1000ULL, 1000ULL * 1000, 1000ULL * 1000 * 1000, 1000ULL * 1000 * 1000 * 1000, 1000ULL * 1000 * 1000 * 1000 * 1000};
+    auto tick_fs = static_cast<uint64_t>(tick_ps * 1000 + 0.5);
+    auto fs_val = ticks * tick_fs;
+    if(!fs_val)
+        return "0 s ";
+    int scale = 0;
+    while(scale < 5 && tick_fs >= multiplier[scale + 1])
+        ++scale;
+    for(int j = multiplier.size() - 1; j > scale; --j)
+        if(fs_val >= multiplier[j])
+            return fmt::format("{}.{:0{}} {}", fs_val / multiplier[j], (fs_val % multiplier[j]) / multiplier[scale], 3 * (j - scale),
+                               time_units[j]);
+    return fmt::format("{} {}", fs_val / multiplier[scale], time_units[scale]);
+}
+
+char severity_char(int verbosity) { return verbosity >= sc_core::SC_FULL ? 'T' : verbosity >= sc_core::SC_HIGH ? 'D' : 'I'; }
+} // namespace
+
+bool binary_logger::start(std::string const& file_name, size_t queue_size) {
+    auto& state = get_state();
+    if(state.started)
+        return active;
+    state.out.open(file_name, std::ios::binary | std::ios::trunc);
+    if(!state.out.is_open())
+        return false;
+    state.out.write(file_magic, sizeof(file_magic));
+    state.queue_size = queue_size;
+    state.started = true;
+    // a restarted logger writes a new file which needs all definitions again
+    state.stopping = false;
+    state.resolution_written = false;
+    for(auto* site : state.sites)
+        site->id = 0;
+    state.sites.clear();
+    for(auto& p : state.producers)
+        p->pending.clear();
+    ++state.session;
+    state.writer = std::thread(write_loop);
+    active = true;
+    return true;
+}
+
+void binary_logger::stop() {
+    active = false;
+    auto& state = get_state();
+    state.stop_writer();
+    state.started = false;
+}
+
+binary_logger::buffer& binary_logger::begin_message(log_site& site, char const* type) {
+    auto& prod = get_producer();
+    auto site_id = site.id.load(std::memory_order_relaxed);
+    if(!site_id)
+        site_id = register_site(site, prod);
+    auto type_id = get_type_id(type ? type : "SystemC", prod);
+    auto& buf = tdata.buf;
+    begin_record(buf, MESSAGE);
+    buf.append<uint32_t>(site_id);
+    buf.append<uint32_t>(type_id);
+    buf.append<uint64_t>(sc_core::sc_time_stamp().value());
+    buf.append<uint64_t>(sc_core::sc_delta_count());
+    return buf;
+}
+
+void binary_logger::end_message(buffer& buf) { push_record(*tdata.prod, buf); }
+
+bool binary_logger::decode(std::string const& file_name, std::ostream& os) {
+    std::ifstream is(file_name, std::ios::binary);
+    char magic[sizeof(file_magic)];
+    if(!is.read(magic, sizeof(magic)) || std::memcmp(magic, file_magic, sizeof(magic)) != 0)
+        return false;
+    // the definitions are collected first since they may have been written by another thread after their first use
+    double tick_ps = 1.0;
+    std::unordered_map<uint32_t, site_info> sites;
+    std::unordered_map<uint32_t, std::string> types;
+    record_reader defs(is);
+    while(defs.next()) {
+        switch(defs.kind()) {
+        case RESOLUTION:
+            tick_ps = defs.get<double>();
+            break;
+        case SITE: {
+            auto id = defs.get<uint32_t>();
+            auto line = defs.get<int32_t>();
+            auto verbosity = defs.get<int32_t>();
+            auto file = defs.get_string();
+            sites[id] = site_info{line, verbosity, file, defs.get_string()};
+            break;
+        }
+        case TYPE: {
+            auto id = defs.get<uint32_t>();
+            types[id] = defs.get_string();
+            break;
+        }
+        default:
+            break;
+        }
+        if(defs.error)
+            return false;
+    }
+    if(defs.error)
+        return false;
+    is.clear();
+    is.seekg(sizeof(file_magic));
+    record_reader msgs(is);
+    fmt::memory_buffer line;
+    while(msgs.next()) {
+        if(msgs.kind() != MESSAGE)
+            continue;
+        auto site_id = msgs.get<uint32_t>();
+        auto type_id = msgs.get<uint32_t>();
+        auto time = msgs.get<uint64_t>();
+        auto delta = msgs.get<uint64_t>();
+        auto site_it = sites.find(site_id);
+        auto type_it = types.find(type_id);
+        if(msgs.error || site_it == sites.end() || type_it == types.end())
+            return false;
+        fmt::dynamic_format_arg_store<fmt::format_context> args;
+        while(!msgs.at_end() && !msgs.error) {
+            switch(msgs.get<uint8_t>()) {
+            case INT_ARG:
+                args.push_back(msgs.get<int64_t>());
+                break;
+            case UINT_ARG:
+                args.push_back(msgs.get<uint64_t>());
+                break;
+            case FLOAT_ARG:
+                args.push_back(msgs.get<double>());
+                break;
+            case BOOL_ARG:
+                args.push_back(msgs.get<uint8_t>() != 0);
+                break;
+            case CHAR_ARG:
+                args.push_back(msgs.get<char>());
+                break;
+            case STRING_ARG:
+                args.push_back(msgs.get_string());
+                break;
+            case POINTER_ARG:
+                args.push_back(reinterpret_cast<void const*>(static_cast<uintptr_t>(msgs.get<uint64_t>())));
+                break;
+            default:
+                msgs.error = true;
+                break;
+            }
+        }
+        if(msgs.error)
+            return false;
+        line.clear();
+        auto& site = site_it->second;
+        fmt::format_to(std::back_inserter(line), "[{}] [{:>20}({:>5})] {}: ", severity_char(site.verbosity), format_time(time, tick_ps),
+                       delta, type_it->second);
+        try {
+            fmt::vformat_to(std::back_inserter(line), site.format, args);
+        } catch(fmt::format_error& e) {
+            fmt::format_to(std::back_inserter(line), "<{} in format '{}' of {}:{}>", e.what(), site.format, site.file, site.line);
+        }
+        line.push_back('\n');
+        os.write(line.data(), line.size());
+    }
+    return !msgs.error;
+}
+} // namespace scc
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_BINARY_LOG_H_
+#define _SCC_BINARY_LOG_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fmt/format.h>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/** \ingroup scc-sysc
+ *  @{
+ */
+/**@{*/
+//! @brief SCC SystemC utilities
+namespace scc {
+/**
+ * @struct log_site
+ * @brief the static description of a formatted log statement (see SCCTRACEF() and friends)
+ *
+ * Each statement has exactly one instance so the binary log refers to it by a number instead of recording the format
+ * string with each message.
+ */
+struct log_site {
+    //! the source file
+    char const* file;
+    //! the source line
+    int line;
+    //! the sc_core::sc_verbosity of the statement
+    int verbosity;
+    //! the fmt format string
+    char const* format;
+    //! the id in the binary log, 0 if not yet registered
+    std::atomic<uint32_t> id{0};
+
+    log_site(char const* file, int line, int verbosity, char const* format)
+    : file(file)
+    , line(line)
+    , verbosity(verbosity)
+    , format(format) {}
+};
+/**
+ * @class binary_logger
+ * @brief deferred formatting of log messages
+ *
+ * If active the formatted info, debug and trace messages (SCCINFOF(), SCCDEBUGF(), SCCTRACEF() and SCCTRACEALLF())
+ * are not formatted. Instead the id of the log statement, the message type, the simulation time, the delta cycle and
+ * the raw arguments are put into a lock-free queue of the calling thread. A background thread writes them to a binary
+ * file which can be converted to text using decode() (or the scclog2txt tool). Warnings and errors as well as
+ * messages of the stream based macros are reported through SystemC as usual.
+ *
+ * Arguments of arithmetic types, characters, strings and pointers are stored as they are, arguments of other types
+ * are formatted using fmt when the message is recorded. The regular expression filter of LogConfig is not applied.
+ */
+class binary_logger {
+public:
+    //! the default number of 64 byte chunks buffered per thread
+    static constexpr size_t default_queue_size = 64 * 1024;
+    //! true if messages are recorded in the binary log
+    static bool is_active() { return active; }
+    /**
+     * @brief starts recording
+     *
+     * @param file_name the name of the binary log file
+     * @param queue_size the number of 64 byte chunks each recording thread can buffer
+     * @return false if the file can not be opened
+     */
+    static bool start(std::string const& file_name, size_t queue_size = default_queue_size);
+    //! stops recording after all buffered messages have been written, called at program exit at the latest
+    static void stop();
+    /**
+     * @brief records a message
+     *
+     * @param site the log statement
+     * @param type the message type
+     * @param args the arguments of the format string
+     */
+    template <typename... ARGS> static void record(log_site& site, char const* type, ARGS const&... args) {
+        // arguments which need formatting are formatted before the message is started as their formatter may log itself
+        write_message(site, type, prepare(args)...);
+    }
+    /**
+     * @brief converts a binary log to text
+     *
+     * @param file_name the name of the binary log file
+     * @param os the stream receiving the text
+     * @return false if the file can not be read or is malformed
+     */
+    static bool decode(std::string const& file_name, std::ostream& os);
+    //! the tags of the recorded arguments
+    enum arg_tag : uint8_t { INT_ARG, UINT_ARG, FLOAT_ARG, BOOL_ARG, CHAR_ARG, STRING_ARG, POINTER_ARG };
+    //! the buffer a message is serialized into, it keeps its capacity and does not initialize appended bytes
+    class buffer {
+    public:
+        //! appends n bytes and returns a pointer to them
+        char* grow(size_t n) {
+            if(used + n > storage.size())
+                storage.resize(2 * (used + n));
+            auto* res = storage.data() + used;
+            used += n;
+            return res;
+        }
+        template <typename T> void append(T v) { std::memcpy(grow(sizeof(T)), &v, sizeof(T)); }
+        void append(char const* str, size_t len) { std::memcpy(grow(len), str, len); }
+        char* data() { return storage.data(); }
+        size_t size() const { return used; }
+        void clear() { used = 0; }
+
+    private:
+        std::vector<char> storage = std::vector<char>(256);
+        size_t used{0};
+    };
+
+private:
+    static buffer& begin_message(log_site& site, char const* type);
+    static void end_message(buffer& buf);
+
+    template <typename... ARGS> static void write_message(log_site& site, char const* type, ARGS const&... args) {
+        auto& buf = begin_message(site, type);
+        int dummy[] = {0, (encode(buf, args), 0)...};
+        (void)dummy;
+        end_message(buf);
+    }
+    //! the types being stored as they are
+    template <typename T>
+    using is_native = std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_pointer<T>::value || std::is_enum<T>::value ||
+                                                       std::is_array<T>::value || std::is_same<T, std::string>::value>;
+    template <typename T> static typename std::enable_if<is_native<T>::value, T const&>::type prepare(T const& v) { return v; }
+    template <typename T> static typename std::enable_if<!is_native<T>::value, std::string>::type prepare(T const& v) {
+        return fmt::format("{}", v);
+    }
+
+    template <typename T> static void put(buffer& buf, arg_tag tag, T v) {
+        buf.append<uint8_t>(tag);
+        buf.append(v);
+    }
+    static void put_string(buffer& buf, char const* str, uint32_t len) {
+        put(buf, STRING_ARG, len);
+        buf.append(str, len);
+    }
+    static void encode(buffer& buf, bool v) { put<uint8_t>(buf, BOOL_ARG, v); }
+    static void encode(buffer& buf, char v) { put(buf, CHAR_ARG, v); }
+    static void encode(buffer& buf, char const* v) { put_string(buf, v ? v : "", v ? std::strlen(v) : 0); }
+    static void encode(buffer& buf, std::string const& v) { put_string(buf, v.data(), v.size()); }
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type encode(buffer& buf, T v) {
+        put<int64_t>(buf, INT_ARG, v);
+    }
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type encode(buffer& buf, T v) {
+        put<uint64_t>(buf, UINT_ARG, v);
+    }
+    template <typename T> static typename std::enable_if<std::is_floating_point<T>::value>::type encode(buffer& buf, T v) {
+        put<double>(buf, FLOAT_ARG, v);
+    }
+    static void encode(buffer& buf, char* v) { encode(buf, static_cast<char const*>(v)); }
+    template <typename T> static void encode(buffer& buf, T* v) {
+        put<uint64_t>(buf, POINTER_ARG, reinterpret_cast<uintptr_t>(v));
+    }
+    template <typename T> static typename std::enable_if<std::is_enum<T>::value>::type encode(buffer& buf, T v) {
+        encode(buf, static_cast<typename std::underlying_type<T>::type>(v));
+    }
+
+    static bool active;
+};
+} // namespace scc
+/** @} */ // end of scc-sysc
+#endif    /* _SCC_BINARY_LOG_H_ */
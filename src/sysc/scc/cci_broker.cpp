@@ -56,20 +56,15 @@ cci_originator cci_broker::get_value_origin(const std::string& parname) const {
 }
 
 void cci_broker::insert_matching_preset_value(const std::string& parname) {
-    bool match = false;
-    for(auto const& e : wildcard_presets) {
-        if(std::regex_match(parname, e.second.rr)) {
-            consuming_broker::set_preset_cci_value(parname, e.second.value, e.second.originator);
-            match = true;
-            break;
-        }
+    if(wildcard_presets.empty())
+        return;
+    auto const* idx = wildcard_presets.find(parname, true);
+    if(idx) {
+        auto const& e = wildcard_values[*idx];
+        consuming_broker::set_preset_cci_value(parname, e.value, e.originator);
+        if(!wildcard_locks.empty() && wildcard_locks.find(parname))
+            consuming_broker::lock_preset_value(parname);
     }
-    if(match)
-        for(auto const& e : wildcard_locks) {
-            if(std::regex_match(parname, e.second)) {
-                consuming_broker::lock_preset_value(parname);
-            }
-        }
 }
 
 bool cci_broker::has_preset_value(const std::string& parname) const {
@@ -150,12 +145,14 @@ void cci_broker::set_preset_cci_value(const std::string& parname, const cci_valu
         return m_parent.set_preset_cci_value(parname, value, originator);
     } else {
         try {
-            if(parname.find_first_of("*?[") != std::string::npos) {
-                wildcard_presets.insert(std::pair<std::string, wildcard_entry>(
-                    parname, wildcard_entry{std::regex(util::glob_to_regex(parname)), value, originator}));
-            } else if(parname[0] == '^') {
-                wildcard_presets.insert(
-                    std::pair<std::string, wildcard_entry>(parname, wildcard_entry{std::regex(parname), value, originator}));
+            if(is_wildcard(parname)) {
+                auto it = wildcard_index.find(parname);
+                if(it == wildcard_index.end()) {
+                    wildcard_presets.insert(parname, wildcard_values.size());
+                    wildcard_index[parname] = wildcard_values.size();
+                    wildcard_values.push_back(wildcard_entry{value, originator});
+                } else
+                    wildcard_values[it->second] = wildcard_entry{value, originator};
             } else
                 consuming_broker::set_preset_cci_value(parname, value, originator);
         } catch(std::regex_error& e) {
@@ -169,10 +166,8 @@ void cci_broker::lock_preset_value(const std::string& parname) {
         m_parent.lock_preset_value(parname);
     } else {
         try {
-            if(parname.find_first_of("*?[") != std::string::npos) {
-                wildcard_locks.insert(std::pair<std::string, std::regex>(parname, std::regex(util::glob_to_regex(parname))));
-            } else if(parname[0] == '^') {
-                wildcard_locks.insert(std::pair<std::string, std::regex>(parname, std::regex(parname)));
+            if(is_wildcard(parname)) {
+                wildcard_locks.insert(parname, true);
             } else
                 consuming_broker::lock_preset_value(parname);
         } catch(std::regex_error& e) {
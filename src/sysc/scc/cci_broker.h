@@ -25,6 +25,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <util/glob_trie.h>
 #include <vector>
 
 namespace scc {
@@ -49,13 +50,19 @@ class cci_broker : public cci_utils::consuming_broker {
 
     void insert_matching_preset_value(const std::string& parname);
 
+    static bool is_wildcard(const std::string& parname) {
+        return parname.size() && (parname[0] == '^' || parname.find_first_of("*?[") != std::string::npos);
+    }
+
     struct wildcard_entry {
-        std::regex rr;
         cci::cci_value value;
         cci::cci_originator originator;
     };
-    std::unordered_map<std::string, wildcard_entry> wildcard_presets;
-    std::unordered_map<std::string, std::regex> wildcard_locks;
+    // the patterns are kept in tries so that matching a parameter name does not depend on the number of patterns
+    std::vector<wildcard_entry> wildcard_values;
+    std::unordered_map<std::string, size_t> wildcard_index;
+    util::glob_trie<size_t> wildcard_presets{'.'};
+    util::glob_trie<bool> wildcard_locks{'.'};
 
 public:
     cci::cci_originator get_value_origin(const std::string& parname) const override;
@@ -77,6 +84,7 @@ public:
      * The globbing supports ?,*,**, and character classes ([a-z] as well as [!a-z]). '.' acts as
      * hierarchy delimiter and is only matched with **
      * Regular expression must start with a carret ('^') so that it can be identified as regex.
+     * If several patterns match a parameter the one added last wins, setting a pattern again replaces its value.
      *
      * The preset value has priority to the default value being set by the owner!
      *
@@ -15,7 +15,9 @@
  *******************************************************************************/
 
 #include "configurable_tracer.h"
+#include "report.h"
 #include "traceable.h"
+#include <cstring>
 #include <unordered_set>
 
 using namespace sc_core;
@@ -56,29 +58,30 @@ scc::configurable_tracer::~configurable_tracer() {
 void configurable_tracer::descend(const sc_core::sc_object* obj, bool trace) {
     if(obj == this)
         return;
-    const std::string kind = obj->kind();
-    if((types_to_trace & trace_types::SIGNALS) == trace_types::SIGNALS && kind == "tlm_signal") {
+    const char* kind = obj->kind();
+    auto is_kind = [kind](char const* k) -> bool { return std::strcmp(kind, k) == 0; };
+    if((types_to_trace & trace_types::SIGNALS) == trace_types::SIGNALS && is_kind("tlm_signal")) {
         if(trace)
             obj->trace(trf);
         return;
-    } else if(kind == "sc_vector") {
+    } else if(is_kind("sc_vector")) {
         if(trace)
             for(auto o : obj->get_child_objects())
                 descend(o, trace);
         return;
-    } else if(kind == "sc_module") {
+    } else if(is_kind("sc_module")) {
         auto trace_enable = get_trace_enabled(obj, default_trace_enable);
         if(trace_enable)
             obj->trace(trf);
         for(auto o : obj->get_child_objects())
             descend(o, trace_enable);
-    } else if(kind == "sc_variable") {
+    } else if(is_kind("sc_variable")) {
         if(trace && (types_to_trace & trace_types::VARIABLES) == trace_types::VARIABLES)
             obj->trace(trf);
-    } else if(kind == "sc_signal" || kind == "sc_clock" || kind == "sc_buffer" || kind == "sc_signal_rv") {
+    } else if(is_kind("sc_signal") || is_kind("sc_clock") || is_kind("sc_buffer") || is_kind("sc_signal_rv")) {
         if(trace && (types_to_trace & trace_types::SIGNALS) == trace_types::SIGNALS)
             try_trace(trf, obj, types_to_trace);
-    } else if(kind == "sc_in" || kind == "sc_out" || kind == "sc_inout") {
+    } else if(is_kind("sc_in") || is_kind("sc_out") || is_kind("sc_inout")) {
         if(trace && (types_to_trace & trace_types::PORTS) == trace_types::PORTS)
             try_trace(trf, obj, types_to_trace);
     } else if(const auto* tr = dynamic_cast<const scc::traceable*>(obj)) {
@@ -91,11 +94,27 @@ void configurable_tracer::descend(const sc_core::sc_object* obj, bool trace) {
     }
 }
 
+void configurable_tracer::add_trace_selection(std::string const& pattern) {
+    if(pattern.empty())
+        return;
+    try {
+        if(pattern[0] == '-' || pattern[0] == '+')
+            selection.insert(pattern.substr(1), pattern[0] == '+');
+        else
+            selection.insert(pattern, true);
+    } catch(std::regex_error& e) {
+        SCCERR(SCMOD) << "Invalid trace selection pattern '" << pattern << "', " << e.what();
+    }
+}
+
 auto scc::configurable_tracer::get_trace_enabled(const sc_core::sc_object* obj, bool fall_back) -> bool {
     auto* attr = obj->get_attribute(EN_TRACING_STR);
     if(attr != nullptr && dynamic_cast<const sc_core::sc_attribute<bool>*>(attr) != nullptr) {
         const auto* a = dynamic_cast<const sc_core::sc_attribute<bool>*>(attr);
         return a->value;
+    } else if(!selection.empty()) {
+        auto const* res = selection.find(obj->name(), true);
+        return res ? *res : fall_back;
     } else {
         std::string hier_name{obj->name()};
         auto h = cci_broker.get_param_handle(hier_name.append("." EN_TRACING_STR));
@@ -18,6 +18,7 @@
 #define _SCC_CONFIGURABLE_TRACER_H_
 
 #include "tracer.h"
+#include <util/glob_trie.h>
 /** \ingroup scc-sysc
  *  @{
  */
@@ -30,10 +31,21 @@ namespace scc {
  *
  * This class traverses the SystemC object hierarchy and registers all signals and ports found with the tracing
  * infrastructure. Using a sc_core::sc_attribute or a CCI param named "enableTracing" this can be switch on or off
- * on a per module basis
+ * on a per module basis.
+ *
+ * Alternatively a list of glob patterns (see util::glob_trie) can be given using add_trace_selection() or the CCI param
+ * trace_selection. In this case no "enableTracing" CCI params are created and the modules are selected by matching
+ * their hierarchical name against the patterns. A leading '-' excludes matching modules, the last matching pattern wins.
  */
 class configurable_tracer : public tracer {
 public:
+    /**
+     * cci parameter holding the list of glob patterns selecting the modules to trace
+     */
+    cci::cci_param<std::vector<std::string>> trace_selection{
+        "trace_selection", std::vector<std::string>{},
+        "List of glob patterns selecting the modules to be traced. A leading '-' excludes the matching modules, the last "
+        "matching pattern wins. If non-empty no enableTracing parameters are created"};
     /**
      * constructs a tracer object
      *
@@ -114,14 +126,25 @@ public:
      * destructor
      */
     ~configurable_tracer();
+    /**
+     * adds a pattern to the trace selection. A leading '-' excludes the matching modules from tracing, a leading '+'
+     * is ignored.
+     *
+     * @param pattern the glob pattern or a regular expression starting with '^'
+     */
+    void add_trace_selection(std::string const& pattern);
     /**
      * adds default trace control attribute of name 'enableTracing' to each sc_module in a design hierarchy
+     * unless a trace selection is given
      */
     void add_control() {
         if(control_added)
             return;
-        for(auto* o : sc_core::sc_get_top_level_objects())
-            augment_object_hierarchical(o);
+        for(auto const& p : trace_selection.get_value())
+            add_trace_selection(p);
+        if(selection.empty())
+            for(auto* o : sc_core::sc_get_top_level_objects())
+                augment_object_hierarchical(o);
         control_added = true;
     }
 
@@ -136,6 +159,8 @@ protected:
     void end_of_elaboration() override;
     //! array of created cci parameter
     std::vector<cci::cci_param_untyped*> params;
+    //! the compiled trace selection patterns
+    util::glob_trie<bool> selection;
     bool control_added{false};
 };
 
@@ -15,64 +15,37 @@
  *******************************************************************************/
 
 #include "configurer.h"
-#include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
 #include "report.h"
 #include <cci_configuration>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <fmt/format.h>
 #include <fstream>
-#include <rapidjson/istreamwrapper.h>
+#include <limits>
+#include <memory>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/reader.h>
 #include <unordered_map>
 #ifdef HAS_YAMPCPP
+#include <yaml-cpp/eventhandler.h>
 #include <yaml-cpp/exceptions.h>
-#include <yaml-cpp/node/parse.h>
+#include <yaml-cpp/parser.h>
 #include <yaml-cpp/yaml.h>
-
-namespace {
-template <typename T> struct optional {
-    T val{};
-    bool initialized{false};
-    optional& operator=(T&& val) {
-        this->val = std::move(val);
-        initialized = true;
-        return *this;
-    }
-    operator bool() const { return initialized; }
-    T value() { return val; }
-};
-} // namespace
-
-namespace YAML {
-template <typename T> struct as_if<T, optional<T>> {
-    explicit as_if(const YAML::Node& node_)
-    : node(node_) {}
-    const YAML::Node& node;
-    const optional<T> operator()() const {
-        optional<T> val;
-        T t;
-        if(node.m_pNode && YAML::convert<T>::decode(node, t))
-            val = std::move(t);
-        return val;
-    }
-};
-
-// There is already a std::string partial specialisation, so we need a full specialisation here
-template <> struct as_if<std::string, optional<std::string>> {
-    explicit as_if(const YAML::Node& node_)
-    : node(node_) {}
-    const YAML::Node& node;
-    const optional<std::string> operator()() const {
-        optional<std::string> val;
-        std::string t;
-        if(node.m_pNode && YAML::convert<std::string>::decode(node, t))
-            val = std::move(t);
-        return val;
-    }
-};
-} // namespace YAML
+#endif
+#ifdef WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#include <util/mmap_log.h>
 #endif
 namespace scc {
 namespace {
@@ -88,9 +61,274 @@ inline auto get_sc_objects(sc_core::sc_object* obj = nullptr) -> const std::vect
 #else
 #define DIR_SEPARATOR '/'
 #endif
+// the absolute name of a file or directory, the name itself if it cannot be resolved
+std::string absolute_path(std::string const& name) {
+#ifdef WIN32
+    char buf[_MAX_PATH];
+    return _fullpath(buf, name.c_str(), _MAX_PATH) ? std::string(buf) : name;
+#else
+    std::unique_ptr<char, void (*)(void*)> res(realpath(name.c_str(), nullptr), &free);
+    return res ? std::string(res.get()) : name;
+#endif
+}
+
+/*
+ * the content of an input file, it is memory mapped if possible so that large files are neither copied nor read
+ * through a stream
+ */
+class input_file {
+public:
+    bool open(std::string const& name) {
+#ifndef WIN32
+        if(file.open(name))
+            return true;
+#endif
+        std::ifstream ifs(name, std::ios::binary);
+        if(!ifs.is_open())
+            return false;
+        buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        return true;
+    }
+    char const* data() const {
+#ifndef WIN32
+        if(file.is_open())
+            return file.data();
+#endif
+        return buffer.data();
+    }
+    size_t size() const {
+#ifndef WIN32
+        if(file.is_open())
+            return file.size();
+#endif
+        return buffer.size();
+    }
+
+private:
+#ifndef WIN32
+    util::mmap_file_reader file;
+#endif
+    std::string buffer;
+};
+constexpr char snapshot_magic[8] = {'S', 'C', 'C', '-', 'C', 'F', 'G', '1'};
+/*
+ * a binary snapshot of the values read from a configuration file and its includes. Loading a snapshot needs to hash
+ * the input files to check that they did not change, the values are applied without parsing.
+ *
+ * Layout (native byte order): the header, the inputs (hash, name length, name) and the entries (value kind, name
+ * length, value or length of a string value, name, string value). The key is the hash of the main input file combined
+ * with the hashes of the context strings (the absolute path of the main file and of the include directories) as the
+ * includes are resolved relative to them.
+ */
+class config_snapshot {
+public:
+    struct header {
+        char magic[8];
+        uint64_t key;
+        uint32_t inputs;
+        uint32_t entries;
+    };
+    enum value_kind : uint8_t { BOOL_VALUE, INT_VALUE, INT64_VALUE, UINT_VALUE, UINT64_VALUE, DOUBLE_VALUE, STRING_VALUE };
+    // a 64bit hash consuming 8 bytes per step
+    static uint64_t hash(char const* data, size_t size) {
+        uint64_t h = 0xcbf29ce484222325ULL ^ size;
+        size_t i = 0;
+        for(; i + 8 <= size; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, data + i, 8);
+            h = (h ^ w) * 0x100000001b3ULL;
+            h ^= h >> 29;
+        }
+        for(; i < size; ++i)
+            h = (h ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ULL;
+        return h ^ (h >> 32);
+    }
 
+    void add_input(std::string const& name, char const* data, size_t size) {
+        auto h = hash(data, size);
+        if(!input_count)
+            key = h;
+        put(inputs, h);
+        put(inputs, static_cast<uint32_t>(name.size()));
+        inputs.append(name);
+        ++input_count;
+    }
+
+    // mixes a string the result of reading the main input file depends on into the key
+    void add_context(std::string const& str) { key = (key ^ hash(str.data(), str.size())) * 0x100000001b3ULL; }
+
+    void add(std::string const& name, cci::cci_value const& value) {
+        if(value.is_bool())
+            put_entry(BOOL_VALUE, name, static_cast<uint64_t>(value.get_bool()));
+        else if(value.is_int())
+            put_entry(INT_VALUE, name, static_cast<int64_t>(value.get_int()));
+        else if(value.is_int64())
+            put_entry(INT64_VALUE, name, static_cast<int64_t>(value.get_int64()));
+        else if(value.is_uint())
+            put_entry(UINT_VALUE, name, static_cast<uint64_t>(value.get_uint()));
+        else if(value.is_uint64())
+            put_entry(UINT64_VALUE, name, static_cast<uint64_t>(value.get_uint64()));
+        else if(value.is_double())
+            put_entry(DOUBLE_VALUE, name, value.get_double());
+        else if(value.is_string()) {
+            auto const& str = value.get_string();
+            put_entry(STRING_VALUE, name, static_cast<uint64_t>(str.size()));
+            entries.append(str.c_str(), str.size());
+        }
+    }
+
+    uint64_t get_key() const { return key; }
+    // writes the snapshot to a temporary file which is renamed so that concurrent simulations never see a partial file
+    bool write(std::string const& file_name) const {
+        header hdr;
+        std::memcpy(hdr.magic, snapshot_magic, sizeof(hdr.magic));
+        hdr.key = key;
+        hdr.inputs = input_count;
+        hdr.entries = entry_count;
+        auto tmp_name = fmt::format("{}.{}.{}", file_name, getpid(), std::chrono::steady_clock::now().time_since_epoch().count());
+        {
+            std::ofstream ofs(tmp_name, std::ios::binary);
+            if(!ofs.is_open())
+                return false;
+            ofs.write(reinterpret_cast<char const*>(&hdr), sizeof(hdr));
+            ofs.write(inputs.data(), inputs.size());
+            ofs.write(entries.data(), entries.size());
+            if(!ofs.good()) {
+                ofs.close();
+                std::remove(tmp_name.c_str());
+                return false;
+            }
+        }
+        if(std::rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+            std::remove(tmp_name.c_str());
+            return false;
+        }
+        return true;
+    }
+    /*
+     * calls func(name, value) for all values of a snapshot if it matches the key and none of the included files
+     * changed. Returns false without calling func if the snapshot cannot be used.
+     */
+    template <typename FUNC> static bool load(std::string const& file_name, uint64_t key, FUNC func) {
+        input_file in;
+        if(!in.open(file_name))
+            return false;
+        cursor cur{in.data(), in.size()};
+        header hdr;
+        if(!cur.get(hdr) || std::memcmp(hdr.magic, snapshot_magic, sizeof(hdr.magic)) || hdr.key != key)
+            return false;
+        std::string name;
+        for(auto i = 0U; i < hdr.inputs; ++i) {
+            uint64_t h;
+            uint32_t len;
+            char const* str;
+            if(!cur.get(h) || !cur.get(len) || !cur.get(str, len))
+                return false;
+            // the first input is the main file being checked by the key
+            if(i) {
+                input_file incl;
+                if(!incl.open(std::string(str, len)) || hash(incl.data(), incl.size()) != h)
+                    return false;
+            }
+        }
+        // check all entries before applying any of them
+        auto start = cur.pos;
+        for(auto apply : {false, true}) {
+            cur.pos = start;
+            for(auto i = 0U; i < hdr.entries; ++i) {
+                uint8_t kind;
+                uint32_t len;
+                uint64_t bits;
+                char const* str;
+                char const* value_str{nullptr};
+                if(!cur.get(kind) || kind > STRING_VALUE || !cur.get(len) || !cur.get(bits) || !cur.get(str, len) ||
+                   (kind == STRING_VALUE && !cur.get(value_str, bits)))
+                    return false;
+                if(!apply)
+                    continue;
+                name.assign(str, len);
+                switch(kind) {
+                case BOOL_VALUE:
+                    func(name, cci::cci_value(bits != 0));
+                    break;
+                case INT_VALUE:
+                    func(name, cci::cci_value(static_cast<int>(bits)));
+                    break;
+                case INT64_VALUE:
+                    func(name, cci::cci_value(static_cast<int64_t>(bits)));
+                    break;
+                case UINT_VALUE:
+                    func(name, cci::cci_value(static_cast<unsigned>(bits)));
+                    break;
+                case UINT64_VALUE:
+                    func(name, cci::cci_value(bits));
+                    break;
+                case DOUBLE_VALUE: {
+                    double d;
+                    std::memcpy(&d, &bits, sizeof(d));
+                    func(name, cci::cci_value(d));
+                    break;
+                }
+                default:
+                    func(name, cci::cci_value(std::string(value_str, bits)));
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    struct cursor {
+        char const* data;
+        size_t size;
+        size_t pos{0};
+        template <typename T> bool get(T& v) {
+            if(pos + sizeof(T) > size)
+                return false;
+            std::memcpy(&v, data + pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+        bool get(char const*& str, size_t len) {
+            if(len > size - pos)
+                return false;
+            str = data + pos;
+            pos += len;
+            return true;
+        }
+    };
+    template <typename T> static void put(std::string& buf, T v) { buf.append(reinterpret_cast<char const*>(&v), sizeof(T)); }
+    template <typename T> void put_entry(value_kind kind, std::string const& name, T v) {
+        put(entries, static_cast<uint8_t>(kind));
+        put(entries, static_cast<uint32_t>(name.size()));
+        put(entries, v);
+        entries.append(name);
+        ++entry_count;
+    }
+
+    std::string inputs;
+    std::string entries;
+    uint64_t key{0};
+    uint32_t input_count{0};
+    uint32_t entry_count{0};
+};
+/*
+ * the base of the streaming configuration readers. The readers do not build a document tree, they keep the
+ * hierarchical name of the current position in a single string and hand each value to set_value() as soon as it is
+ * parsed.
+ */
 struct config_reader {
+    configurer::broker_t& broker;
     std::vector<std::string> includes{"."};
+    std::string error_msg;
+    // the hierarchical name of the current object
+    std::string path;
+    // if set all values are recorded in the snapshot
+    config_snapshot* snapshot{nullptr};
+
+    config_reader(configurer::broker_t& broker)
+    : broker(broker) {}
+
     void add_to_includes(std::string const& path) {
         for(auto& e : includes) {
             if(e == path)
@@ -111,6 +349,35 @@ struct config_reader {
             }
         return file_name;
     }
+    // appends a key to the current path and returns the previous length of the path
+    size_t push_path(char const* key, size_t len) {
+        auto old_len = path.size();
+        if(old_len)
+            path += '.';
+        path.append(key, len);
+        return old_len;
+    }
+    /*
+     * applies a value to an existing parameter or stores it as preset value. The text is used if the parameter is a
+     * string parameter while the value has been inferred to be of another type.
+     */
+    void set_value(std::string const& hier_name, cci::cci_value const& value, std::string const* text = nullptr) {
+        auto param_handle = broker.get_param_handle(hier_name);
+        if(param_handle.is_valid() && text && !value.is_string() && param_handle.get_cci_value().is_string()) {
+            // the snapshot needs to record what has been applied so that a replay sets the same value
+            cci::cci_value str_value(*text);
+            param_handle.set_cci_value(str_value);
+            if(snapshot)
+                snapshot->add(hier_name, str_value);
+            return;
+        }
+        if(param_handle.is_valid())
+            param_handle.set_cci_value(value);
+        else
+            broker.set_preset_cci_value(hier_name, value);
+        if(snapshot)
+            snapshot->add(hier_name, value);
+    }
 };
 /*************************************************************************************************
  * JSON config start
@@ -138,371 +405,576 @@ inline void writeValue(writer_type& writer, std::string const& key, std::string
     writer.String(value.c_str());
 }
 
-inline bool start_object(writer_type& writer, char const* key, bool started) {
-    if(!started) {
+// writes the configuration as JSON, see config_dumper
+struct json_config_writer {
+    // the log levels of modules without log_level parameter are only written if logging has been initialized
+    static constexpr bool log_level_needs_logging = true;
+    OStreamWrapper stream;
+    writer_type writer;
+
+    json_config_writer(std::ostream& os)
+    : stream(os)
+    , writer(stream) {}
+    void start() { writer.StartObject(); }
+    void finish() { writer.EndObject(); }
+    void begin_object(char const* key) {
         writer.Key(key);
         writer.StartObject();
     }
-    return true;
-}
+    void end_object() { writer.EndObject(); }
+    template <typename T> void value(std::string const& key, T val) { writeValue(writer, key, val); }
+    void description(std::string const&, std::string const&) {}
+};
 
-struct json_config_dumper {
-    configurer::broker_t const& broker;
-    std::vector<std::string> const& stop_list;
-    std::unordered_map<std::string, std::vector<cci::cci_param_untyped_handle>> lut;
-    json_config_dumper(configurer::broker_t const& broker, std::vector<std::string> const& stop_list)
-    : broker(broker)
-    , stop_list(stop_list) {
-        for(auto& h : broker.get_param_handles()) {
-            auto value = h.get_cci_value();
-            std::string paramname{h.name()};
-            auto sep = paramname.rfind('.');
-            auto basename = paramname.substr(0, sep);
-            lut[basename].push_back(h);
+/*
+ * reads JSON using the SAX interface of rapidjson. Values in arrays are ignored.
+ */
+struct json_config_reader : public config_reader, public BaseReaderHandler<UTF8<>, json_config_reader> {
+    // the path lengths of the enclosing objects
+    std::vector<size_t> objects;
+    size_t array_depth{0};
+    std::string key;
+
+    json_config_reader(configurer::broker_t& broker)
+    : config_reader(broker) {}
+
+    bool parse(char const* data, size_t size) {
+        objects.clear();
+        array_depth = 0;
+        Reader reader;
+        MemoryStream stream(data, size);
+        auto res = reader.Parse(stream, *this);
+        if(res.IsError()) {
+            error_msg = fmt::format(" location {}, reason: {}", res.Offset(), GetParseError_En(res.Code()));
+            return false;
         }
+        return true;
     }
 
-    void dump_config(sc_core::sc_object* obj, writer_type& writer) {
-        auto basename = std::string(obj->basename());
-        if(basename.substr(0, 3) == "$$$" || std::find(std::begin(stop_list), std::end(stop_list), obj->name()) != std::end(stop_list))
-            return;
-        auto obj_started = false;
-        auto log_lvl_set = false;
-        auto it = lut.find(obj->name());
-        if(it != lut.end())
-            for(auto& h : it->second) {
-                obj_started = start_object(writer, obj->basename(), obj_started);
-                auto value = h.get_cci_value();
-                std::string paramname{h.name()};
-                auto basename = paramname.substr(paramname.rfind('.') + 1);
-                if(basename == SCC_LOG_LEVEL_PARAM_NAME)
-                    log_lvl_set = true;
-                if(value.is_bool())
-                    writeValue(writer, basename, (bool)value.get_bool());
-                else if(value.is_int())
-                    writeValue(writer, basename, (int)value.get_int());
-                else if(value.is_int64())
-                    writeValue(writer, basename, static_cast<int64_t>(value.get_int64()));
-                else if(value.is_uint())
-                    writeValue(writer, basename, value.get_uint());
-                else if(value.is_uint64())
-                    writeValue(writer, basename, static_cast<uint64_t>(value.get_uint64()));
-                else if(value.is_double())
-                    writeValue(writer, basename, value.get_double());
-                else if(value.is_string())
-                    writeValue(writer, basename, value.get_string().c_str());
-            }
-        auto mod = dynamic_cast<sc_core::sc_module*>(obj);
-        if(scc::is_logging_initialized() && !log_lvl_set && mod) {
-            obj_started = start_object(writer, obj->basename(), obj_started);
-            auto val = broker.get_preset_cci_value(fmt::format("{}.{}", obj->name(), SCC_LOG_LEVEL_PARAM_NAME));
-            if(basename.substr(0, 3) != "$$$")
-                writeValue(writer, SCC_LOG_LEVEL_PARAM_NAME, val.is_int() ? val.get_int() : static_cast<int>(get_logging_level()));
+    std::string get_error_msg() { return error_msg; }
+
+    bool is_value() const { return objects.size() && !array_depth; }
+
+    bool put(cci::cci_value const& value) {
+        if(is_value()) {
+            auto len = push_path(key.data(), key.size());
+            set_value(path, value);
+            path.resize(len);
+        }
+        return true;
+    }
+
+    void include(std::string const& file_name) {
+        json_config_reader sub_reader(broker);
+        sub_reader.includes = includes;
+        sub_reader.path = path;
+        sub_reader.snapshot = snapshot;
+        input_file in;
+        auto full_name = find_in_include_path(file_name);
+        if(!in.open(full_name))
+            throw std::runtime_error(fmt::format("Could not open include file {}", file_name));
+        if(snapshot)
+            snapshot->add_input(full_name, in.data(), in.size());
+        if(!sub_reader.parse(in.data(), in.size()))
+            throw std::runtime_error(fmt::format("Could not parse include file {}", file_name));
+    }
+    // the SAX handler functions
+    bool Null() { return true; }
+    bool Bool(bool b) { return put(cci::cci_value(b)); }
+    bool Int(int i) { return put(cci::cci_value(i)); }
+    // unsigned numbers are signed values if they fit, as the type checks of the JSON document did (IsInt before IsInt64
+    // before IsUint), so values in [2^31, 2^32) become int64_t
+    bool Uint(unsigned u) { return u <= static_cast<unsigned>(std::numeric_limits<int>::max()) ? Int(u) : Int64(u); }
+    bool Int64(int64_t i) { return put(cci::cci_value(i)); }
+    bool Uint64(uint64_t u) {
+        return u <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) ? Int64(u) : put(cci::cci_value(u));
+    }
+    bool Double(double d) { return put(cci::cci_value(d)); }
+    bool String(const char* str, SizeType length, bool) {
+        if(is_value() && key == "!include")
+            include(std::string(str, length));
+        else
+            put(cci::cci_value(std::string(str, length)));
+        return true;
+    }
+    bool StartObject() {
+        if(array_depth)
+            return true;
+        objects.push_back(path.size());
+        if(objects.size() > 1)
+            push_path(key.data(), key.size());
+        return true;
+    }
+    bool Key(const char* str, SizeType length, bool) {
+        key.assign(str, length);
+        return true;
+    }
+    bool EndObject(SizeType) {
+        if(array_depth)
+            return true;
+        path.resize(objects.back());
+        objects.pop_back();
+        return true;
+    }
+    bool StartArray() {
+        ++array_depth;
+        return true;
+    }
+    bool EndArray(SizeType) {
+        --array_depth;
+        return true;
+    }
+};
+/*************************************************************************************************
+ * JSON config end
+ ************************************************************************************************/
+#ifdef HAS_YAMPCPP
+/*************************************************************************************************
+ * YAML config start
+ ************************************************************************************************/
+/*
+ * writes the configuration as YAML directly to the output stream, see config_dumper. Strings are double quoted so
+ * that they are read back as strings.
+ */
+struct yaml_config_writer {
+    static constexpr bool log_level_needs_logging = false;
+    std::ostream& os;
+    std::string indent;
+    bool empty{true};
+
+    yaml_config_writer(std::ostream& os)
+    : os(os) {}
+    void start() {}
+    void finish() {
+        if(empty)
+            os << "{}\n";
+    }
+    void begin_object(char const* key) {
+        os << indent << key << ":\n";
+        indent += "  ";
+        empty = false;
+    }
+    void end_object() { indent.resize(indent.size() - 2); }
+    void value(std::string const& key, bool val) { line(key) << (val ? "true" : "false") << '\n'; }
+    void value(std::string const& key, int64_t val) { line(key) << val << '\n'; }
+    void value(std::string const& key, uint64_t val) { line(key) << val << '\n'; }
+    void value(std::string const& key, double val) {
+        auto& o = line(key);
+        if(std::isnan(val))
+            o << ".nan\n";
+        else if(std::isinf(val))
+            o << (val < 0 ? "-.inf\n" : ".inf\n");
+        else {
+            auto str = fmt::format("{}", val);
+            // keep the value a floating point number when reading it back
+            if(str.find_first_of(".e") == std::string::npos)
+                str += ".0";
+            o << str << '\n';
         }
-        for(auto* o : get_sc_objects(obj)) {
-            obj_started = start_object(writer, obj->basename(), obj_started);
-            dump_config(o, writer);
+    }
+    void value(std::string const& key, std::string const& val) { quoted(line(key), val) << '\n'; }
+    void description(std::string const& key, std::string const& text) { quoted(line(key) << "!desc ", text) << '\n'; }
+
+private:
+    std::ostream& line(std::string const& key) {
+        empty = false;
+        return os << indent << key << ": ";
+    }
+    static std::ostream& quoted(std::ostream& o, std::string const& str) {
+        o << '"';
+        for(auto c : str) {
+            switch(c) {
+            case '"':
+                o << "\\\"";
+                break;
+            case '\\':
+                o << "\\\\";
+                break;
+            case '\n':
+                o << "\\n";
+                break;
+            case '\t':
+                o << "\\t";
+                break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20)
+                    o << fmt::format("\\x{:02x}", static_cast<unsigned>(c));
+                else
+                    o << c;
+            }
         }
-        if(obj_started)
-            writer.EndObject();
+        return o << '"';
     }
 };
 
-struct json_config_reader : public config_reader {
-    configurer::broker_t& broker;
-    Document document;
-    bool valid{false};
+/*
+ * reads YAML using the event interface of yaml-cpp. The type of a plain scalar is determined once by infer_value(),
+ * quoted scalars are strings. Values in sequences are ignored, aliases of anchored scalars and maps are expanded.
+ */
+struct yaml_config_reader : public config_reader, public YAML::EventHandler {
+    enum frame_kind { MAP, IGNORED };
+    struct frame {
+        frame_kind kind;
+        // the length of the path before entering the map
+        size_t path_len;
+        YAML::anchor_t anchor;
+        bool expect_key{true};
+    };
+    std::vector<frame> frames;
+    std::string key;
+    // the values of the anchored nodes relative to the node
+    std::unordered_map<YAML::anchor_t, std::vector<std::pair<std::string, cci::cci_value>>> anchors;
+    // the anchored maps being read and the path length of their start
+    std::vector<std::pair<YAML::anchor_t, size_t>> recordings;
+    bool started{false};
 
-    json_config_reader(configurer::broker_t& broker)
-    : broker(broker) {}
+    yaml_config_reader(configurer::broker_t& broker)
+    : config_reader(broker) {}
+
+    bool parse(char const* data, size_t size) {
+        memory_buffer buf(data, size);
+        std::istream is(&buf);
+        frames.clear();
+        started = false;
+        try {
+            YAML::Parser parser(is);
+            parser.HandleNextDocument(*this);
+        } catch(YAML::Exception& e) {
+            error_msg = e.what();
+            return false;
+        }
+        if(!started) {
+            error_msg = "YAML file does not start with a map";
+            return false;
+        }
+        return true;
+    }
 
-    void parse(std::istream& is) {
-        IStreamWrapper stream(is);
-        document.ParseStream(stream);
-        valid = !document.HasParseError();
-    }
-    std::string get_error_msg() {
-        std::ostringstream os;
-        os << " location " << (unsigned)document.GetErrorOffset() << ", reason: " << GetParseError_En(document.GetParseError());
-        return os.str();
-    }
-
-    inline void configure_cci() { configure_cci_hierarchical(document, ""); }
-
-    void configure_cci_hierarchical(Value const& value, std::string prefix) {
-        if(value.IsObject()) {
-            auto o = value.GetObject();
-            for(auto itr = o.MemberBegin(); itr != o.MemberEnd(); ++itr) {
-                if(!itr->name.IsString())
-                    return;
-                std::string key_name = itr->name.GetString();
-                Value const& val = itr->value;
-                auto hier_name = prefix.size() ? prefix + "." + key_name : key_name;
-                if(val.IsNull() || val.IsArray())
-                    return;
-                else if(val.IsObject())
-                    configure_cci_hierarchical(val, hier_name);
-                else {
-                    if(key_name == "!include") {
-                        json_config_reader sub_reader(broker);
-                        std::ifstream ifs(find_in_include_path(val.GetString()));
-                        if(ifs.is_open()) {
-                            sub_reader.parse(ifs);
-                            if(sub_reader.valid) {
-                                sub_reader.configure_cci_hierarchical(sub_reader.document, prefix);
-                            } else {
-                                std::ostringstream os;
-                                os << "Could not parse include file " << val.GetString();
-                                throw std::runtime_error(os.str());
-                            }
-                        } else {
-                            std::ostringstream os;
-                            os << "Could not open include file " << val.GetString();
-                            throw std::runtime_error(os.str());
-                        }
-                    } else {
-                        auto param_handle = broker.get_param_handle(hier_name);
-                        if(param_handle.is_valid()) {
-                            if(val.IsString()) {
-                                param_handle.set_cci_value(cci::cci_value(std::string(val.GetString())));
-                            } else if(val.IsBool()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<bool>()));
-                            } else if(val.IsInt()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<int>()));
-                            } else if(val.IsInt64()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<int64_t>()));
-                            } else if(val.IsUint()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<unsigned>()));
-                            } else if(val.IsUint64()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<uint64_t>()));
-                            } else if(val.IsDouble()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<double>()));
-                            }
-                        } else {
-                            if(val.IsString()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(std::string(val.GetString())));
-                            } else if(val.IsBool()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<bool>()));
-                            } else if(val.IsInt()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<int>()));
-                            } else if(val.IsInt64()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<int64_t>()));
-                            } else if(val.IsUint()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<unsigned>()));
-                            } else if(val.IsUint64()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<uint64_t>()));
-                            } else if(val.IsDouble()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<double>()));
-                            }
-                        }
-                    }
+    std::string get_error_msg() { return error_msg; }
+    /*
+     * determines the type of a plain scalar following the conversion rules of yaml-cpp, the types are tried in the
+     * order bool, int, int64_t, uint64_t and double
+     */
+    static cci::cci_value infer_value(std::string const& text) {
+        if(text.empty())
+            return cci::cci_value(text);
+        auto first = text[0];
+        if(std::isalpha(static_cast<unsigned char>(first)) && text.size() <= 5) {
+            auto lower = util::str_tolower(text);
+            auto flexible_case = text == lower || text == util::str_toupper(text) ||
+                                 (std::isupper(static_cast<unsigned char>(first)) && text.substr(1) == lower.substr(1));
+            if(flexible_case) {
+                if(lower == "y" || lower == "yes" || lower == "true" || lower == "on")
+                    return cci::cci_value(true);
+                if(lower == "n" || lower == "no" || lower == "false" || lower == "off")
+                    return cci::cci_value(false);
+            }
+        }
+        if(std::isdigit(static_cast<unsigned char>(first)) || first == '-' || first == '+' || first == '.') {
+            char* end;
+            errno = 0;
+            if(first != '-') {
+                auto u = std::strtoull(text.c_str(), &end, 0);
+                if(!*end && !errno) {
+                    if(u <= static_cast<unsigned long long>(std::numeric_limits<int>::max()))
+                        return cci::cci_value(static_cast<int>(u));
+                    if(u <= static_cast<unsigned long long>(std::numeric_limits<int64_t>::max()))
+                        return cci::cci_value(static_cast<int64_t>(u));
+                    return cci::cci_value(static_cast<uint64_t>(u));
+                }
+            } else {
+                auto i = std::strtoll(text.c_str(), &end, 0);
+                if(!*end && !errno) {
+                    if(i >= std::numeric_limits<int>::min())
+                        return cci::cci_value(static_cast<int>(i));
+                    return cci::cci_value(static_cast<int64_t>(i));
                 }
             }
+            errno = 0;
+            auto d = std::strtod(text.c_str(), &end);
+            if(!*end && !errno && !std::isinf(d) && !std::isnan(d))
+                return cci::cci_value(d);
         }
+        if(text == ".inf" || text == ".Inf" || text == ".INF" || text == "+.inf" || text == "+.Inf" || text == "+.INF")
+            return cci::cci_value(std::numeric_limits<double>::infinity());
+        if(text == "-.inf" || text == "-.Inf" || text == "-.INF")
+            return cci::cci_value(-std::numeric_limits<double>::infinity());
+        if(text == ".nan" || text == ".NaN" || text == ".NAN")
+            return cci::cci_value(std::numeric_limits<double>::quiet_NaN());
+        return cci::cci_value(text);
     }
+
+    void put(cci::cci_value const& value, std::string const* text = nullptr) {
+        set_value(path, value, text);
+        for(auto const& r : recordings)
+            anchors[r.first].emplace_back(path.substr(r.second), value);
+    }
+
+    void include(std::string const& file_name) {
+        yaml_config_reader sub_reader(broker);
+        sub_reader.includes = includes;
+        sub_reader.path = path;
+        sub_reader.snapshot = snapshot;
+        input_file in;
+        auto full_name = find_in_include_path(file_name);
+        if(!in.open(full_name))
+            throw std::runtime_error(fmt::format("Could not open include file {}", file_name));
+        if(snapshot)
+            snapshot->add_input(full_name, in.data(), in.size());
+        if(!sub_reader.parse(in.data(), in.size()))
+            throw std::runtime_error(fmt::format("Could not parse include file {}, {}", file_name, sub_reader.error_msg));
+    }
+    // true if the next node is the value of a map entry
+    bool is_value() const { return frames.size() && frames.back().kind == MAP && !frames.back().expect_key; }
+    // enters a nested node, returns false if it is to be ignored
+    bool enter() {
+        if(!frames.size())
+            return true;
+        auto& top = frames.back();
+        if(top.kind == MAP && top.expect_key) {
+            // complex keys are not supported
+            top.expect_key = false;
+            return false;
+        }
+        top.expect_key = true;
+        return top.kind == MAP;
+    }
+    // the event handler functions
+    void OnDocumentStart(const YAML::Mark&) override {}
+    void OnDocumentEnd() override {}
+    void OnNull(const YAML::Mark&, YAML::anchor_t) override {
+        if(frames.size() && frames.back().kind == MAP) {
+            if(frames.back().expect_key)
+                key.clear();
+            frames.back().expect_key = !frames.back().expect_key;
+        }
+    }
+    void OnAlias(const YAML::Mark&, YAML::anchor_t anchor) override {
+        auto value = is_value();
+        if(!enter() || !value)
+            return;
+        auto it = anchors.find(anchor);
+        if(it == anchors.end())
+            return;
+        auto len = push_path(key.data(), key.size());
+        auto base_len = path.size();
+        for(auto const& e : it->second) {
+            path.resize(base_len);
+            path += e.first;
+            put(e.second);
+        }
+        path.resize(len);
+    }
+    // scalars with other tags than the standard ones and !include (e.g. the !desc of a dump) are ignored
+    void OnScalar(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, const std::string& text) override {
+        if(frames.size() && frames.back().kind == MAP && frames.back().expect_key) {
+            key = text;
+            frames.back().expect_key = false;
+            return;
+        }
+        auto value = is_value();
+        if(!enter() || !value)
+            return;
+        auto len = push_path(key.data(), key.size());
+        if(tag == "!include")
+            include(text);
+        else if(tag == "?" || tag == "!" || tag.compare(0, 18, "tag:yaml.org,2002:") == 0) {
+            auto val = tag == "!" || util::ends_with(tag, ":str") ? cci::cci_value(text) : infer_value(text);
+            put(val, &text);
+            if(anchor)
+                anchors[anchor].emplace_back(std::string{}, val);
+        }
+        path.resize(len);
+    }
+    void OnSequenceStart(const YAML::Mark&, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value) override {
+        enter();
+        frames.push_back(frame{IGNORED, path.size(), 0});
+    }
+    void OnSequenceEnd() override { frames.pop_back(); }
+    void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value) override {
+        if(!frames.size()) {
+            started = true;
+            frames.push_back(frame{MAP, path.size(), 0});
+        } else if(enter()) {
+            auto len = push_path(key.data(), key.size());
+            frames.push_back(frame{MAP, len, anchor});
+            if(anchor) {
+                anchors[anchor].clear();
+                recordings.emplace_back(anchor, path.size());
+            }
+        } else
+            frames.push_back(frame{IGNORED, path.size(), 0});
+    }
+    void OnMapEnd() override {
+        auto& top = frames.back();
+        if(top.anchor && recordings.size() && recordings.back().first == top.anchor)
+            recordings.pop_back();
+        path.resize(top.path_len);
+        frames.pop_back();
+    }
+
+private:
+    // a read-only stream buffer on the input data
+    struct memory_buffer : public std::streambuf {
+        memory_buffer(char const* data, size_t size) {
+            auto* begin = const_cast<char*>(data);
+            setg(begin, begin, begin + size);
+        }
+    };
 };
 /*************************************************************************************************
- * JSON config end
- ************************************************************************************************/
-#ifdef HAS_YAMPCPP
-/*************************************************************************************************
- * YAML config start
+ * YAML config end
  ************************************************************************************************/
-struct yaml_config_dumper {
+#endif
+/*
+ * walks the design hierarchy and passes the parameters to a writer (json_config_writer or yaml_config_writer). The
+ * writer is called while walking so no document is built in memory, objects are only opened once they have content.
+ */
+template <typename WRITER> struct config_dumper {
+    WRITER& writer;
     configurer::broker_t const& broker;
-    bool with_description{false};
+    bool with_description;
     std::vector<std::string> const& stop_list;
-    std::unordered_map<std::string, std::vector<cci::cci_param_untyped_handle>> lut;
-    std::vector<cci::cci_param_untyped_handle> tl_lut;
-    yaml_config_dumper(configurer::broker_t const& broker, bool with_description, std::vector<std::string> const& stop_list)
-    : broker(broker)
+    configurer::dump_filter filter;
+    std::unordered_map<std::string, uint64_t>& last_dump;
+    std::vector<cci::cci_param_untyped_handle> handles;
+    // the indices of the parameters of an object and of the top level parameters
+    std::unordered_map<std::string, std::vector<size_t>> lut;
+    std::vector<size_t> tl_lut;
+    // the names of the objects being entered and the number of them being written
+    std::vector<char const*> pending;
+    size_t opened{0};
+
+    config_dumper(WRITER& writer, configurer::broker_t const& broker, bool with_description, std::vector<std::string> const& stop_list,
+                  configurer::dump_filter filter, std::unordered_map<std::string, uint64_t>& last_dump)
+    : writer(writer)
+    , broker(broker)
     , with_description(with_description)
-    , stop_list(stop_list) {
-        for(auto& h : broker.get_param_handles()) {
-            auto value = h.get_cci_value();
-            std::string paramname{h.name()};
+    , stop_list(stop_list)
+    , filter(filter)
+    , last_dump(last_dump)
+    , handles(broker.get_param_handles()) {
+        for(size_t i = 0; i < handles.size(); ++i) {
+            std::string paramname{handles[i].name()};
             auto sep = paramname.rfind('.');
-            if(sep == std::string::npos) {
-                tl_lut.push_back(h);
-            } else {
-                auto basename = paramname.substr(0, sep);
-                lut[basename].push_back(h);
-            }
+            if(sep == std::string::npos)
+                tl_lut.push_back(i);
+            else
+                lut[paramname.substr(0, sep)].push_back(i);
         }
     }
 
-    void dump_config(YAML::Node& base_node) {
-        copy2yaml(tl_lut, base_node);
-        for(auto* o : sc_core::sc_get_top_level_objects()) {
-            dump_config(o, base_node);
+    void dump_config(sc_core::sc_object* obj) {
+        writer.start();
+        if(obj)
+            for(auto* o : obj->get_child_objects())
+                dump_config_hierarchical(o);
+        else {
+            copy_params(tl_lut);
+            for(auto* o : sc_core::sc_get_top_level_objects())
+                dump_config_hierarchical(o);
         }
+        writer.finish();
+    }
+
+private:
+    // a hash of the value to detect changes without keeping a copy of it
+    static uint64_t value_hash(cci::cci_value const& value) {
+        if(value.is_bool())
+            return value.get_bool() ? 1 : 2;
+        if(value.is_int64())
+            return std::hash<int64_t>()(value.get_int64()) * 3;
+        if(value.is_uint64())
+            return std::hash<uint64_t>()(value.get_uint64()) * 5;
+        if(value.is_double())
+            return std::hash<double>()(value.get_double()) * 7;
+        if(value.is_string())
+            return std::hash<std::string>()(value.get_string().c_str()) * 11;
+        return std::hash<std::string>()(value.to_json()) * 13;
     }
 
-    void dump_config(sc_core::sc_object* obj, YAML::Node& base_node) {
-        auto basename = std::string(obj->basename());
-        if(basename.substr(0, 3) == "$$$" || std::find(std::begin(stop_list), std::end(stop_list), obj->name()) != std::end(stop_list))
+    // the values are only remembered for the CHANGED filter to not keep a copy of all parameter names otherwise
+    bool is_selected(cci::cci_param_untyped_handle const& h, cci::cci_value const& value) {
+        switch(filter) {
+        case configurer::dump_filter::NON_DEFAULT:
+            return !(value == h.get_default_cci_value());
+        case configurer::dump_filter::CHANGED: {
+            auto hash = value_hash(value);
+            auto& last = last_dump[h.name()];
+            auto changed = last != hash;
+            last = hash;
+            return changed;
+        }
+        default:
+            return true;
+        }
+    }
+
+    void open() {
+        for(; opened < pending.size(); ++opened)
+            writer.begin_object(pending[opened]);
+    }
+
+    void dump_config_hierarchical(sc_core::sc_object* obj) {
+        auto basename = obj->basename();
+        if(std::strncmp(basename, "$$$", 3) == 0 ||
+           std::find(std::begin(stop_list), std::end(stop_list), obj->name()) != std::end(stop_list))
             return;
-        auto obj_started = false;
+        pending.push_back(basename);
         auto log_lvl_set = false;
         auto it = lut.find(obj->name());
-        YAML::Node this_node;
         if(it != lut.end())
-            log_lvl_set |= copy2yaml(it->second, this_node);
+            log_lvl_set = copy_params(it->second);
         auto mod = dynamic_cast<sc_core::sc_module*>(obj);
-        if(!log_lvl_set && mod) {
+        auto log_lvl_wanted = !WRITER::log_level_needs_logging || scc::is_logging_initialized();
+        if(filter == configurer::dump_filter::ALL && log_lvl_wanted && !log_lvl_set && mod && std::strcmp(basename, "scc_tracer")) {
             auto val = broker.get_preset_cci_value(fmt::format("{}.{}", obj->name(), SCC_LOG_LEVEL_PARAM_NAME));
-            auto global_verb = static_cast<int>(get_logging_level());
-            if(basename.substr(0, 11) != "scc_tracer")
-                this_node["log_level"] = val.is_int() ? val.get_int() : global_verb;
+            open();
+            auto lvl = val.is_int() ? val.get_int() : static_cast<int>(get_logging_level());
+            writer.value(SCC_LOG_LEVEL_PARAM_NAME, static_cast<int64_t>(lvl));
         }
-        for(auto* o : get_sc_objects(obj)) {
-            dump_config(o, this_node);
+        for(auto* o : get_sc_objects(obj))
+            dump_config_hierarchical(o);
+        if(opened == pending.size()) {
+            writer.end_object();
+            --opened;
         }
-        if(this_node.size())
-            base_node[obj->basename()] = this_node;
+        pending.pop_back();
     }
 
-private:
-    bool copy2yaml(const std::vector<cci::cci_param_untyped_handle>& params, YAML::Node& this_node) {
+    bool copy_params(std::vector<size_t> const& params) {
         bool log_lvl_set = false;
-        for(auto& h : params) {
+        for(auto idx : params) {
+            auto& h = handles[idx];
             auto value = h.get_cci_value();
             std::string paramname{h.name()};
             auto basename = paramname.substr(paramname.rfind('.') + 1);
             if(basename == SCC_LOG_LEVEL_PARAM_NAME)
                 log_lvl_set = true;
-
+            if(!is_selected(h, value))
+                continue;
+            open();
             auto descr = h.get_description();
-            if(with_description && descr.size()) {
-                auto descr_name = fmt::format("{}::descr", basename);
-                this_node[descr_name] = descr;
-                this_node[descr_name].SetTag("desc");
-            }
+            if(with_description && descr.size())
+                writer.description(fmt::format("{}::descr", basename), descr);
             sc_core::sc_time t;
             if(value.is_bool())
-                this_node[basename] = (bool)(value.get_bool());
-            else if(value.is_int())
-                this_node[basename] = (int)(value.get_int());
+                writer.value(basename, static_cast<bool>(value.get_bool()));
             else if(value.is_int64())
-                this_node[basename] = static_cast<int64_t>(value.get_int64());
-            else if(value.is_uint())
-                this_node[basename] = value.get_uint();
+                writer.value(basename, static_cast<int64_t>(value.get_int64()));
             else if(value.is_uint64())
-                this_node[basename] = static_cast<uint64_t>(value.get_uint64());
+                writer.value(basename, static_cast<uint64_t>(value.get_uint64()));
             else if(value.is_double())
-                this_node[basename] = value.get_double();
+                writer.value(basename, value.get_double());
             else if(value.is_string())
-                this_node[basename] = value.get_string().c_str();
+                writer.value(basename, std::string(value.get_string().c_str()));
             else if(value.try_get(t))
-                this_node[basename] = t.to_string();
+                writer.value(basename, t.to_string());
         }
         return log_lvl_set;
     }
 };
 
-struct yaml_config_reader : public config_reader {
-    configurer::broker_t& broker;
-    YAML::Node document;
-    bool valid{false};
-
-    yaml_config_reader(configurer::broker_t& broker)
-    : broker(broker) {}
-
-    void parse(std::istream& is) {
-        std::string buf((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
-        document = YAML::Load(buf);
-        valid = document.IsDefined() && document.IsMap();
-    }
-
-    std::string get_error_msg() { return "YAML file does not start with a map"; }
-
-    inline void configure_cci() {
-        try {
-            configure_cci_hierarchical(document, "");
-        } catch(YAML::ParserException& e) {
-            throw std::runtime_error(e.what());
-        } catch(YAML::BadFile& e) {
-            throw std::runtime_error(e.what());
-        } catch(YAML::Exception& e) {
-            throw std::runtime_error(e.what());
-        }
-    }
-
-    void configure_cci_hierarchical(YAML::Node const& value, std::string const& prefix) {
-        if(value.IsMap()) {
-            for(auto it = value.begin(); it != value.end(); ++it) {
-                auto key_name = it->first.as<std::string>();
-                YAML::Node const& val = it->second;
-                auto hier_name = prefix.size() ? prefix + "." + key_name : key_name;
-                if(!val.IsDefined() || val.IsSequence())
-                    return;
-                else if(val.IsMap())
-                    configure_cci_hierarchical(val, hier_name);
-                else if(val.IsScalar()) {
-                    auto& tag = val.Tag();
-                    if(tag == "!include") {
-                        yaml_config_reader sub_reader(broker);
-                        std::ifstream ifs(find_in_include_path(val.as<std::string>()));
-                        if(ifs.is_open()) {
-                            sub_reader.parse(ifs);
-                            if(sub_reader.valid) {
-                                sub_reader.configure_cci_hierarchical(sub_reader.document, hier_name);
-                            } else {
-                                std::ostringstream os;
-                                os << "Could not parse include file " << val.as<std::string>();
-                                throw std::runtime_error(os.str());
-                            }
-                        } else {
-                            std::ostringstream os;
-                            os << "Could not open include file " << val.as<std::string>();
-                            throw std::runtime_error(os.str());
-                        }
-                    } else if(tag.size() && tag[0] == '?') {
-                        auto param_handle = broker.get_param_handle(hier_name);
-                        if(param_handle.is_valid()) {
-                            auto param = param_handle.get_cci_value();
-                            if(param.is_bool()) {
-                                param.set_bool(val.as<bool>());
-                            } else if(param.is_int()) {
-                                param.set_int(val.as<int>());
-                            } else if(param.is_uint()) {
-                                param.set_uint(val.as<unsigned>());
-                            } else if(param.is_int64()) {
-                                param.set_int64(val.as<int64_t>());
-                            } else if(param.is_uint64()) {
-                                param.set_uint64(val.as<uint64_t>());
-                            } else if(param.is_double()) {
-                                param.set_double(val.as<double>());
-                            } else if(param.is_string()) {
-                                param.set_string(val.as<std::string>());
-                            }
-                        } else {
-                            if(auto res = YAML::as_if<bool, optional<bool>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<int, optional<int>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<int64_t, optional<int64_t>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<unsigned, optional<unsigned>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<uint64_t, optional<uint64_t>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<double, optional<double>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<std::string, optional<std::string>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-};
-/*************************************************************************************************
- * YAML config end
- ************************************************************************************************/
-#endif
 template <typename T>
 inline bool create_cci_param(sc_core::sc_attr_base* base_attr, const std::string& hier_name, configurer::cci_param_cln& params,
                              configurer::broker_t& broker, cci::cci_originator& cci_originator) {
@@ -659,47 +1131,62 @@ configurer::configurer(const std::string& filename, unsigned config_phases, sc_c
 configurer::~configurer() {}
 
 void configurer::read_input_file(const std::string& filename) {
+    auto* snapshot_dir = getenv("SCC_CONFIG_SNAPSHOT_DIR");
+    read_input_file(filename, snapshot_dir ? snapshot_dir : "");
+}
+
+void configurer::read_input_file(const std::string& filename, const std::string& snapshot_dir) {
     root->add_to_includes(util::dir_name(filename));
-    std::ifstream is(filename);
-    if(is.is_open()) {
+    input_file in;
+    if(!in.open(filename)) {
+        SCCWARN() << "Could not open input file " << filename;
+        return;
+    }
+    config_snapshot snapshot;
+    std::string snapshot_name;
+    if(snapshot_dir.size()) {
+        snapshot.add_input(filename, in.data(), in.size());
+        snapshot.add_context(absolute_path(filename));
+        for(auto const& incl : root->includes)
+            snapshot.add_context(absolute_path(incl));
+        snapshot_name = fmt::format("{}{}{}.{:016x}.cfgsnap", snapshot_dir, DIR_SEPARATOR, util::base_name(filename), snapshot.get_key());
+        auto apply = [this](std::string const& name, cci::cci_value const& value) { root->set_value(name, value); };
         try {
-            root->parse(is);
-            if(!root->valid) {
-                SCCERR() << "Could not parse input file " << filename << ", " << root->get_error_msg();
-            } else {
-                root->configure_cci();
+            if(config_snapshot::load(snapshot_name, snapshot.get_key(), apply)) {
+                SCCDEBUG("scc::configurer") << "Applied configuration snapshot " << snapshot_name << " for " << filename;
+                return;
             }
-        } catch(std::runtime_error& e) {
-            SCCERR() << "Could not parse input file " << filename << ", reason: " << e.what();
+        } catch(std::exception& e) {
+            // CCI reports conversion errors as sc_report, parsing the input file applies all values again
+            SCCWARN("scc::configurer") << "Could not apply configuration snapshot " << snapshot_name << ", reason: " << e.what();
         }
-    } else {
-        SCCWARN() << "Could not open input file " << filename;
+        root->snapshot = &snapshot;
     }
+    try {
+        if(!root->parse(in.data(), in.size()))
+            SCCERR() << "Could not parse input file " << filename << ", " << root->get_error_msg();
+        else if(snapshot_name.size() && !snapshot.write(snapshot_name))
+            SCCWARN("scc::configurer") << "Could not write configuration snapshot " << snapshot_name;
+    } catch(std::runtime_error& e) {
+        SCCERR() << "Could not parse input file " << filename << ", reason: " << e.what();
+    }
+    root->snapshot = nullptr;
 }
 
 void configurer::dump_configuration(std::ostream& os, bool as_yaml, bool with_description, sc_core::sc_object* obj) {
+    dump_configuration(os, dump_filter::ALL, as_yaml, with_description, obj);
+}
+
+void configurer::dump_configuration(std::ostream& os, dump_filter filter, bool as_yaml, bool with_description, sc_core::sc_object* obj) {
 #ifdef HAS_YAMPCPP
     if(as_yaml) {
-        YAML::Node root; // starts out as null
-        yaml_config_dumper dumper(cci_broker, with_description, stop_list);
-        if(obj)
-            for(auto* o : obj->get_child_objects()) {
-                dumper.dump_config(o, root);
-            }
-        else
-            dumper.dump_config(root);
-        os << root;
+        yaml_config_writer writer(os);
+        config_dumper<yaml_config_writer>(writer, cci_broker, with_description, stop_list, filter, last_dump).dump_config(obj);
         return;
     }
 #endif
-    OStreamWrapper stream(os);
-    writer_type writer(stream);
-    writer.StartObject();
-    json_config_dumper dumper(cci_broker, stop_list);
-    for(auto* o : get_sc_objects(obj)) {
-        dumper.dump_config(o, writer);
-    }
-    writer.EndObject();
+    json_config_writer writer(os);
+    config_dumper<json_config_writer>(writer, cci_broker, with_description, stop_list, filter, last_dump).dump_config(obj);
 }
 
 void configurer::configure() { mirror_sc_attributes(cci_broker, cci2sc_attr, cci_originator); }
@@ -768,7 +1255,7 @@ void configurer::start_of_simulation() {
         std::ofstream of{dump_file_name};
         if(of.is_open()) {
             mirror_sc_attributes(cci_broker, cci2sc_attr, cci_originator, nullptr, true);
-            dump_configuration(of, !as_json, with_description);
+            dump_configuration(of, dump_file_filter, !as_json, with_description);
         }
     }
 }
@@ -21,6 +21,7 @@
 #include "utilities.h"
 #include <cci_configuration>
 #include <regex>
+#include <unordered_map>
 
 /** \ingroup scc-sysc
  *  @{
@@ -46,6 +47,9 @@ public:
     using broker_t = cci::cci_broker_handle;
     using cci_param_cln = std::vector<std::pair<cci::cci_param_post_write_callback_untyped, std::unique_ptr<cci::cci_param_untyped>>>;
     enum { NEVER = 0, BEFORE_END_OF_ELABORATION = 1, END_OF_ELABORATION = 2, START_OF_SIMULATION = 4 };
+    //! selects the parameters being dumped: all, the ones differing from their default or the ones changed since the last
+    //! dump using CHANGED (the first one writes all parameters)
+    enum class dump_filter { ALL, NON_DEFAULT, CHANGED };
     /**
      * create a configurer using an input file
      * @param filename the input file to read containing the values to apply
@@ -65,7 +69,25 @@ public:
 
     configurer& operator=(configurer&&) = delete;
 
+    /**
+     * read a JSON (or YAML if yaml-cpp is available) input file. The file is memory mapped and parsed as stream, each
+     * value is stored in the CCI broker as soon as it is read.
+     *
+     * If the environment variable SCC_CONFIG_SNAPSHOT_DIR is set binary snapshots are used as described for
+     * read_input_file(std::string const&, std::string const&).
+     *
+     * @param filename the input file
+     */
     void read_input_file(std::string const& filename);
+    /**
+     * read an input file using a binary snapshot of its values. The snapshot is named after the file and the hash of
+     * its content. If a snapshot exists and none of the included files changed its values are applied without parsing
+     * the input, otherwise the input is read and the snapshot is written.
+     *
+     * @param filename the input file
+     * @param snapshot_dir the directory holding the snapshots, if empty no snapshot is used
+     */
+    void read_input_file(std::string const& filename, std::string const& snapshot_dir);
     /**
      * configure the design hierarchy using the input file. Apply the values to
      * sc_core::sc_attribute in th edsign hierarchy
@@ -79,17 +101,31 @@ public:
      */
     void dump_configuration(std::ostream& os = std::cout, bool as_yaml = true, bool with_description = false,
                             sc_core::sc_object* obj = nullptr);
+    /**
+     * dump a selection of the parameters of a design hierarchy to output stream immediately. The dump is written while
+     * walking the hierarchy without building a document in memory.
+     *
+     * @param os the output stream
+     * @param filter selects the parameters being written, objects without selected parameters are omitted
+     * @param as_yaml write YAML if yaml-cpp is available, JSON otherwise
+     * @param with_description add the descriptions of the parameters (YAML only)
+     * @param obj if not null specifies the root object of the dump
+     */
+    void dump_configuration(std::ostream& os, dump_filter filter, bool as_yaml = true, bool with_description = false,
+                            sc_core::sc_object* obj = nullptr);
     /**
      * schedule the dump the parameters of a design hierarchy to a file
      * during start_of_simulation()
      *
      * @param file_name the output stream, std::cout by default
+     * @param filter selects the parameters being written
      */
     void dump_configuration(std::string const& file_name, bool with_description = false,
-                            std::vector<std::string> stop_list = std::vector<std::string>{}) {
+                            std::vector<std::string> stop_list = std::vector<std::string>{}, dump_filter filter = dump_filter::ALL) {
         dump_file_name = file_name;
         this->with_description = with_description;
         this->stop_list = stop_list;
+        dump_file_filter = filter;
     }
     /**
      * set a value of some property (sc_attribute or cci_param) from programmatically
@@ -126,6 +162,9 @@ protected:
     std::string dump_file_name{""};
     bool with_description{false};
     std::vector<std::string> stop_list{};
+    dump_filter dump_file_filter{dump_filter::ALL};
+    // the hashes of the parameter values of the last dump using dump_filter::CHANGED
+    std::unordered_map<std::string, uint64_t> last_dump;
     configurer(std::string const& filename, unsigned sc_attr_config_phases, sc_core::sc_module_name nm);
     void config_check();
     void before_end_of_elaboration() override {
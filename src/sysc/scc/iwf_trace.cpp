@@ -0,0 +1,289 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "iwf_trace.hh"
+#include "report.h"
+#include "trace/types.hh"
+#include "utilities.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <util/iwf.h>
+#include <vector>
+
+namespace scc {
+namespace trace {
+using util::iwf::value_kind;
+
+struct iwf_trace {
+
+    iwf_trace(std::string const& nm, value_kind kind, unsigned bits)
+    : name{nm}
+    , bits{bits}
+    , kind{kind}
+    , mask{bits >= 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << bits) - 1} {}
+
+    virtual bool compare_and_update() = 0;
+
+    virtual void record(util::iwf::writer& w, uint64_t time) = 0;
+
+    virtual uintptr_t get_hash() = 0;
+
+    virtual ~iwf_trace(){};
+
+    const std::string name;
+    uint32_t id{0};
+    bool is_alias{false};
+    const unsigned bits{0};
+    const value_kind kind;
+    const uint64_t mask;
+};
+//! values are stored as uint64_t if they are 2-state and fit into 64 bits, 4-state or wider values are stored as bit string
+template <typename T> inline value_kind get_value_kind(unsigned bits) {
+    return traits<T>::get_type() == REAL ? value_kind::REAL : bits <= 64 ? value_kind::INT : value_kind::BITS;
+}
+template <> inline value_kind get_value_kind<sc_dt::sc_logic>(unsigned) { return value_kind::BITS; }
+template <> inline value_kind get_value_kind<sc_dt::sc_lv_base>(unsigned) { return value_kind::BITS; }
+
+template <typename T, typename OT = T> struct iwf_trace_t : public iwf_trace {
+    iwf_trace_t(const T& object_, const std::string& name)
+    : iwf_trace(name, get_value_kind<T>(traits<T>::get_bits(object_)), traits<T>::get_bits(object_))
+    , act_val(object_)
+    , old_val(object_) {}
+
+    uintptr_t get_hash() override { return reinterpret_cast<uintptr_t>(&act_val); }
+
+    bool compare_and_update() override {
+        if(old_val == act_val)
+            return false;
+        old_val = act_val;
+        return true;
+    }
+
+    void record(util::iwf::writer& w, uint64_t time) override;
+
+    const T& act_val;
+    OT old_val;
+};
+
+template <typename T> inline void record_bits(util::iwf::writer& w, uint32_t id, uint64_t time, T const& val) {
+    static std::vector<char> rawdata(1024);
+    if(rawdata.size() < static_cast<size_t>(val.length()))
+        rawdata.resize(val.length());
+    char* rawdata_ptr = &rawdata[0];
+    for(int bitindex = val.length() - 1; bitindex >= 0; --bitindex)
+        *rawdata_ptr++ = '0' + val[bitindex].value();
+    w.change(id, time, &rawdata[0]);
+}
+
+template <typename T, typename OT> inline void iwf_trace_t<T, OT>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, static_cast<uint64_t>(old_val) & mask);
+}
+template <> void iwf_trace_t<bool, bool>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, static_cast<uint64_t>(old_val));
+}
+template <> void iwf_trace_t<sc_dt::sc_bit, sc_dt::sc_bit>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, static_cast<uint64_t>(old_val.to_bool()));
+}
+template <> void iwf_trace_t<sc_dt::sc_logic, sc_dt::sc_logic>::record(util::iwf::writer& w, uint64_t time) {
+    char c = old_val.to_char();
+    w.change(id, time, &c);
+}
+template <> void iwf_trace_t<float, float>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, static_cast<double>(old_val));
+}
+template <> void iwf_trace_t<double, double>::record(util::iwf::writer& w, uint64_t time) { w.change(id, time, old_val); }
+template <> void iwf_trace_t<sc_dt::sc_int_base, sc_dt::sc_int_base>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, static_cast<uint64_t>(old_val.to_int64()) & mask);
+}
+template <> void iwf_trace_t<sc_dt::sc_uint_base, sc_dt::sc_uint_base>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, static_cast<uint64_t>(old_val.to_uint64()) & mask);
+}
+template <> void iwf_trace_t<sc_dt::sc_signed, sc_dt::sc_signed>::record(util::iwf::writer& w, uint64_t time) {
+    if(kind == value_kind::INT)
+        w.change(id, time, static_cast<uint64_t>(old_val.to_int64()) & mask);
+    else
+        record_bits(w, id, time, old_val);
+}
+template <> void iwf_trace_t<sc_dt::sc_unsigned, sc_dt::sc_unsigned>::record(util::iwf::writer& w, uint64_t time) {
+    if(kind == value_kind::INT)
+        w.change(id, time, static_cast<uint64_t>(old_val.to_uint64()) & mask);
+    else
+        record_bits(w, id, time, old_val);
+}
+template <> void iwf_trace_t<sc_dt::sc_fxval, sc_dt::sc_fxval>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, old_val.to_double());
+}
+template <> void iwf_trace_t<sc_dt::sc_fxval_fast, sc_dt::sc_fxval_fast>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, old_val.to_double());
+}
+template <> void iwf_trace_t<sc_dt::sc_fxnum, sc_dt::sc_fxval>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, old_val.to_double());
+}
+template <> void iwf_trace_t<sc_dt::sc_fxnum_fast, sc_dt::sc_fxval_fast>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, old_val.to_double());
+}
+template <> void iwf_trace_t<sc_dt::sc_bv_base, sc_dt::sc_bv_base>::record(util::iwf::writer& w, uint64_t time) {
+    if(kind == value_kind::INT)
+        w.change(id, time, static_cast<uint64_t>(old_val.to_uint64()) & mask);
+    else
+        w.change(id, time, old_val.to_string().c_str());
+}
+template <> void iwf_trace_t<sc_dt::sc_lv_base, sc_dt::sc_lv_base>::record(util::iwf::writer& w, uint64_t time) {
+    w.change(id, time, old_val.to_string().c_str());
+}
+} // namespace trace
+
+iwf_trace_file::iwf_trace_file(const char* name, std::function<bool()>& enable)
+: check_enabled(enable) {
+    std::string fname = std::string(name) + ".iwf";
+    try {
+        writer.reset(new util::iwf::writer(fname, 1000));
+    } catch(std::runtime_error& e) {
+        fprintf(stderr, "Could not open '%s', exiting.\n", fname.c_str());
+        exit(255);
+    }
+#if defined(WITH_SC_TRACING_PHASE_CALLBACKS)
+    // remove from hierarchy
+    sc_object::detach();
+    // register regular (non-delta) callbacks
+    sc_object::register_simulation_phase_callback(SC_BEFORE_TIMESTEP);
+#else // explicitly register with simcontext
+    sc_core::sc_get_curr_simcontext()->add_trace_file(this);
+#endif
+}
+
+iwf_trace_file::~iwf_trace_file() {
+    if(writer)
+        try {
+            writer->close();
+        } catch(std::exception& e) {
+            SCCERR("scc::iwf_trace_file") << "Could not close the IWF trace file: " << e.what();
+        }
+    for(auto t : all_traces)
+        delete t;
+}
+
+#define DECL_TRACE_METHOD_A(tp)                                                                                                            \
+    void iwf_trace_file::trace(const tp& object, const std::string& name) {                                                                \
+        all_traces.push_back(new trace::iwf_trace_t<tp>(object, name));                                                                    \
+    }
+#define DECL_TRACE_METHOD_B(tp)                                                                                                            \
+    void iwf_trace_file::trace(const tp& object, const std::string& name, int width) {                                                     \
+        all_traces.push_back(new trace::iwf_trace_t<tp>(object, name));                                                                    \
+    }
+#define DECL_TRACE_METHOD_C(tp, tpo)                                                                                                       \
+    void iwf_trace_file::trace(const tp& object, const std::string& name) {                                                                \
+        all_traces.push_back(new trace::iwf_trace_t<tp, tpo>(object, name));                                                               \
+    }
+
+#if(SYSTEMC_VERSION >= 20171012)
+void iwf_trace_file::trace(const sc_core::sc_event& object, const std::string& name) {}
+void iwf_trace_file::trace(const sc_core::sc_time& object, const std::string& name) {}
+#endif
+DECL_TRACE_METHOD_A(bool)
+DECL_TRACE_METHOD_A(sc_dt::sc_bit)
+DECL_TRACE_METHOD_A(sc_dt::sc_logic)
+
+DECL_TRACE_METHOD_B(unsigned char)
+DECL_TRACE_METHOD_B(unsigned short)
+DECL_TRACE_METHOD_B(unsigned int)
+DECL_TRACE_METHOD_B(unsigned long)
+#ifdef SYSTEMC_64BIT_PATCHES
+DECL_TRACE_METHOD_B(unsigned long long)
+#endif
+DECL_TRACE_METHOD_B(char)
+DECL_TRACE_METHOD_B(short)
+DECL_TRACE_METHOD_B(int)
+DECL_TRACE_METHOD_B(long)
+DECL_TRACE_METHOD_B(sc_dt::int64)
+DECL_TRACE_METHOD_B(sc_dt::uint64)
+
+DECL_TRACE_METHOD_A(float)
+DECL_TRACE_METHOD_A(double)
+DECL_TRACE_METHOD_A(sc_dt::sc_int_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_uint_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_signed)
+DECL_TRACE_METHOD_A(sc_dt::sc_unsigned)
+
+DECL_TRACE_METHOD_A(sc_dt::sc_fxval)
+DECL_TRACE_METHOD_A(sc_dt::sc_fxval_fast)
+DECL_TRACE_METHOD_C(sc_dt::sc_fxnum, sc_dt::sc_fxval)
+DECL_TRACE_METHOD_C(sc_dt::sc_fxnum_fast, sc_dt::sc_fxval_fast)
+
+DECL_TRACE_METHOD_A(sc_dt::sc_bv_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_lv_base)
+#undef DECL_TRACE_METHOD_A
+#undef DECL_TRACE_METHOD_B
+#undef DECL_TRACE_METHOD_C
+
+void iwf_trace_file::trace(const unsigned int& object, const std::string& name, const char** enum_literals) {
+    all_traces.push_back(new trace::iwf_trace_t<unsigned int>(object, name));
+}
+
+void iwf_trace_file::write_comment(const std::string& comment) {}
+
+void iwf_trace_file::init() {
+    std::sort(std::begin(all_traces), std::end(all_traces),
+              [](trace::iwf_trace const* a, trace::iwf_trace const* b) -> bool { return a->name < b->name; });
+    std::unordered_map<uintptr_t, uint32_t> alias_map;
+    for(auto* t : all_traces) {
+        auto alias_it = alias_map.find(t->get_hash());
+        t->is_alias = alias_it != std::end(alias_map);
+        if(t->is_alias)
+            t->id = writer->add_alias(t->name, alias_it->second);
+        else {
+            t->id = writer->add_signal(t->name, t->kind, t->bits);
+            alias_map.insert({t->get_hash(), t->id});
+            pull_traces.push_back(t);
+        }
+    }
+}
+
+void iwf_trace_file::cycle(bool delta_cycle) {
+    if(delta_cycle)
+        return;
+    uint64_t time_stamp = sc_core::sc_time_stamp().value() / (1_ps).value();
+    if(last_emitted_ts == std::numeric_limits<uint64_t>::max()) {
+        init();
+        for(auto t : pull_traces) {
+            t->compare_and_update();
+            t->record(*writer, time_stamp);
+        }
+        last_emitted_ts = time_stamp;
+    } else {
+        if(check_enabled && !check_enabled())
+            return;
+        for(auto t : pull_traces)
+            if(t->compare_and_update())
+                t->record(*writer, time_stamp);
+        last_emitted_ts = time_stamp;
+    }
+}
+
+void iwf_trace_file::set_time_unit(double v, sc_core::sc_time_unit tu) {}
+#ifdef NCSC
+void iwf_trace_file::set_time_unit(int exponent10_seconds) {}
+#endif
+
+sc_core::sc_trace_file* create_iwf_trace_file(const char* name, std::function<bool()> enable) { return new iwf_trace_file(name, enable); }
+
+void close_iwf_trace_file(sc_core::sc_trace_file* tf) { delete static_cast<iwf_trace_file*>(tf); }
+
+} // namespace scc
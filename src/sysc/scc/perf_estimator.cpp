@@ -16,6 +16,16 @@
 
 #include "perf_estimator.h"
 #include "report.h"
+#include <util/ities.h>
+#include <util/pool_allocator.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #if defined(_WIN32)
 #include <Windows.h>
@@ -33,6 +43,131 @@
 
 namespace scc {
 using namespace sc_core;
+/*
+ * the sampling profiler. The sampling thread only reads the pointer to the running process and the number of delta
+ * cycles at the current time from the kernel, the names are resolved in the simulation thread once sampling stopped.
+ * SystemC offers no way to publish this state to other threads, so the kernel is read without synchronization: this
+ * is a data race in terms of the C++ memory model which is tolerated as the profile is statistical. On the supported
+ * platforms the word sized reads do not tear but a sample may combine the process and delta count of adjacent
+ * evaluations. As processes are identified by their address, a process created during simulation which reuses the
+ * memory of a terminated one is accounted to the name of the terminated one (or to '<terminated process>').
+ */
+struct perf_estimator::profiler {
+    enum phase { TIMED, DELTA, KERNEL };
+    std::string folded_file_name;
+    std::chrono::microseconds sample_period;
+    unsigned report_rows;
+    std::thread sampler;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stop{false};
+    // the number of samples per process and phase, the key is the process pointer or'ed with the phase
+    std::unordered_map<uintptr_t, uint64_t> samples;
+    uint64_t total{0};
+    // the names of the processes known at start of simulation
+    std::unordered_map<sc_process_b const*, std::string> names;
+
+    profiler(std::string const& folded_file_name, std::chrono::microseconds sample_period, unsigned report_rows)
+    : folded_file_name(folded_file_name)
+    , sample_period(sample_period)
+    , report_rows(report_rows) {}
+
+    ~profiler() { stop_sampling(); }
+
+    void start() {
+        collect_names(sc_get_top_level_objects());
+        sampler = std::thread([this]() {
+            std::unique_lock<std::mutex> lock(mtx);
+            while(!cv.wait_for(lock, sample_period, [this]() { return stop; }))
+                sample();
+        });
+    }
+
+    void stop_sampling() {
+        if(sampler.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stop = true;
+            }
+            cv.notify_all();
+            sampler.join();
+        }
+    }
+
+    void sample() {
+        auto* ctx = sc_get_curr_simcontext();
+        if(ctx->get_status() != SC_RUNNING)
+            return;
+        // the first evaluation at a time is triggered by timed notifications, all later ones are delta cycles
+        auto timed = sc_delta_count_at_current_time() == 0;
+        auto* proc = ctx->get_curr_proc_info()->process_handle;
+        auto ph = proc ? (timed ? TIMED : DELTA) : KERNEL;
+        ++samples[reinterpret_cast<uintptr_t>(proc) | ph];
+        ++total;
+    }
+
+    void collect_names(std::vector<sc_object*> const& objs) {
+        for(auto* obj : objs) {
+            if(auto* proc = dynamic_cast<sc_process_b const*>(obj))
+                names.emplace(proc, obj->name());
+            collect_names(obj->get_child_objects());
+        }
+    }
+
+    void report(bool resolve_new_processes) {
+        stop_sampling();
+        if(!total)
+            return;
+        if(resolve_new_processes)
+            collect_names(sc_get_top_level_objects());
+        struct row {
+            std::string name;
+            uint64_t count[3]{0, 0, 0};
+        };
+        std::unordered_map<uintptr_t, row> rows;
+        for(auto const& e : samples) {
+            auto ptr = e.first & ~uintptr_t(3);
+            auto& r = rows[ptr];
+            if(r.name.empty()) {
+                auto it = names.find(reinterpret_cast<sc_process_b const*>(ptr));
+                r.name = ptr ? it != names.end() ? it->second : "<terminated process>" : "<kernel>";
+            }
+            r.count[e.first & 3] += e.second;
+        }
+        std::vector<row const*> sorted;
+        for(auto const& e : rows)
+            sorted.push_back(&e.second);
+        auto sum = [](row const* r) { return r->count[TIMED] + r->count[DELTA] + r->count[KERNEL]; };
+        std::sort(sorted.begin(), sorted.end(), [&sum](row const* a, row const* b) { return sum(a) > sum(b); });
+        auto pct = [this](uint64_t n) { return 100.0 * n / total; };
+        SCCINFO("perf_estimator") << "profile of " << total << " samples (" << sample_period.count() << "us period):";
+        SCCINFO("perf_estimator") << "   total    timed    delta  process";
+        for(size_t i = 0; i < sorted.size() && i < report_rows; ++i) {
+            auto const& r = *sorted[i];
+            SCCINFO("perf_estimator") << fmt::format("{:7.2f}% {:7.2f}% {:7.2f}%  {}", pct(sum(&r)), pct(r.count[TIMED]),
+                                                     pct(r.count[DELTA]), r.name);
+        }
+        if(folded_file_name.size()) {
+            std::ofstream os(folded_file_name);
+            if(!os.is_open()) {
+                SCCWARN("perf_estimator") << "Could not open profile output file " << folded_file_name;
+                return;
+            }
+            static char const* phase_names[] = {"timed", "delta", "kernel"};
+            for(auto const& e : rows)
+                for(auto ph : {TIMED, DELTA, KERNEL})
+                    if(e.second.count[ph]) {
+                        os << phase_names[ph];
+                        if(e.first) {
+                            os << ';';
+                            for(auto c : e.second.name)
+                                os << (c == '.' ? ';' : c == ' ' ? '_' : c);
+                        }
+                        os << ' ' << e.second.count[ph] << '\n';
+                    }
+        }
+    }
+};
 
 SC_HAS_PROCESS(perf_estimator);
 
@@ -46,6 +181,9 @@ perf_estimator::perf_estimator(const sc_module_name& nm, sc_time beat_delay_)
 }
 
 perf_estimator::~perf_estimator() {
+    // the simulation did not end with sc_stop(), processes created during simulation may be gone already
+    if(prof)
+        prof->report(false);
     time_stamp eod;
     eod.set();
     SCCINFO("perf_estimator") << "constr & elab time:  " << (eoe.proc_clock_stamp - soc.proc_clock_stamp) << "s";
@@ -61,9 +199,15 @@ perf_estimator::~perf_estimator() {
 
 void perf_estimator::end_of_elaboration() { eoe.set(); }
 
+void perf_estimator::enable_profiling(std::string const& folded_file_name, std::chrono::microseconds sample_period, unsigned report_rows) {
+    prof.reset(new profiler(folded_file_name, sample_period, report_rows));
+}
+
 void perf_estimator::start_of_simulation() {
     sos.set();
     get_memory();
+    if(prof)
+        prof->start();
 }
 
 void perf_estimator::end_of_simulation() {
@@ -79,15 +223,70 @@ void perf_estimator::end_of_simulation() {
                                   << ")";
     }
     get_memory();
+    if(prof) {
+        prof->report(true);
+        prof.reset();
+    }
 }
 
 void perf_estimator::beat() {
-    if(sc_time_stamp().value())
+    if(sc_time_stamp().value()) {
         SCCINFO("perf_estimator") << "Heart beat, rss mem: " << get_memory() << "kB";
+        if(beat_log)
+            write_beat_sample();
+    }
     next_trigger(beat_delay);
 #if !defined(WIN32) and !defined(__APPLE__)
-    malloc_trim(0);
+    if(trim_interval && ++beat_count >= trim_interval) {
+        malloc_trim(0);
+        beat_count = 0;
+    }
+#endif
+}
+
+void perf_estimator::set_heart_beat_log(std::string const& file_name) {
+    beat_log.reset(new std::ofstream(file_name));
+    if(!beat_log->is_open()) {
+        SCCWARN("perf_estimator") << "Could not open heart beat log " << file_name;
+        beat_log.reset();
+        return;
+    }
+    beat_log_csv = util::ends_with(file_name, ".csv");
+    if(beat_log_csv)
+        *beat_log << "sim_time_s,wall_time_s,sim_delta_s,wall_delta_s,cpu_delta_s,delta_cycles,max_rss_kB,heap_used_B,heap_free_B,"
+                     "pool_capacity_B,pool_used_B\n";
+}
+
+void perf_estimator::write_beat_sample() {
+    time_stamp now;
+    auto sim_time = sc_time_stamp();
+    auto delta_cycles = sc_delta_count();
+    // the first sample refers to the start of simulation
+    auto& prev = last_beat_time.value() ? last_beat : sos;
+    auto wall = (now.wall_clock_stamp - sos.wall_clock_stamp).total_microseconds() / 1e6;
+    auto wall_delta = (now.wall_clock_stamp - prev.wall_clock_stamp).total_microseconds() / 1e6;
+    auto cpu_delta = now.proc_clock_stamp - prev.proc_clock_stamp;
+    size_t heap_used = 0, heap_free = 0;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    auto mi = mallinfo2();
+    heap_used = mi.uordblks + mi.hblkhd;
+    heap_free = mi.fordblks;
 #endif
+    auto pools = util::get_pool_usage();
+    auto sim_delta = (sim_time - last_beat_time).to_seconds();
+    if(beat_log_csv)
+        *beat_log << fmt::format("{},{},{},{},{},{},{},{},{},{},{}\n", sim_time.to_seconds(), wall, sim_delta, wall_delta, cpu_delta,
+                                 delta_cycles - last_beat_delta, max_memory, heap_used, heap_free, pools.capacity, pools.used);
+    else
+        *beat_log << fmt::format("{{\"sim_time_s\":{},\"wall_time_s\":{},\"sim_delta_s\":{},\"wall_delta_s\":{},\"cpu_delta_s\":{},"
+                                 "\"delta_cycles\":{},\"max_rss_kB\":{},\"heap_used_B\":{},\"heap_free_B\":{},\"pool_capacity_B\":{},"
+                                 "\"pool_used_B\":{}}}\n",
+                                 sim_time.to_seconds(), wall, sim_delta, wall_delta, cpu_delta, delta_cycles - last_beat_delta, max_memory,
+                                 heap_used, heap_free, pools.capacity, pools.used);
+    beat_log->flush();
+    last_beat = now;
+    last_beat_time = sim_time;
+    last_beat_delta = delta_cycles;
 }
 } /* namespace scc */
 
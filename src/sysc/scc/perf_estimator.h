@@ -18,6 +18,10 @@
 #define _SCC_PERFORMANCETRACER_H_
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
 #include <systemc>
 #include <tuple>
 
@@ -35,6 +39,11 @@ namespace scc {
  * some performance figures. Optionally it provides a heart beat which periodically calls a functor
  * If a cycle time is provides it calculates also the cycles per (wall clock) second
  *
+ * The performance figures of each heart beat can be written to a file to follow long running simulations (see
+ * set_heart_beat_log()).
+ *
+ * Optionally a sampling profiler attributes the wall clock time of the simulation to the SystemC processes (see
+ * enable_profiling()).
  */
 class perf_estimator : public sc_core::sc_module {
     //! some internal data structure to record a time stamp
@@ -87,6 +96,43 @@ public:
      * @param cycle_period
      */
     void set_cycle_time(sc_core::sc_time cycle_period) { this->cycle_period = cycle_period; };
+    /**
+     * @fn void set_heart_beat_log(std::string const&)
+     * @brief writes a sample of the performance figures at each heart beat to a file
+     *
+     * A sample contains the simulation and wall clock time, the simulation time, wall clock time, process time and
+     * delta cycles since the previous beat, the maximum resident memory, the heap usage (glibc only) and the memory
+     * held by the util::pool_allocator instances of the simulation thread. If the file name ends with '.csv' the
+     * samples are written as comma separated values, otherwise as one JSON object per line.
+     *
+     * @param file_name the name of the output file
+     */
+    void set_heart_beat_log(std::string const& file_name);
+    /**
+     * @fn void set_malloc_trim_interval(unsigned)
+     * @brief sets how often free heap memory is returned to the OS using malloc_trim() at a heart beat
+     *
+     * @param beats the number of heart beats between two trims, 0 disables trimming. The default is 1.
+     */
+    void set_malloc_trim_interval(unsigned beats) { trim_interval = beats; }
+    /**
+     * @fn void enable_profiling(std::string const&, std::chrono::microseconds, unsigned)
+     * @brief enables the sampling profiler, needs to be called before the simulation starts
+     *
+     * While the simulation runs a background thread periodically samples the running SystemC process and whether the
+     * kernel evaluates the first delta cycle of a time step (timed) or a following one (delta). Samples taken while
+     * no process runs are attributed to the kernel. At the end of the simulation the processes are reported sorted
+     * by their share of the samples. The profiler neither stops nor synchronizes with the simulation thread, it reads
+     * the kernel state racily. Hence a sample may be attributed to a process which has just been left, and a process
+     * created during simulation may be reported under the name of a terminated process whose memory it reuses.
+     *
+     * @param folded_file_name if not empty the samples are written to this file in the folded stack format used by
+     * flamegraph.pl, the frames being the phase and the hierarchy levels of the process name
+     * @param sample_period the sampling period
+     * @param report_rows the number of processes being reported
+     */
+    void enable_profiling(std::string const& folded_file_name = "",
+                          std::chrono::microseconds sample_period = std::chrono::microseconds(1000), unsigned report_rows = 20);
 
 protected:
     perf_estimator(const sc_core::sc_module_name& nm, sc_core::sc_time heart_beat);
@@ -101,8 +147,18 @@ protected:
     time_stamp eos;
     sc_core::sc_time beat_delay, cycle_period;
     void beat();
+    void write_beat_sample();
     long get_memory();
     long max_memory{0};
+    unsigned trim_interval{1};
+    unsigned beat_count{0};
+    std::unique_ptr<std::ofstream> beat_log;
+    bool beat_log_csv{false};
+    time_stamp last_beat;
+    sc_core::sc_time last_beat_time;
+    uint64_t last_beat_delta{0};
+    struct profiler;
+    std::unique_ptr<profiler> prof;
 };
 
 } /* namespace scc */
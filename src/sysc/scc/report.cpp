@@ -22,9 +22,14 @@
 
 #include "report.h"
 #include "configurer.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <deque>
+#include <fmt/format.h>
 #include <fstream>
+#include <iterator>
 #include <mutex>
 #include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -33,6 +38,8 @@
 #include <thread>
 #include <tuple>
 #include <unordered_map>
+#include <util/glob_trie.h>
+#include <util/ities.h>
 #ifdef __GNUC__
 #define GCC_VERSION (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 + __GNUC_PATCHLEVEL__)
 #if GCC_VERSION < 40900
@@ -76,7 +83,8 @@ struct char_hash {
 };
 thread_local struct {
     std::unordered_map<char const*, sc_core::sc_verbosity, char_hash, char_equal_to> table;
-    std::vector<std::string> cache;
+    // a deque keeps the strings in place so the keys stay valid
+    std::deque<std::string> cache;
     void insert(char const* key, sc_core::sc_verbosity verb) {
         cache.push_back(key);
         table.insert({cache.back().c_str(), verb});
@@ -86,6 +94,22 @@ thread_local struct {
         cache.clear();
     }
 } lut;
+// the log filter result per message type, it is invalidated when the filter generation changes
+std::atomic<unsigned> filter_generation{0};
+thread_local struct {
+    std::unordered_map<char const*, bool, char_hash, char_equal_to> table;
+    // a deque keeps the strings in place so the keys stay valid
+    std::deque<std::string> cache;
+    unsigned generation{0};
+    void insert(char const* key, bool res) {
+        cache.push_back(key);
+        table.insert({cache.back().c_str(), res});
+    }
+    void clear() {
+        table.clear();
+        cache.clear();
+    }
+} filter_lut;
 #ifdef MTI_SYSTEMC
 static const cci::cci_originator originator;
 #else
@@ -97,6 +121,55 @@ bool& inst_based_logging() {
     return active;
 }
 
+struct {
+    std::mutex mtx;
+    std::vector<scc::log_verbosity_handle*> handles;
+    bool cci_hooked{false};
+} log_handles;
+
+bool is_log_level_param(std::string const& name) {
+    constexpr size_t len = sizeof(SCC_LOG_LEVEL_PARAM_NAME) - 1;
+    return name.length() >= len && name.compare(name.length() - len, len, SCC_LOG_LEVEL_PARAM_NAME) == 0 &&
+           (name.length() == len || name[name.length() - len - 1] == '.');
+}
+
+// updates the cached levels and the handles of the scope of a log_level parameter and of all scopes below it
+void update_scope_verbosity_handles(std::string const& param_name) {
+    constexpr size_t len = sizeof(SCC_LOG_LEVEL_PARAM_NAME) - 1;
+    auto scope_len = param_name.length() > len ? param_name.length() - len - 1 : 0;
+    auto in_scope = [&param_name, scope_len](char const* name) {
+        return !scope_len || (!strncmp(name, param_name.c_str(), scope_len) && (name[scope_len] == 0 || name[scope_len] == '.'));
+    };
+    for(auto it = lut.table.begin(); it != lut.table.end();)
+        it = in_scope(it->first) ? lut.table.erase(it) : std::next(it);
+    std::lock_guard<std::mutex> lock(log_handles.mtx);
+    for(auto* h : log_handles.handles)
+        if(in_scope(h->name()))
+            h->update();
+}
+// returns true if h is a log_level parameter and has been hooked
+bool hook_log_level_param(cci::cci_param_untyped_handle h) {
+    if(!is_log_level_param(h.name()))
+        return false;
+    auto name = h.name();
+    h.register_post_write_callback(
+        cci::cci_param_post_write_callback_untyped([name](const cci::cci_param_write_event<>&) { update_scope_verbosity_handles(name); }));
+    return true;
+}
+// the log_level parameters being written change the verbosity of their scope and all scopes below
+void hook_log_level_params() {
+    if(log_handles.cci_hooked || !inst_based_logging())
+        return;
+    log_handles.cci_hooked = true;
+    auto broker = sc_core::sc_get_current_object() ? cci::cci_get_broker() : cci::cci_get_global_broker(originator);
+    for(auto& h : broker.get_param_handles())
+        hook_log_level_param(h);
+    broker.register_create_callback(cci::cci_param_create_callback([](const cci::cci_param_untyped_handle& h) {
+        if(hook_log_level_param(h))
+            update_scope_verbosity_handles(h.name());
+    }));
+}
+
 struct ExtLogConfig : public scc::LogConfig {
     shared_ptr<spdlog::logger> file_logger;
     shared_ptr<spdlog::logger> console_logger;
@@ -105,17 +178,52 @@ struct ExtLogConfig : public scc::LogConfig {
 #else
     regex reg_ex;
 #endif
+    unique_ptr<util::glob_trie<bool>> glob_filter;
     sc_time cycle_base{0, SC_NS};
     auto operator=(const scc::LogConfig& o) -> ExtLogConfig& {
         scc::LogConfig::operator=(o);
         return *this;
     }
+    auto has_filter() const -> bool { return log_filter_regex.size() || log_filter_glob.size(); }
+    // sets up the filters from the configuration
+    void compile_filter() {
+        ++filter_generation;
+        if(log_filter_regex.size()) {
+#ifdef USE_C_REGEX
+            regcomp(&start_state, log_filter_regex.c_str(), REG_EXTENDED);
+#else
+            reg_ex = regex(log_filter_regex, regex::extended | regex::icase);
+#endif
+        }
+        glob_filter.reset();
+        if(log_filter_glob.size()) {
+            glob_filter.reset(new util::glob_trie<bool>());
+            for(auto pattern : util::split(log_filter_glob, ','))
+                if(util::trim(pattern).size())
+                    glob_filter->insert(pattern, true);
+        }
+    }
+    // a message type passes if it matches the regular expression or one of the glob patterns, each type is matched
+    // only once per thread
     auto match(const char* type) -> bool {
+        if(filter_lut.generation != filter_generation) {
+            filter_lut.clear();
+            filter_lut.generation = filter_generation;
+        }
+        auto it = filter_lut.table.find(type);
+        if(it != filter_lut.table.end())
+            return it->second;
+        auto res = false;
+        if(log_filter_regex.size())
 #ifdef USE_C_REGEX
-        return regexec(&start_state, type, 0, nullptr, 0) == 0;
+            res = regexec(&start_state, type, 0, nullptr, 0) == 0;
 #else
-        return regex_search(type, reg_ex);
+            res = regex_search(type, reg_ex);
 #endif
+        if(!res && glob_filter)
+            res = glob_filter->find(type) != nullptr;
+        filter_lut.insert(type, res);
+        return res;
     }
     bool initialized{false};
 };
@@ -143,13 +251,12 @@ auto get_tuple(const sc_time& t) -> tuple<sc_time::value_type, sc_time_unit> {
     return make_tuple(val, static_cast<sc_time_unit>(tu));
 }
 
-auto time2string(const sc_time& t) -> string {
+void format_time(fmt::memory_buffer& buf, const sc_time& t) {
     const array<const char*, 6> time_units{"fs", "ps", "ns", "us", "ms", "s "};
     const array<uint64_t, 6> multiplier{
         1ULL, 1000ULL, 1000ULL * 1000, 1000ULL * 1000 * 1000, 1000ULL * 1000 * 1000 * 1000, 1000ULL * 1000 * 1000 * 1000 * 1000};
-    ostringstream oss;
     if(!t.value()) {
-        oss << "0 s ";
+        fmt::format_to(std::back_inserter(buf), "0 s ");
     } else {
         const auto tt = get_tuple(t);
         const auto val = get<0>(tt);
@@ -159,56 +266,62 @@ auto time2string(const sc_time& t) -> string {
             if(fs_val >= multiplier[j]) {
                 const auto i = val / multiplier[j - scale];
                 const auto f = val % multiplier[j - scale];
-                oss << i << '.' << setw(3 * (j - scale)) << setfill('0') << right << f << ' ' << time_units[j];
+                fmt::format_to(std::back_inserter(buf), "{}.{:0{}} {}", i, f, 3 * (j - scale), time_units[j]);
                 break;
             }
         }
     }
-    return oss.str();
 }
-auto compose_message(const sc_report& rep, const scc::LogConfig& cfg) -> const string {
-    if(rep.get_severity() > SC_INFO || cfg.log_filter_regex.length() == 0 || rep.get_verbosity() == sc_core::SC_MEDIUM ||
+
+auto time2string(const sc_time& t) -> string {
+    fmt::memory_buffer buf;
+    format_time(buf, t);
+    return fmt::to_string(buf);
+}
+// formats the message into buf, returns false if the message is filtered
+auto compose_message(const sc_report& rep, const scc::LogConfig& cfg, fmt::memory_buffer& buf) -> bool {
+    if(rep.get_severity() > SC_INFO || !log_cfg.has_filter() || rep.get_verbosity() == sc_core::SC_MEDIUM ||
        log_cfg.match(rep.get_msg_type())) {
-        stringstream os;
+        auto out = std::back_inserter(buf);
         if(likely(cfg.print_sim_time)) {
             if(unlikely(log_cfg.cycle_base.value())) {
                 if(unlikely(cfg.print_delta))
-                    os << "[" << std::setw(7) << std::setfill(' ') << sc_time_stamp().value() / log_cfg.cycle_base.value() << "(" << setw(5)
-                       << sc_delta_count() << ")]";
+                    fmt::format_to(out, "[{:>7}({:>5})]", sc_time_stamp().value() / log_cfg.cycle_base.value(), sc_delta_count());
                 else
-                    os << "[" << std::setw(7) << std::setfill(' ') << sc_time_stamp().value() / log_cfg.cycle_base.value() << "]";
+                    fmt::format_to(out, "[{:>7}]", sc_time_stamp().value() / log_cfg.cycle_base.value());
             } else {
-                auto t = time2string(sc_time_stamp());
+                thread_local fmt::memory_buffer tbuf;
+                tbuf.clear();
+                format_time(tbuf, sc_time_stamp());
                 if(unlikely(cfg.print_delta))
-                    os << "[" << std::setw(20) << std::setfill(' ') << t << "(" << setw(5) << sc_delta_count() << ")]";
+                    fmt::format_to(out, "[{:>20}({:>5})]", fmt::string_view(tbuf.data(), tbuf.size()), sc_delta_count());
                 else
-                    os << "[" << std::setw(20) << std::setfill(' ') << t << "]";
+                    fmt::format_to(out, "[{:>20}]", fmt::string_view(tbuf.data(), tbuf.size()));
             }
         }
         if(unlikely(rep.get_id() >= 0))
-            os << "("
-               << "IWEF"[rep.get_severity()] << rep.get_id() << ") " << rep.get_msg_type() << ": ";
+            fmt::format_to(out, "({}{}) {}: ", "IWEF"[rep.get_severity()], rep.get_id(), rep.get_msg_type());
         else if(cfg.msg_type_field_width) {
             if(cfg.msg_type_field_width == std::numeric_limits<unsigned>::max())
-                os << rep.get_msg_type() << ": ";
+                fmt::format_to(out, "{}: ", rep.get_msg_type());
             else
-                os << util::padded(rep.get_msg_type(), cfg.msg_type_field_width) << ": ";
+                fmt::format_to(out, "{}: ", util::padded(rep.get_msg_type(), cfg.msg_type_field_width));
         }
         if(*rep.get_msg())
-            os << rep.get_msg();
+            fmt::format_to(out, "{}", rep.get_msg());
         if(rep.get_severity() > SC_INFO) {
             if(rep.get_line_number())
-                os << "\n         [FILE:" << rep.get_file_name() << ":" << rep.get_line_number() << "]";
+                fmt::format_to(out, "\n         [FILE:{}:{}]", rep.get_file_name(), rep.get_line_number());
             sc_simcontext* simc = sc_get_curr_simcontext();
             if(simc && sc_is_running()) {
                 const char* proc_name = rep.get_process_name();
                 if(proc_name)
-                    os << "\n         [PROCESS:" << proc_name << "]";
+                    fmt::format_to(out, "\n         [PROCESS:{}]", proc_name);
             }
         }
-        return os.str();
+        return true;
     } else
-        return "";
+        return false;
 }
 
 inline auto get_verbosity(const sc_report& rep) -> int {
@@ -216,9 +329,12 @@ inline auto get_verbosity(const sc_report& rep) -> int {
 }
 
 inline void log2logger(spdlog::logger& logger, const sc_report& rep, const scc::LogConfig& cfg) {
-    auto msg = compose_message(rep, cfg);
-    if(!msg.size())
+    // the message buffer is reused to avoid allocations, spdlog copies the message also when logging asynchronously
+    thread_local fmt::memory_buffer buf;
+    buf.clear();
+    if(!compose_message(rep, cfg, buf) || !buf.size())
         return;
+    auto msg = spdlog::string_view_t(buf.data(), buf.size());
     switch(rep.get_severity()) {
     case SC_INFO:
         switch(get_verbosity(rep)) {
@@ -413,14 +529,10 @@ static void configure_logging() {
             if(log_cfg.log_file_name.size())
                 log_cfg.file_logger = spdlog::get("file_logger");
         }
-        if(log_cfg.log_filter_regex.size()) {
-#ifdef USE_C_REGEX
-            regcomp(&log_cfg.start_state, log_cfg.log_filter_regex.c_str(), REG_EXTENDED);
-#else
-            log_cfg.reg_ex = regex(log_cfg.log_filter_regex, regex::extended | regex::icase);
-#endif
-        }
+        log_cfg.compile_filter();
     }
+    if(log_cfg.binary_log_file_name.size() && !scc::binary_logger::start(log_cfg.binary_log_file_name))
+        SCCWARN("SystemC") << "could not open binary log file " << log_cfg.binary_log_file_name;
 }
 
 void scc::reinit_logging() { reinit_logging(log_cfg.level); }
@@ -429,9 +541,9 @@ void scc::reinit_logging(scc::log level) {
     if(log_cfg.install_handler)
         sc_report_handler::set_handler(report_handler);
     log_cfg.level = level;
-    lut.clear();
     if(!log_cfg.instance_based_log_levels || getenv("SCC_DISABLE_INSTANCE_BASED_LOGGING"))
         inst_based_logging() = false;
+    update_log_verbosity_handles();
     log_cfg.initialized = true;
 }
 
@@ -442,12 +554,14 @@ void scc::init_logging(scc::log level, unsigned type_field_width, bool print_tim
     log_cfg.print_sys_time = print_time;
     log_cfg.level = level;
     configure_logging();
+    update_log_verbosity_handles();
     log_cfg.initialized = true;
 }
 
 void scc::init_logging(const scc::LogConfig& log_config) {
     log_cfg = log_config;
     configure_logging();
+    update_log_verbosity_handles();
     log_cfg.initialized = true;
 }
 
@@ -456,6 +570,7 @@ void scc::set_logging_level(scc::log level) {
     sc_report_handler::set_verbosity_level(verbosity[static_cast<unsigned>(level)]);
     log_cfg.console_logger->set_level(
         static_cast<spdlog::level::level_enum>(SPDLOG_LEVEL_OFF - min<int>(SPDLOG_LEVEL_OFF, static_cast<int>(log_cfg.level))));
+    update_log_verbosity_handles();
     log_cfg.initialized = true;
 }
 
@@ -518,6 +633,11 @@ auto scc::LogConfig::logFilterRegex(const string& expr) -> scc::LogConfig& {
     return *this;
 }
 
+auto scc::LogConfig::logFilterGlob(const string& patterns) -> scc::LogConfig& {
+    this->log_filter_glob = patterns;
+    return *this;
+}
+
 auto scc::LogConfig::logAsync(bool v) -> scc::LogConfig& {
     this->log_async = v;
     return *this;
@@ -540,6 +660,61 @@ auto scc::LogConfig::installHandler(bool v) -> scc::LogConfig& {
     this->install_handler = v;
     return *this;
 }
+auto scc::LogConfig::binaryLogFileName(const string& name) -> scc::LogConfig& {
+    this->binary_log_file_name = name;
+    return *this;
+}
+
+void scc::log_formatted_v(sc_severity severity, char const* type, int verbosity, char const* file, int line, fmt::string_view format,
+                          fmt::format_args args) {
+    thread_local fmt::memory_buffer buf;
+    thread_local bool busy{false};
+    auto report = [=](fmt::memory_buffer& b) {
+        b.clear();
+        fmt::vformat_to(std::back_inserter(b), format, args);
+        b.push_back('\0');
+        sc_report_handler::report(severity, type, b.data(), verbosity, file, line);
+    };
+    if(busy) {
+        // a message being logged while formatting the arguments of another one
+        fmt::memory_buffer nested;
+        report(nested);
+        return;
+    }
+    struct guard {
+        guard() { busy = true; }
+        ~guard() { busy = false; }
+    } g;
+    report(buf);
+}
+
+scc::log_verbosity_handle::log_verbosity_handle(char const* scope)
+: scope(scope)
+, verbosity(get_log_verbosity(scope)) {
+    {
+        std::lock_guard<std::mutex> lock(log_handles.mtx);
+        log_handles.handles.push_back(this);
+    }
+    hook_log_level_params();
+}
+
+scc::log_verbosity_handle::~log_verbosity_handle() {
+    std::lock_guard<std::mutex> lock(log_handles.mtx);
+    auto it = std::find(log_handles.handles.begin(), log_handles.handles.end(), this);
+    if(it != log_handles.handles.end()) {
+        *it = log_handles.handles.back();
+        log_handles.handles.pop_back();
+    }
+}
+
+void scc::log_verbosity_handle::update() { verbosity = get_log_verbosity(scope.c_str()); }
+
+void scc::update_log_verbosity_handles() {
+    lut.clear();
+    std::lock_guard<std::mutex> lock(log_handles.mtx);
+    for(auto* h : log_handles.handles)
+        h->update();
+}
 
 auto scc::get_log_verbosity(char const* str) -> sc_core::sc_verbosity {
     if(inst_based_logging()) {
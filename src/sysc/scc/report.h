@@ -17,9 +17,12 @@
 #ifndef _SCC_REPORT_H_
 #define _SCC_REPORT_H_
 
+#include "binary_log.h"
 #include "utilities.h"
 #include <cci_configuration>
 #include <cstring>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -169,11 +172,13 @@ struct LogConfig {
     bool colored_output{true};
     std::string log_file_name{""};
     std::string log_filter_regex{""};
+    std::string log_filter_glob{""};
     bool log_async{true};
     bool dont_create_broker{false};
     bool report_only_first_error{false};
     bool instance_based_log_levels{true};
     bool install_handler{true};
+    std::string binary_log_file_name{""};
 
     /**
      * set the logging level
@@ -241,6 +246,13 @@ struct LogConfig {
      * @return self
      */
     LogConfig& logFilterRegex(const std::string&);
+    /**
+     * set comma separated glob patterns (see util::glob_trie) to filter the output by message type without regular
+     * expressions, e.g. "top.cpu*.**,top.mem". A message type passes if it matches a pattern or the regular expression
+     * @param patterns the glob patterns
+     * @return self
+     */
+    LogConfig& logFilterGlob(const std::string&);
     /**
      * enable/disable asynchronous output (write to file in separate thread
      * @param enable
@@ -271,6 +283,13 @@ struct LogConfig {
      * @return self
      */
     LogConfig& installHandler(bool = true);
+    /**
+     * set the file name of the binary log recording formatted info, debug and trace messages unformatted, see
+     * binary_logger
+     * @param name of the binary log file, empty to disable
+     * @return self
+     */
+    LogConfig& binaryLogFileName(const std::string&);
 };
 /**
  * @fn void init_logging(const LogConfig&)
@@ -340,6 +359,55 @@ sc_core::sc_verbosity get_log_verbosity(char const* t);
  * @return the verbosity level
  */
 inline sc_core::sc_verbosity get_log_verbosity(std::string const& t) { return get_log_verbosity(t.c_str()); }
+/**
+ * @class log_verbosity_handle
+ * @brief a cached scope-based verbosity level
+ *
+ * The handle looks up the verbosity level of its scope once and keeps it. It is registered globally and updated
+ * when the logging is (re-)initialized, the global logging level changes or a CCI parameter named "log_level" is
+ * written. Using it instead of the scope name in the logging macros (e.g. SCCTRACE(log_hndl)) reduces a disabled log
+ * statement to a load and a compare.
+ */
+class log_verbosity_handle {
+public:
+    /**
+     * @fn  log_verbosity_handle(const char*)
+     * @brief constructor registering the handle
+     *
+     * @param scope the SystemC hierarchy scope name
+     */
+    explicit log_verbosity_handle(char const* scope);
+
+    log_verbosity_handle(log_verbosity_handle const&) = delete;
+
+    log_verbosity_handle& operator=(log_verbosity_handle const&) = delete;
+
+    ~log_verbosity_handle();
+    //! the cached verbosity level
+    sc_core::sc_verbosity get() const { return verbosity; }
+    //! the SystemC hierarchy scope name
+    char const* name() const { return scope.c_str(); }
+    //! looks up the verbosity level again
+    void update();
+
+private:
+    std::string const scope;
+    sc_core::sc_verbosity verbosity;
+};
+/**
+ * @fn sc_core::sc_verbosity get_log_verbosity(const log_verbosity_handle&)
+ * @brief get the cached scope-based verbosity level
+ *
+ * @param h the handle of the SystemC hierarchy scope
+ * @return the verbosity level
+ */
+inline sc_core::sc_verbosity get_log_verbosity(log_verbosity_handle const& h) { return h.get(); }
+/**
+ * @fn void update_log_verbosity_handles()
+ * @brief updates all log_verbosity_handle instances, needs to be called if verbosity levels are changed bypassing
+ * the functions of this file
+ */
+void update_log_verbosity_handles();
 /**
  * @struct ScLogger
  * @brief the logger class
@@ -410,6 +478,17 @@ template <sc_core::sc_severity SEVERITY> struct ScLogger {
         this->t = const_cast<char*>(t.c_str());
         return *this;
     }
+    /**
+     * @fn ScLogger& type(log_verbosity_handle const&)
+     * @brief set the category of the log entry to the scope of a verbosity handle
+     *
+     * @param h the verbosity handle
+     * @return reference to self for chaining
+     */
+    inline ScLogger& type(log_verbosity_handle const& h) {
+        this->t = const_cast<char*>(h.name());
+        return *this;
+    }
     /**
      * @fn std::ostream& get()
      * @brief  get the underlying ostringstream
@@ -426,35 +505,123 @@ protected:
     const int level;
 };
 
+//! the type of a log message given as scope name
+inline char const* log_type(char const* t) { return t ? t : "SystemC"; }
+//! the type of a log message given as scope name
+inline char const* log_type(std::string const& t) { return t.c_str(); }
+//! the type of a log message given as verbosity handle
+inline char const* log_type(log_verbosity_handle const& h) { return h.name(); }
+/**
+ * @fn void log_formatted_v(sc_core::sc_severity, const char*, int, const char*, int, fmt::string_view, fmt::format_args)
+ * @brief formats a log message into a reused thread-local buffer and reports it
+ *
+ * @param severity the severity of the message
+ * @param type the type of the message
+ * @param verbosity the verbosity of the message
+ * @param file where the log entry originates
+ * @param line number where the log entry originates
+ * @param format the fmt format string
+ * @param args the arguments of the format string
+ */
+void log_formatted_v(sc_core::sc_severity severity, char const* type, int verbosity, char const* file, int line, fmt::string_view format,
+                     fmt::format_args args);
+/**
+ * @fn void log_formatted(sc_core::sc_severity, const char*, int, const char*, int, fmt::string_view, const ARGS&...)
+ * @brief formats a log message and reports it, see log_formatted_v()
+ */
+template <typename... ARGS>
+inline void log_formatted(sc_core::sc_severity severity, char const* type, int verbosity, char const* file, int line,
+                          fmt::string_view format, ARGS const&... args) {
+    log_formatted_v(severity, type, verbosity, file, line, format, fmt::make_format_args(args...));
+}
+/**
+ * @fn void log_deferred(log_site&, const char*, const ARGS&...)
+ * @brief records an info, debug or trace message in the binary log if it is active, otherwise the message is
+ * formatted and reported
+ *
+ * @param site the log statement
+ * @param type the type of the message
+ * @param args the arguments of the format string
+ */
+template <typename... ARGS> inline void log_deferred(log_site& site, char const* type, ARGS const&... args) {
+    if(binary_logger::is_active())
+        binary_logger::record(site, type, args...);
+    else
+        log_formatted_v(sc_core::SC_INFO, type, site.verbosity / 10, site.file, site.line, site.format, fmt::make_format_args(args...));
+}
+
 /**
  * logging macros
  */
+#ifndef SCC_LOG_MIN_LEVEL
+//! the most verbose level (the number of a scc::log value) of the logging macros being compiled in
+#define SCC_LOG_MIN_LEVEL 7
+#endif
 //! macro for log output
 #define SCCLOG(lvl, ...) ::scc::ScLogger<::sc_core::SC_INFO>(__FILE__, __LINE__, lvl / 10).type(__VA_ARGS__).get()
 //! macro for debug trace level output
 #define SCCTRACEALL(...)                                                                                                                   \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_DEBUG)                                                                         \
+    if(SCC_LOG_MIN_LEVEL >= 7 && ::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_DEBUG)                                               \
     SCCLOG(sc_core::SC_DEBUG, __VA_ARGS__)
 //! macro for trace level output
 #define SCCTRACE(...)                                                                                                                      \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_FULL)                                                                          \
+    if(SCC_LOG_MIN_LEVEL >= 6 && ::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_FULL)                                                \
     SCCLOG(sc_core::SC_FULL, __VA_ARGS__)
 //! macro for debug level output
 #define SCCDEBUG(...)                                                                                                                      \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_HIGH)                                                                          \
+    if(SCC_LOG_MIN_LEVEL >= 5 && ::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_HIGH)                                                \
     SCCLOG(sc_core::SC_HIGH, __VA_ARGS__)
 //! macro for info level output
 #define SCCINFO(...)                                                                                                                       \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_MEDIUM)                                                                        \
+    if(SCC_LOG_MIN_LEVEL >= 4 && ::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_MEDIUM)                                              \
     SCCLOG(sc_core::SC_MEDIUM, __VA_ARGS__)
 //! macro for warning level output
 #define SCCWARN(...)                                                                                                                       \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_LOW)                                                                           \
+    if(SCC_LOG_MIN_LEVEL >= 3 && ::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_LOW)                                                \
     ::scc::ScLogger<::sc_core::SC_WARNING>(__FILE__, __LINE__, sc_core::SC_MEDIUM).type(__VA_ARGS__).get()
 //! macro for error level output
 #define SCCERR(...) ::scc::ScLogger<::sc_core::SC_ERROR>(__FILE__, __LINE__, sc_core::SC_MEDIUM).type(__VA_ARGS__).get()
 //! macro for fatal message output
 #define SCCFATAL(...) ::scc::ScLogger<::sc_core::SC_FATAL>(__FILE__, __LINE__, sc_core::SC_MEDIUM).type(__VA_ARGS__).get()
+/**
+ * logging macros using fmt format strings, e.g. SCCDEBUGF(SCMOD, "read {} bytes from 0x{:x}", len, addr). The format
+ * needs to be a string literal, info, debug and trace messages are recorded unformatted if the binary log is active
+ * (see LogConfig::binaryLogFileName())
+ */
+//! macro for formatted log output
+#define SCCLOGF(lvl, type, format, ...)                                                                                                    \
+    ::scc::log_deferred(                                                                                                                   \
+        []() -> ::scc::log_site& {                                                                                                         \
+            static ::scc::log_site site(__FILE__, __LINE__, lvl, "" format "");                                                            \
+            return site;                                                                                                                   \
+        }(),                                                                                                                               \
+        ::scc::log_type(type), ##__VA_ARGS__)
+//! macro for formatted debug trace level output
+#define SCCTRACEALLF(type, ...)                                                                                                            \
+    if(SCC_LOG_MIN_LEVEL >= 7 && ::scc::get_log_verbosity(type) >= sc_core::SC_DEBUG)                                                      \
+    SCCLOGF(sc_core::SC_DEBUG, type, __VA_ARGS__)
+//! macro for formatted trace level output
+#define SCCTRACEF(type, ...)                                                                                                               \
+    if(SCC_LOG_MIN_LEVEL >= 6 && ::scc::get_log_verbosity(type) >= sc_core::SC_FULL)                                                       \
+    SCCLOGF(sc_core::SC_FULL, type, __VA_ARGS__)
+//! macro for formatted debug level output
+#define SCCDEBUGF(type, ...)                                                                                                               \
+    if(SCC_LOG_MIN_LEVEL >= 5 && ::scc::get_log_verbosity(type) >= sc_core::SC_HIGH)                                                       \
+    SCCLOGF(sc_core::SC_HIGH, type, __VA_ARGS__)
+//! macro for formatted info level output
+#define SCCINFOF(type, ...)                                                                                                                \
+    if(SCC_LOG_MIN_LEVEL >= 4 && ::scc::get_log_verbosity(type) >= sc_core::SC_MEDIUM)                                                     \
+    SCCLOGF(sc_core::SC_MEDIUM, type, __VA_ARGS__)
+//! macro for formatted warning level output
+#define SCCWARNF(type, ...)                                                                                                                \
+    if(SCC_LOG_MIN_LEVEL >= 3 && ::scc::get_log_verbosity(type) >= sc_core::SC_LOW)                                                        \
+    ::scc::log_formatted(::sc_core::SC_WARNING, ::scc::log_type(type), sc_core::SC_MEDIUM, __FILE__, __LINE__, __VA_ARGS__)
+//! macro for formatted error level output
+#define SCCERRF(type, ...)                                                                                                                 \
+    ::scc::log_formatted(::sc_core::SC_ERROR, ::scc::log_type(type), sc_core::SC_MEDIUM, __FILE__, __LINE__, __VA_ARGS__)
+//! macro for formatted fatal message output
+#define SCCFATALF(type, ...)                                                                                                               \
+    ::scc::log_formatted(::sc_core::SC_FATAL, ::scc::log_type(type), sc_core::SC_MEDIUM, __FILE__, __LINE__, __VA_ARGS__)
 
 #ifdef NDEBUG
 #define SCC_ASSERT(expr) ((void)0)
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "binary_log.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    if(argc < 2 || argc > 3) {
+        std::cerr << "usage: " << argv[0] << " <in.sbl> [out.log]\n"
+                  << "  converts a binary log written by scc::binary_logger to text, without output file name to stdout\n";
+        return 1;
+    }
+    std::ofstream ofs;
+    if(argc == 3) {
+        ofs.open(argv[2]);
+        if(!ofs.is_open()) {
+            std::cerr << "could not open " << argv[2] << "\n";
+            return 2;
+        }
+    }
+    if(!scc::binary_logger::decode(argv[1], argc == 3 ? ofs : std::cout)) {
+        std::cerr << "could not decode " << argv[1] << "\n";
+        return 2;
+    }
+    return 0;
+}
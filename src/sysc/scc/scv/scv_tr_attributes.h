@@ -0,0 +1,218 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCV_TR_ATTRIBUTES_H_
+#define _SCV_TR_ATTRIBUTES_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+// clang-format off
+#ifdef HAS_SCV
+#include <scv.h>
+#else
+#include <scv-tr.h>
+namespace scv_tr {
+#endif
+// clang-format on
+/**
+ * @brief the leaf attributes of an extension tree flattened in visiting order
+ *
+ * Records and arrays are expanded, their elements are named using the prefix of the layout the way the recorders name
+ * them. The names are built and interned once when the layout is created, recording the values of a transaction then
+ * only walks the extension tree. If the structure of a visited extension differs from the layout in the number, the
+ * types or the pointer depths of the leaves (e.g. because a followed pointer became null) the layout is rebuilt before
+ * any value is passed on.
+ */
+class scv_tr_attribute_layout {
+public:
+    //! a leaf attribute
+    struct leaf {
+        //! the full name of the attribute
+        std::string name;
+        //! the id of the name as returned by the intern function
+        uint64_t name_id;
+        //! the type of the attribute
+        scv_extensions_if::data_type type;
+        //! the number of pointers followed to reach this attribute
+        unsigned depth;
+    };
+    /**
+     * @brief constructor
+     *
+     * @param prefix the name prefix of the attributes
+     * @param follow_pointers if true pointers are dereferenced and their target is visited, otherwise a pointer is a
+     * leaf
+     */
+    explicit scv_tr_attribute_layout(std::string const& prefix = "", bool follow_pointers = false)
+    : prefix(prefix)
+    , follow_pointers(follow_pointers) {}
+    /**
+     * @brief (re-)creates the leaf list from an extension
+     *
+     * @param ext the extension
+     * @param intern function mapping a std::string to a uint64_t id
+     */
+    template <typename INTERN> void build(const scv_extensions_if* ext, INTERN&& intern) {
+        leaves.clear();
+        auto func = [this, &intern](const scv_extensions_if* e, unsigned depth) {
+            auto name = make_name(depth ? prefix + std::string(depth, '*') : prefix, e);
+            auto id = intern(name);
+            leaves.push_back(leaf{std::move(name), id, e->get_type(), depth});
+        };
+        walk(ext, 0, func);
+    }
+    /**
+     * @brief calls func(leaf const&, const scv_extensions_if*) for each leaf attribute of ext
+     *
+     * @param ext the extension
+     * @param intern function mapping a std::string to a uint64_t id, it is only called if the layout needs to be rebuilt
+     * @param func the function being called
+     */
+    template <typename INTERN, typename FUNC> void visit(const scv_extensions_if* ext, INTERN&& intern, FUNC&& func) {
+        // check the structure first so that no value is passed on with the name of a leaf of a stale layout
+        size_t idx = 0;
+        bool matches = true;
+        auto check = [this, &idx, &matches](const scv_extensions_if* e, unsigned depth) {
+            if(idx >= leaves.size() || leaves[idx].type != e->get_type() || leaves[idx].depth != depth)
+                matches = false;
+            ++idx;
+        };
+        walk(ext, 0, check);
+        if(!matches || idx != leaves.size())
+            build(ext, intern);
+        idx = 0;
+        auto f = [this, &idx, &func](const scv_extensions_if* e, unsigned) { func(leaves[idx++], e); };
+        walk(ext, 0, f);
+    }
+    //! the leaf attributes
+    std::vector<leaf> const& get_leaves() const { return leaves; }
+
+    static std::string make_name(std::string const& prefix, const scv_extensions_if* ext) {
+        std::string name;
+        if(prefix.empty()) {
+            name = ext->get_name() ? ext->get_name() : "";
+        } else if((ext->get_name() == nullptr) || (strlen(ext->get_name()) == 0)) {
+            name = prefix;
+        } else {
+            name = prefix + "." + ext->get_name();
+        }
+        return name.empty() ? "<unnamed>" : name;
+    }
+
+private:
+    template <typename FUNC> void walk(const scv_extensions_if* ext, unsigned depth, FUNC& func) const {
+        if(ext == nullptr)
+            return;
+        switch(ext->get_type()) {
+        case scv_extensions_if::RECORD:
+            for(int i = 0; i < ext->get_num_fields(); ++i)
+                walk(ext->get_field(i), depth, func);
+            break;
+        case scv_extensions_if::ARRAY:
+            for(int i = 0; i < ext->get_array_size(); ++i)
+                walk(ext->get_array_elt(i), depth, func);
+            break;
+        case scv_extensions_if::POINTER:
+            if(follow_pointers)
+                walk(ext->get_pointer(), depth + 1, func);
+            else
+                func(ext, depth);
+            break;
+        default:
+            func(ext, depth);
+        }
+    }
+
+    std::string const prefix;
+    bool const follow_pointers;
+    std::vector<leaf> leaves;
+};
+/**
+ * @brief the attribute layouts of a recording database
+ *
+ * Holds the begin and end attribute layouts of each generator, they are created when the generator is created. The
+ * layouts of attributes recorded using scv_tr_handle::record_attribute() are created on first use.
+ */
+class scv_tr_attribute_registry {
+public:
+    explicit scv_tr_attribute_registry(bool follow_pointers = false)
+    : follow_pointers(follow_pointers) {}
+    /**
+     * @brief creates the layouts of a generator
+     *
+     * @param g the generator
+     * @param intern function mapping a std::string to a uint64_t id
+     */
+    template <typename INTERN> void add_generator(const scv_tr_generator_base& g, INTERN&& intern) {
+        auto& entry = get_entry(g);
+        entry.first.build(g.get_begin_exts_p(), intern);
+        entry.second.build(g.get_end_exts_p(), intern);
+    }
+    /**
+     * @brief the layout of the begin or end attributes of a generator
+     *
+     * @param g the generator
+     * @param begin if true the begin attribute layout is returned otherwise the end attribute layout
+     */
+    scv_tr_attribute_layout& get_generator_layout(const scv_tr_generator_base& g, bool begin) {
+        auto& entry = get_entry(g);
+        return begin ? entry.first : entry.second;
+    }
+    /**
+     * @brief the layout of an attribute recorded using scv_tr_handle::record_attribute()
+     *
+     * @param name the name given to record_attribute()
+     */
+    scv_tr_attribute_layout& get_record_layout(char const* name) {
+        std::string key(name ? name : "");
+        auto it = records.find(key);
+        if(it == records.end())
+            it = records.emplace(key, scv_tr_attribute_layout(key, follow_pointers)).first;
+        return it->second;
+    }
+    //! removes all layouts
+    void clear() {
+        generators.clear();
+        records.clear();
+    }
+
+private:
+    using generator_entry = std::pair<scv_tr_attribute_layout, scv_tr_attribute_layout>;
+
+    generator_entry& get_entry(const scv_tr_generator_base& g) {
+        auto it = generators.find(g.get_id());
+        if(it == generators.end()) {
+            generator_entry entry{
+                scv_tr_attribute_layout(g.get_begin_attribute_name() ? g.get_begin_attribute_name() : "", follow_pointers),
+                scv_tr_attribute_layout(g.get_end_attribute_name() ? g.get_end_attribute_name() : "", follow_pointers)};
+            it = generators.emplace(g.get_id(), std::move(entry)).first;
+        }
+        return it->second;
+    }
+
+    bool const follow_pointers;
+    std::unordered_map<uint64_t, std::pair<scv_tr_attribute_layout, scv_tr_attribute_layout>> generators;
+    std::unordered_map<std::string, scv_tr_attribute_layout> records;
+};
+// ----------------------------------------------------------------------------
+#ifndef HAS_SCV
+}
+#endif
+#endif /* _SCV_TR_ATTRIBUTES_H_ */
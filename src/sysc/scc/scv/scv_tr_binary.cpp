@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include "scv_tr_attributes.h"
 #include <array>
 #include <boost/filesystem.hpp>
 #include <cmath>
@@ -25,6 +26,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <util/slot_allocator.h>
 #include <vector>
 // clang-format off
 #ifdef HAS_SCV
@@ -280,15 +282,15 @@ struct Database : Base {
 
     inline void writeTxTimepoint(uint64_t id, int type, uint64_t time, uint64_t file_offset) { t.append(type, time, file_offset); }
 
-    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, const string& value) {
-        d.writeAttribute(id, event, c.getIdOf(name), type, c.getIdOf(value));
+    inline void writeAttribute(uint64_t id, EventType event, uint64_t name, data_type type, const string& value) {
+        d.writeAttribute(id, event, name, type, c.getIdOf(value));
     }
 
-    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, uint64_t value) {
-        d.writeAttribute(id, event, c.getIdOf(name), type, value);
+    inline void writeAttribute(uint64_t id, EventType event, uint64_t name, data_type type, uint64_t value) {
+        d.writeAttribute(id, event, name, type, value);
     }
 
-    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, double value) {
+    inline void writeAttribute(uint64_t id, EventType event, uint64_t name, data_type type, double value) {
         //        int exponent;
         //        const double mantissa = frexp(value, &exponent);
     }
@@ -298,8 +300,10 @@ struct Database : Base {
     }
 };
 
-vector<vector<uint64_t>*> concurrencyLevel;
+util::concurrency_slots concurrencyLevel;
 Database* db;
+scv_tr_attribute_registry attributes;
+uint64_t getIdOf(std::string const& name) { return db->getIdOf(name); }
 std::unordered_map<uint64_t, uint64_t> id2offset;
 
 void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
@@ -318,6 +322,8 @@ void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void*
     case scv_tr_db::DELETE:
         try {
             delete db;
+            db = nullptr;
+            attributes.clear();
         } catch(...) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
         }
@@ -337,7 +343,7 @@ void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, voi
     }
 }
 // ----------------------------------------------------------------------------
-void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, const string& value) {
+void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, const string& value) {
     try {
         db->writeAttribute(id, event, name, type, value);
     } catch(std::runtime_error& e) {
@@ -345,7 +351,7 @@ void recordAttribute(uint64_t id, EventType event, const string& name, data_type
     }
 }
 // ----------------------------------------------------------------------------
-void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, long long value) {
+void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, long long value) {
     try {
         db->writeAttribute(id, event, name, type, static_cast<uint64_t>(value));
     } catch(std::runtime_error& e) {
@@ -353,7 +359,7 @@ void recordAttribute(uint64_t id, EventType event, const string& name, data_type
     }
 }
 // ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, double value) {
+inline void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, double value) {
     try {
         db->writeAttribute(id, event, name, type, value);
     } catch(std::runtime_error& e) {
@@ -361,81 +367,58 @@ inline void recordAttribute(uint64_t id, EventType event, const string& name, da
     }
 }
 // ----------------------------------------------------------------------------
-void recordAttributes(uint64_t id, EventType eventType, string& prefix, const scv_extensions_if* my_exts_p) {
+void recordAttributes(uint64_t id, EventType eventType, scv_tr_attribute_layout& layout, const scv_extensions_if* my_exts_p) {
     if(my_exts_p == nullptr)
         return;
-    string name;
-    if(prefix == "") {
-        name = my_exts_p->get_name();
-    } else {
-        if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
-            name = prefix;
-        } else {
-            name = prefix + "." + my_exts_p->get_name();
+    layout.visit(my_exts_p, getIdOf, [id, eventType](scv_tr_attribute_layout::leaf const& attr, const scv_extensions_if* ext) {
+        auto name = attr.name_id;
+        switch(attr.type) {
+        case scv_extensions_if::ENUMERATION:
+            recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, ext->get_enum_string((int)(ext->get_integer())));
+            break;
+        case scv_extensions_if::BOOLEAN:
+            recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, ext->get_bool() ? "TRUE" : "FALSE");
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER:
+            recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, ext->get_integer());
+            break;
+        case scv_extensions_if::UNSIGNED:
+            recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, ext->get_integer());
+            break;
+        case scv_extensions_if::POINTER:
+            recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)ext->get_pointer());
+            break;
+        case scv_extensions_if::STRING:
+            recordAttribute(id, eventType, name, scv_extensions_if::STRING, ext->get_string());
+            break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, ext->get_double());
+            break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(ext->get_bitwidth());
+            ext->get_value(tmp_bv);
+            recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(ext->get_bitwidth());
+            ext->get_value(tmp_lv);
+            recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
+        } break;
+        default: {
+            std::array<char, 100> tmpString;
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", ext->get_type());
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
         }
-    }
-    if(name == "")
-        name = "<unnamed>";
-    switch(my_exts_p->get_type()) {
-    case scv_extensions_if::RECORD: {
-        int num_fields = my_exts_p->get_num_fields();
-        if(num_fields > 0) {
-            for(int field_counter = 0; field_counter < num_fields; field_counter++) {
-                const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
-                recordAttributes(id, eventType, prefix, field_data_p);
-            }
         }
-    } break;
-    case scv_extensions_if::ENUMERATION:
-        recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
-        break;
-    case scv_extensions_if::BOOLEAN:
-        recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, my_exts_p->get_bool() ? "TRUE" : "FALSE");
-        break;
-    case scv_extensions_if::INTEGER:
-    case scv_extensions_if::FIXED_POINT_INTEGER:
-        recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::UNSIGNED:
-        recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::POINTER:
-        recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)my_exts_p->get_pointer());
-        break;
-    case scv_extensions_if::STRING:
-        recordAttribute(id, eventType, name, scv_extensions_if::STRING, my_exts_p->get_string());
-        break;
-    case scv_extensions_if::FLOATING_POINT_NUMBER:
-        recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, my_exts_p->get_double());
-        break;
-    case scv_extensions_if::BIT_VECTOR: {
-        sc_bv_base tmp_bv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_bv);
-        recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
-    } break;
-    case scv_extensions_if::LOGIC_VECTOR: {
-        sc_lv_base tmp_lv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_lv);
-        recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
-    } break;
-    case scv_extensions_if::ARRAY:
-        for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
-            const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
-            recordAttributes(id, eventType, prefix, field_data_p);
-        }
-        break;
-    default: {
-        std::array<char, 100> tmpString;
-        sprintf(tmpString.data(), "Unsupported attribute type = %d", my_exts_p->get_type());
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
-    }
-    }
+    });
 }
 // ----------------------------------------------------------------------------
 void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
     if(reason == scv_tr_generator_base::CREATE && db) {
         try {
             db->writeGenerator(g.get_id(), g.get_name(), g.get_scv_tr_stream().get_id());
+            attributes.add_generator(g, getIdOf);
         } catch(std::runtime_error& e) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create generator entry");
         }
@@ -452,25 +435,11 @@ void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason
 
     uint64_t id = t.get_id();
     uint64_t streamId = t.get_scv_tr_stream().get_id();
-    vector<uint64_t>::size_type concurrencyIdx;
     const scv_extensions_if* my_exts_p;
     switch(reason) {
     case scv_tr_handle::BEGIN: {
         try {
-            if(concurrencyLevel.size() <= streamId)
-                concurrencyLevel.resize(streamId + 1);
-            vector<uint64_t>* levels = concurrencyLevel.at(streamId);
-            if(levels == nullptr) {
-                levels = new vector<uint64_t>();
-                concurrencyLevel[id] = levels;
-            }
-            for(concurrencyIdx = 0; concurrencyIdx < levels->size(); ++concurrencyIdx)
-                if((*levels)[concurrencyIdx] == 0)
-                    break;
-            if(concurrencyIdx == levels->size())
-                levels->push_back(id);
-            else
-                (*levels)[concurrencyIdx] = id;
+            auto concurrencyIdx = concurrencyLevel.begin(streamId, id);
             auto offset = db->writeTransaction(id, t.get_scv_tr_generator_base().get_id(), concurrencyIdx);
             db->writeTxTimepoint(id, BEGIN, t.get_begin_sc_time().value(), offset);
             id2offset[id] = offset;
@@ -480,22 +449,11 @@ void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason
         my_exts_p = t.get_begin_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-        if(my_exts_p) {
-            string tmp_str =
-                t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-            recordAttributes(id, BEGIN, tmp_str, my_exts_p);
-        }
+        recordAttributes(id, BEGIN, attributes.get_generator_layout(t.get_scv_tr_generator_base(), true), my_exts_p);
     } break;
     case scv_tr_handle::END: {
         try {
-            vector<uint64_t>* levels = concurrencyLevel[streamId];
-            for(concurrencyIdx = 0; concurrencyIdx < levels->size(); ++concurrencyIdx)
-                if((*levels)[concurrencyIdx] == id)
-                    break;
-            if(concurrencyIdx == levels->size())
-                levels->push_back(id);
-            else
-                (*levels)[concurrencyIdx] = id;
+            concurrencyLevel.end(streamId, id);
             db->writeTxTimepoint(id, END, t.get_begin_sc_time().value(), id2offset[id]);
             id2offset.erase(id);
         } catch(std::runtime_error& e) {
@@ -504,11 +462,7 @@ void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason
         my_exts_p = t.get_end_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-        if(my_exts_p) {
-            string tmp_str =
-                t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-            recordAttributes(t.get_id(), END, tmp_str, my_exts_p);
-        }
+        recordAttributes(t.get_id(), END, attributes.get_generator_layout(t.get_scv_tr_generator_base(), false), my_exts_p);
     } break;
     default:;
     }
@@ -521,8 +475,7 @@ void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    string tmp_str(name == nullptr ? "" : name);
-    recordAttributes(t.get_id(), RECORD, tmp_str, ext);
+    recordAttributes(t.get_id(), RECORD, attributes.get_record_layout(name), ext);
 }
 // ----------------------------------------------------------------------------
 void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
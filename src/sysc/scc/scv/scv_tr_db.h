@@ -51,19 +51,39 @@ void scv_tr_plain_init();
  */
 void scv_tr_lz4_init();
 /**
- * @fn void scv_tr_mtc_init()
- * @brief initializes the infrastructure to use a compressed text based transaction recording database with a
- * multithreaded writer
+ * @fn void scv_tr_ftr_init(bool compressed)
+ * @brief initializes the infrastructure to use a FTR (CBOR based) transaction recording database, the encoding and
+ * compression is done in a writer thread
  *
  */
 void scv_tr_ftr_init(bool compressed);
 /**
  * @fn void scv_tr_mtc_init()
- * @brief initializes the infrastructure to use a compressed text based transaction recording database with a
+ * @brief initializes the infrastructure to use a LZ4 compressed text based transaction recording database with a
  * multithreaded writer
  *
+ * The text schema is the one of scv_tr_compressed_init(), the records are formatted on the simulation thread and
+ * compressed and written in a separate thread.
  */
 void scv_tr_mtc_init();
+/**
+ * @fn void scv_tr_raw_init()
+ * @brief initializes the infrastructure to use a raw transaction log
+ *
+ * The records are appended unencoded to a memory mapped file, the log needs to be converted using
+ * scv_tr_raw_convert() after the simulation. Only available on POSIX systems.
+ */
+void scv_tr_raw_init();
+/**
+ * @fn bool scv_tr_raw_convert(char const*, char const*, bool)
+ * @brief converts a raw transaction log into a FTR transaction recording database
+ *
+ * @param in_name the name of the raw log
+ * @param out_name the name of the FTR database
+ * @param compressed if true a compressed FTR (CFTR) database is written
+ * @return true if the log could be read and converted
+ */
+bool scv_tr_raw_convert(char const* in_name, char const* out_name, bool compressed);
 
 #ifdef USE_EXTENDED_DB
 /**
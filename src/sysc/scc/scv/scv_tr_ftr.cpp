@@ -16,15 +16,20 @@
 #include <array>
 #include <boost/filesystem.hpp>
 #include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <fcntl.h>
 #include <fstream>
 #include <ftr/ftr_writer.h>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -41,8 +46,171 @@ using namespace std;
 using namespace ftr;
 // ----------------------------------------------------------------------------
 namespace {
+//! a recorded item, it holds the arguments of the ftr_writer call being replayed by the writer thread
+struct ftr_record {
+    enum kind_e : uint8_t { STREAM, GENERATOR, TX_BEGIN, TX_END, ATTRIBUTE, RELATION } kind;
+    enum value_e : uint8_t { STRING, BOOL, INTEGER, REAL } value_kind;
+    event_type event;
+    ftr::data_type type;
+    uint64_t id, id1, id2, id3;
+    double time;
+    union {
+        bool b;
+        long long i;
+        double d;
+    } value;
+    string name, str;
+};
+/**
+ * @brief decouples the simulation thread from the CBOR encoding and compression done by ftr_writer
+ *
+ * The simulation thread appends the raw records to a chunk, full chunks are handed over to a writer thread which
+ * replays them into the ftr_writer. Chunks are processed in the order they were filled so the resulting file is the
+ * same as when writing synchronously. Processed chunks are recycled together with their records, as the name and
+ * value strings keep their buffers the simulation thread only allocates while the string capacities grow. At most
+ * max_pending chunks wait for the writer thread, if it falls behind the simulation thread blocks until one is written.
+ */
+template <bool COMPRESSED> class ftr_pipeline {
+public:
+    static constexpr size_t chunk_size = 4096;
+    //! the maximum number of full chunks waiting for the writer thread
+    static constexpr size_t max_pending = 64;
+
+    explicit ftr_pipeline(ftr_writer<COMPRESSED>* db)
+    : db(db)
+    , cur(new_chunk())
+    , worker([this]() { run(); }) {}
+
+    ~ftr_pipeline() { close(); }
+    //! returns the next record to be filled by the simulation thread
+    inline ftr_record& next() {
+        if(cur->used == chunk_size)
+            submit();
+        return cur->records[cur->used++];
+    }
+    //! writes all pending chunks and stops the writer thread
+    void close() {
+        if(!worker.joinable())
+            return;
+        submit();
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            done = true;
+        }
+        cond.notify_one();
+        worker.join();
+        if(error.size())
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, error.c_str());
+    }
+
+private:
+    //! the records are kept when a chunk is recycled so the strings reuse their buffers
+    struct record_chunk {
+        vector<ftr_record> records = vector<ftr_record>(chunk_size);
+        size_t used{0};
+    };
+    using chunk = std::unique_ptr<record_chunk>;
+
+    chunk new_chunk() {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(pool.empty())
+            return chunk(new record_chunk());
+        auto res = std::move(pool.back());
+        pool.pop_back();
+        return res;
+    }
+
+    void submit() {
+        if(!cur->used)
+            return;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            space.wait(lock, [this]() { return pending.size() < max_pending; });
+            pending.push_back(std::move(cur));
+        }
+        cond.notify_one();
+        cur = new_chunk();
+    }
+
+    void run() {
+        for(;;) {
+            chunk c;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cond.wait(lock, [this]() { return done || !pending.empty(); });
+                if(pending.empty())
+                    return;
+                c = std::move(pending.front());
+                pending.pop_front();
+            }
+            space.notify_one();
+            for(size_t i = 0; i < c->used; ++i)
+                replay(c->records[i]);
+            c->used = 0;
+            std::unique_lock<std::mutex> lock(mtx);
+            pool.push_back(std::move(c));
+        }
+    }
+
+    void replay(ftr_record const& r) {
+        try {
+            switch(r.kind) {
+            case ftr_record::STREAM:
+                db->writeStream(r.id, r.name.c_str(), r.str.c_str());
+                break;
+            case ftr_record::GENERATOR:
+                db->writeGenerator(r.id, r.name.c_str(), r.id1);
+                break;
+            case ftr_record::TX_BEGIN:
+                db->startTransaction(r.id, r.id1, r.id2, r.time);
+                break;
+            case ftr_record::TX_END:
+                db->endTransaction(r.id, r.time);
+                break;
+            case ftr_record::ATTRIBUTE:
+                switch(r.value_kind) {
+                case ftr_record::STRING:
+                    db->writeAttribute(r.id, r.event, r.name, r.type, r.str);
+                    break;
+                case ftr_record::BOOL:
+                    db->writeAttribute(r.id, r.event, r.name, r.type, r.value.b);
+                    break;
+                case ftr_record::INTEGER:
+                    db->writeAttribute(r.id, r.event, r.name, r.type, r.value.i);
+                    break;
+                case ftr_record::REAL:
+                    db->writeAttribute(r.id, r.event, r.name, r.type, r.value.d);
+                    break;
+                }
+                break;
+            case ftr_record::RELATION:
+                db->writeRelation(r.name.c_str(), r.id, r.id1, r.id2, r.id3);
+                break;
+            }
+        } catch(std::runtime_error& e) {
+            if(error.empty())
+                error = e.what();
+        }
+    }
+
+    ftr_writer<COMPRESSED>* db;
+    std::mutex mtx;
+    std::condition_variable cond;
+    //! notified when the writer thread took a chunk from pending
+    std::condition_variable space;
+    std::deque<chunk> pending;
+    vector<chunk> pool;
+    chunk cur;
+    bool done{false};
+    string error;
+    std::thread worker;
+};
+template <bool COMPRESSED> constexpr size_t ftr_pipeline<COMPRESSED>::chunk_size;
+template <bool COMPRESSED> constexpr size_t ftr_pipeline<COMPRESSED>::max_pending;
+
 template <bool COMPRESSED> struct tx_db {
     static ftr_writer<COMPRESSED>* db;
+    static ftr_pipeline<COMPRESSED>* pipeline;
     static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
         // This is called from the scv_tr_db ctor.
         static string fName("DEFAULT_scv_tr_cbor");
@@ -62,11 +230,15 @@ template <bool COMPRESSED> struct tx_db {
                 double secs = sc_core::sc_time::from_value(1ULL).to_seconds();
                 auto exp = rint(log(secs) / log(10.0));
                 db->writeInfo(static_cast<int8_t>(exp));
+                pipeline = new ftr_pipeline<COMPRESSED>(db);
             }
             break;
         case scv_tr_db::DELETE:
             try {
+                delete pipeline;
+                pipeline = nullptr;
                 delete db;
+                db = nullptr;
             } catch(...) {
                 _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
             }
@@ -78,40 +250,49 @@ template <bool COMPRESSED> struct tx_db {
     // ----------------------------------------------------------------------------
     static void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, void* data) {
         if(db && reason == scv_tr_stream::CREATE) {
-            try {
-                db->writeStream(s.get_id(), s.get_name(), s.get_stream_kind());
-            } catch(std::runtime_error& e) {
-                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create stream");
-            }
+            auto& r = pipeline->next();
+            r.kind = ftr_record::STREAM;
+            r.id = s.get_id();
+            r.name = s.get_name();
+            r.str = s.get_stream_kind() ? s.get_stream_kind() : "";
         }
     }
     // ----------------------------------------------------------------------------
+    static inline ftr_record& nextAttribute(uint64_t id, event_type event, const string& name, ftr::data_type type,
+                                            ftr_record::value_e value_kind) {
+        auto& r = pipeline->next();
+        r.kind = ftr_record::ATTRIBUTE;
+        r.id = id;
+        r.event = event;
+        r.name = name;
+        r.type = type;
+        r.value_kind = value_kind;
+        return r;
+    }
+    // ----------------------------------------------------------------------------
     static inline void recordAttribute(uint64_t id, event_type event, const string& name, ftr::data_type type, const string& value) {
         if(db)
-            try {
-                db->writeAttribute(id, event, name, type, value);
-            } catch(std::runtime_error& e) {
-                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-            }
+            nextAttribute(id, event, name, type, ftr_record::STRING).str = value;
     }
     // ----------------------------------------------------------------------------
     static inline void recordAttribute(uint64_t id, event_type event, const string& name, ftr::data_type type, char const* value) {
         if(db)
-            try {
-                db->writeAttribute(id, event, name, type, value);
-            } catch(std::runtime_error& e) {
-                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-            }
+            nextAttribute(id, event, name, type, ftr_record::STRING).str = value;
     }
     // ----------------------------------------------------------------------------
-    template <typename T>
-    static inline void recordAttribute(uint64_t id, event_type event, const string& name, ftr::data_type type, T value) {
+    static inline void recordAttribute(uint64_t id, event_type event, const string& name, ftr::data_type type, bool value) {
         if(db)
-            try {
-                db->writeAttribute(id, event, name, type, value);
-            } catch(std::runtime_error& e) {
-                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-            }
+            nextAttribute(id, event, name, type, ftr_record::BOOL).value.b = value;
+    }
+    // ----------------------------------------------------------------------------
+    static inline void recordAttribute(uint64_t id, event_type event, const string& name, ftr::data_type type, long long value) {
+        if(db)
+            nextAttribute(id, event, name, type, ftr_record::INTEGER).value.i = value;
+    }
+    // ----------------------------------------------------------------------------
+    static inline void recordAttribute(uint64_t id, event_type event, const string& name, ftr::data_type type, double value) {
+        if(db)
+            nextAttribute(id, event, name, type, ftr_record::REAL).value.d = value;
     }
     // ----------------------------------------------------------------------------
     static inline std::string get_name(const char* prefix, const scv_extensions_if* my_exts_p) {
@@ -189,11 +370,11 @@ template <bool COMPRESSED> struct tx_db {
     // ----------------------------------------------------------------------------
     static void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
         if(db && reason == scv_tr_generator_base::CREATE) {
-            try {
-                db->writeGenerator(g.get_id(), g.get_name(), g.get_scv_tr_stream().get_id());
-            } catch(std::runtime_error& e) {
-                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create generator entry");
-            }
+            auto& r = pipeline->next();
+            r.kind = ftr_record::GENERATOR;
+            r.id = g.get_id();
+            r.name = g.get_name();
+            r.id1 = g.get_scv_tr_stream().get_id();
         }
     }
     // ----------------------------------------------------------------------------
@@ -203,8 +384,12 @@ template <bool COMPRESSED> struct tx_db {
         uint64_t id = t.get_id();
         switch(reason) {
         case scv_tr_handle::BEGIN: {
-            db->startTransaction(id, t.get_scv_tr_generator_base().get_id(), t.get_scv_tr_generator_base().get_scv_tr_stream().get_id(),
-                                 t.get_begin_sc_time() / sc_core::sc_time(1, sc_core::SC_PS));
+            auto& r = pipeline->next();
+            r.kind = ftr_record::TX_BEGIN;
+            r.id = id;
+            r.id1 = t.get_scv_tr_generator_base().get_id();
+            r.id2 = t.get_scv_tr_generator_base().get_scv_tr_stream().get_id();
+            r.time = t.get_begin_sc_time() / sc_core::sc_time(1, sc_core::SC_PS);
 
             auto my_exts_p = t.get_begin_exts_p();
             if(my_exts_p == nullptr)
@@ -225,7 +410,10 @@ template <bool COMPRESSED> struct tx_db {
                     t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
                 recordAttributes(id, event_type::END, tmp_str, my_exts_p);
             }
-            db->endTransaction(id, t.get_end_sc_time() / sc_core::sc_time(1, sc_core::SC_PS));
+            auto& r = pipeline->next();
+            r.kind = ftr_record::TX_END;
+            r.id = id;
+            r.time = t.get_end_sc_time() / sc_core::sc_time(1, sc_core::SC_PS);
         } break;
         default:;
         }
@@ -242,15 +430,17 @@ template <bool COMPRESSED> struct tx_db {
         auto txdb = stream1.get_scv_tr_db();
         if(!db || !txdb || !txdb->get_recording())
             return;
-        try {
-            auto& stream2 = tr_2.get_scv_tr_stream();
-            db->writeRelation(txdb->get_relation_name(relation_handle), stream1.get_id(), tr_1.get_id(), stream2.get_id(), tr_2.get_id());
-        } catch(std::runtime_error& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction relation");
-        }
+        auto& r = pipeline->next();
+        r.kind = ftr_record::RELATION;
+        r.name = txdb->get_relation_name(relation_handle);
+        r.id = stream1.get_id();
+        r.id1 = tr_1.get_id();
+        r.id2 = tr_2.get_scv_tr_stream().get_id();
+        r.id3 = tr_2.get_id();
     }
 };
 template <bool COMPRESSED> ftr_writer<COMPRESSED>* tx_db<COMPRESSED>::db{nullptr};
+template <bool COMPRESSED> ftr_pipeline<COMPRESSED>* tx_db<COMPRESSED>::pipeline{nullptr};
 } // namespace
 // ----------------------------------------------------------------------------
 void scv_tr_ftr_init(bool compressed) {
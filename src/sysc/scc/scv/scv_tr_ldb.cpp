@@ -14,6 +14,7 @@
  * limitations under the License.
  *******************************************************************************/
 #include "leveldb/db.h"
+#include "scv_tr_attributes.h"
 #include <json/json.h>
 
 #include <array>
@@ -29,6 +30,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <util/slot_allocator.h>
 #include <vector>
 // clang-format off
 #include "scv/scv_util.h"
@@ -261,7 +263,10 @@ private:
     unordered_map<uint64_t, Value> tx_lut;
 };
 
-vector<vector<uint64_t>> concurrencyLevel;
+util::concurrency_slots concurrencyLevel;
+//! the JSON entries hold the attribute names as text so no ids are assigned
+scv_tr_attribute_registry attributes;
+uint64_t noId(std::string const&) { return 0; }
 
 Database* db;
 
@@ -286,6 +291,7 @@ void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void*
     case scv_tr_db::DELETE:
         try {
             delete db;
+            attributes.clear();
         } catch(...) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
         }
@@ -329,81 +335,58 @@ inline void recordAttribute(uint64_t id, EventType event, const string& name, da
     }
 }
 // ----------------------------------------------------------------------------
-void recordAttributes(uint64_t id, EventType eventType, string& prefix, const scv_extensions_if* my_exts_p) {
+void recordAttributes(uint64_t id, EventType eventType, scv_tr_attribute_layout& layout, const scv_extensions_if* my_exts_p) {
     if(my_exts_p == nullptr)
         return;
-    string name;
-    if(prefix == "") {
-        name = my_exts_p->get_name();
-    } else {
-        if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
-            name = prefix;
-        } else {
-            name = prefix + "." + my_exts_p->get_name();
-        }
-    }
-    if(name == "")
-        name = "<unnamed>";
-    switch(my_exts_p->get_type()) {
-    case scv_extensions_if::RECORD: {
-        int num_fields = my_exts_p->get_num_fields();
-        if(num_fields > 0) {
-            for(int field_counter = 0; field_counter < num_fields; field_counter++) {
-                const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
-                recordAttributes(id, eventType, prefix, field_data_p);
-            }
+    layout.visit(my_exts_p, noId, [id, eventType](scv_tr_attribute_layout::leaf const& attr, const scv_extensions_if* ext) {
+        auto& name = attr.name;
+        switch(attr.type) {
+        case scv_extensions_if::ENUMERATION:
+            recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, ext->get_enum_string((int)(ext->get_integer())));
+            break;
+        case scv_extensions_if::BOOLEAN:
+            recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, ext->get_bool() ? "TRUE" : "FALSE");
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER:
+            recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, ext->get_integer());
+            break;
+        case scv_extensions_if::UNSIGNED:
+            recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, ext->get_integer());
+            break;
+        case scv_extensions_if::POINTER:
+            recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)ext->get_pointer());
+            break;
+        case scv_extensions_if::STRING:
+            recordAttribute(id, eventType, name, scv_extensions_if::STRING, ext->get_string());
+            break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, ext->get_double());
+            break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(ext->get_bitwidth());
+            ext->get_value(tmp_bv);
+            recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(ext->get_bitwidth());
+            ext->get_value(tmp_lv);
+            recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
+        } break;
+        default: {
+            array<char, 100> tmpString;
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", ext->get_type());
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
         }
-    } break;
-    case scv_extensions_if::ENUMERATION:
-        recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
-        break;
-    case scv_extensions_if::BOOLEAN:
-        recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, my_exts_p->get_bool() ? "TRUE" : "FALSE");
-        break;
-    case scv_extensions_if::INTEGER:
-    case scv_extensions_if::FIXED_POINT_INTEGER:
-        recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::UNSIGNED:
-        recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::POINTER:
-        recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)my_exts_p->get_pointer());
-        break;
-    case scv_extensions_if::STRING:
-        recordAttribute(id, eventType, name, scv_extensions_if::STRING, my_exts_p->get_string());
-        break;
-    case scv_extensions_if::FLOATING_POINT_NUMBER:
-        recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, my_exts_p->get_double());
-        break;
-    case scv_extensions_if::BIT_VECTOR: {
-        sc_bv_base tmp_bv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_bv);
-        recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
-    } break;
-    case scv_extensions_if::LOGIC_VECTOR: {
-        sc_lv_base tmp_lv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_lv);
-        recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
-    } break;
-    case scv_extensions_if::ARRAY:
-        for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
-            const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
-            recordAttributes(id, eventType, prefix, field_data_p);
         }
-        break;
-    default: {
-        array<char, 100> tmpString;
-        sprintf(tmpString.data(), "Unsupported attribute type = %d", my_exts_p->get_type());
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
-    }
-    }
+    });
 }
 // ----------------------------------------------------------------------------
 void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
     if(reason == scv_tr_generator_base::CREATE && db) {
         try {
             db->writeGenerator(g.get_id(), g.get_name(), g.get_scv_tr_stream().get_id());
+            attributes.add_generator(g, noId);
         } catch(runtime_error& e) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create generator entry");
         }
@@ -420,21 +403,11 @@ void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason
 
     uint64_t id = t.get_id();
     uint64_t streamId = t.get_scv_tr_stream().get_id();
-    vector<uint64_t>::size_type concurrencyIdx;
     const scv_extensions_if* my_exts_p;
     switch(reason) {
     case scv_tr_handle::BEGIN: {
         try {
-            if(concurrencyLevel.size() <= streamId)
-                concurrencyLevel.resize(streamId + 1);
-            vector<uint64_t>& levels = concurrencyLevel.at(streamId);
-            for(concurrencyIdx = 0; concurrencyIdx < levels.size(); ++concurrencyIdx) // find a free slot
-                if(levels[concurrencyIdx] == 0)
-                    break;
-            if(concurrencyIdx == levels.size())
-                levels.push_back(id);
-            else
-                levels[concurrencyIdx] = id;
+            auto concurrencyIdx = concurrencyLevel.begin(streamId, id);
             db->writeTransaction(id, t.get_scv_tr_stream().get_id(), t.get_scv_tr_generator_base().get_id(), concurrencyIdx);
             db->writeTxTimepoint(id, t.get_scv_tr_stream().get_id(), BEGIN, t.get_begin_sc_time().value());
         } catch(runtime_error& e) {
@@ -443,31 +416,16 @@ void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason
         my_exts_p = t.get_begin_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-        if(my_exts_p) {
-            string tmp_str =
-                t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-            recordAttributes(id, BEGIN, tmp_str, my_exts_p);
-        }
+        recordAttributes(id, BEGIN, attributes.get_generator_layout(t.get_scv_tr_generator_base(), true), my_exts_p);
     } break;
     case scv_tr_handle::END: {
         my_exts_p = t.get_end_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-        if(my_exts_p) {
-            string tmp_str =
-                t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-            recordAttributes(t.get_id(), END, tmp_str, my_exts_p);
-        }
+        recordAttributes(t.get_id(), END, attributes.get_generator_layout(t.get_scv_tr_generator_base(), false), my_exts_p);
         try {
             db->writeTxTimepoint(id, t.get_scv_tr_stream().get_id(), END, t.get_end_sc_time().value());
-            vector<uint64_t>& levels = concurrencyLevel[streamId];
-            for(concurrencyIdx = 0; concurrencyIdx < levels.size(); ++concurrencyIdx)
-                if(levels[concurrencyIdx] == id)
-                    break;
-            if(concurrencyIdx == levels.size())
-                levels.push_back(0);
-            else
-                levels[concurrencyIdx] = 0;
+            concurrencyLevel.end(streamId, id);
         } catch(runtime_error& e) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction end");
         }
@@ -483,8 +441,7 @@ void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    string tmp_str(name == nullptr ? "" : name);
-    recordAttributes(t.get_id(), RECORD, tmp_str, ext);
+    recordAttributes(t.get_id(), RECORD, attributes.get_record_layout(name), ext);
 }
 // ----------------------------------------------------------------------------
 void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
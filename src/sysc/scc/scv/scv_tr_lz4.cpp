@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include "scv_tr_attributes.h"
 #include <array>
 #include <boost/filesystem.hpp>
 #include <cmath>
@@ -104,6 +105,9 @@ public:
 
 template <typename WRITER> struct Formatter {
     std::unique_ptr<WRITER> writer;
+    //! the attribute names are only needed for record attributes, so no ids are assigned
+    scv_tr_attribute_registry attributes{true};
+    static uint64_t noId(std::string const&) { return 0; }
     Formatter(const std::string& name)
     : writer(new WRITER(name)) {}
 
@@ -114,7 +118,10 @@ template <typename WRITER> struct Formatter {
         return writer->is_open();
     }
 
-    inline void close() { delete writer.release(); }
+    inline void close() {
+        delete writer.release();
+        attributes.clear();
+    }
 
     inline void writeStream(uint64_t id, std::string const& name, std::string const& kind) {
         auto buf = fmt::format("scv_tr_stream (ID {}, name \"{}\", kind \"{}\")\n", id, name.c_str(), kind.c_str());
@@ -232,86 +239,50 @@ template <typename DB> inline void recordAttribute(uint64_t id, EventType event,
         _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
     }
 }
-// ----------------------------------------------------------------------------
-inline std::string get_name(const char* prefix, const scv_extensions_if* my_exts_p) {
-    string name;
-    if(!prefix || strlen(prefix) == 0) {
-        name = my_exts_p->get_name();
-    } else {
-        if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
-            name = prefix;
-        } else {
-            name = fmt::format("{}.{}", prefix, my_exts_p->get_name());
-        }
-    }
-    return (name == "") ? "<unnamed>" : name;
-}
-
 // ----------------------------------------------------------------------------
 template <typename DB>
-inline void recordAttributes(uint64_t id, EventType eventType, char const* prefix, const scv_extensions_if* my_exts_p) {
+inline void recordAttributes(uint64_t id, EventType eventType, scv_tr_attribute_layout& layout, const scv_extensions_if* my_exts_p) {
     if(my_exts_p == nullptr)
         return;
-    auto name = get_name(prefix, my_exts_p);
-    switch(my_exts_p->get_type()) {
-    case scv_extensions_if::RECORD: {
-        int num_fields = my_exts_p->get_num_fields();
-        if(num_fields > 0) {
-            for(int field_counter = 0; field_counter < num_fields; field_counter++) {
-                const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
-                recordAttributes<DB>(id, eventType, prefix, field_data_p);
-            }
+    layout.visit(my_exts_p, DB::noId, [id, eventType](scv_tr_attribute_layout::leaf const& attr, const scv_extensions_if* ext) {
+        auto& name = attr.name;
+        switch(attr.type) {
+        case scv_extensions_if::ENUMERATION:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, string(ext->get_enum_string((int)(ext->get_integer()))));
+            break;
+        case scv_extensions_if::BOOLEAN:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, ext->get_bool());
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::INTEGER, (int64_t)ext->get_integer());
+            break;
+        case scv_extensions_if::UNSIGNED:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, (uint64_t)ext->get_unsigned());
+            break;
+        case scv_extensions_if::STRING:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::STRING, ext->get_string());
+            break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, ext->get_double());
+            break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(ext->get_bitwidth());
+            ext->get_value(tmp_bv);
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(ext->get_bitwidth());
+            ext->get_value(tmp_lv);
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
+        } break;
+        default: {
+            std::array<char, 100> tmpString;
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", ext->get_type());
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
         }
-    } break;
-    case scv_extensions_if::POINTER:
-        if(auto ptr = my_exts_p->get_pointer()) {
-            std::stringstream ss;
-            ss << prefix << "*";
-            recordAttributes<DB>(id, eventType, ss.str().c_str(), ptr);
         }
-        break;
-    case scv_extensions_if::ENUMERATION:
-        DB::get().writeAttribute(id, eventType, name, scv_extensions_if::ENUMERATION,
-                                 my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
-        break;
-    case scv_extensions_if::BOOLEAN:
-        DB::get().writeAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, my_exts_p->get_bool());
-        break;
-    case scv_extensions_if::INTEGER:
-    case scv_extensions_if::FIXED_POINT_INTEGER:
-        DB::get().writeAttribute(id, eventType, name, scv_extensions_if::INTEGER, (int64_t)my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::UNSIGNED:
-        DB::get().writeAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, (uint64_t)my_exts_p->get_unsigned());
-        break;
-    case scv_extensions_if::STRING:
-        DB::get().writeAttribute(id, eventType, name, scv_extensions_if::STRING, my_exts_p->get_string());
-        break;
-    case scv_extensions_if::FLOATING_POINT_NUMBER:
-        DB::get().writeAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, my_exts_p->get_double());
-        break;
-    case scv_extensions_if::BIT_VECTOR: {
-        sc_bv_base tmp_bv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_bv);
-        DB::get().writeAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
-    } break;
-    case scv_extensions_if::LOGIC_VECTOR: {
-        sc_lv_base tmp_lv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_lv);
-        DB::get().writeAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
-    } break;
-    case scv_extensions_if::ARRAY:
-        for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
-            const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
-            recordAttributes<DB>(id, eventType, prefix, field_data_p);
-        }
-        break;
-    default: {
-        std::array<char, 100> tmpString;
-        sprintf(tmpString.data(), "Unsupported attribute type = %d", my_exts_p->get_type());
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
-    }
-    }
+    });
 }
 // ----------------------------------------------------------------------------
 template <typename DB> void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
@@ -327,6 +298,7 @@ template <typename DB> void generatorCb(const scv_tr_generator_base& g, scv_tr_g
                 attrs.emplace_back(END, my_end_exts_p->get_type(), g.get_end_attribute_name() ? g.get_end_attribute_name() : "");
             }
             DB::get().writeGenerator(g.get_id(), g.get_name(), g.get_scv_tr_stream().get_id(), attrs);
+            DB::get().attributes.add_generator(g, DB::noId);
         } catch(std::runtime_error& e) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create generator entry");
         }
@@ -348,22 +320,14 @@ template <typename DB> void transactionCb(const scv_tr_handle& t, scv_tr_handle:
         my_exts_p = t.get_begin_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-            recordAttributes<DB>(id, BEGIN, tmp_str, my_exts_p);
-        }
+        recordAttributes<DB>(id, BEGIN, DB::get().attributes.get_generator_layout(t.get_scv_tr_generator_base(), true), my_exts_p);
     } break;
     case scv_tr_handle::END: {
         DB::get().writeTransaction(t.get_id(), t.get_scv_tr_generator_base().get_id(), END, t.get_begin_sc_time().value());
         my_exts_p = t.get_end_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-            recordAttributes<DB>(t.get_id(), END, tmp_str, my_exts_p);
-        }
+        recordAttributes<DB>(t.get_id(), END, DB::get().attributes.get_generator_layout(t.get_scv_tr_generator_base(), false), my_exts_p);
     } break;
     default:;
     }
@@ -374,7 +338,7 @@ template <typename DB> void attributeCb(const scv_tr_handle& t, const char* name
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    recordAttributes<DB>(t.get_id(), RECORD, name == nullptr ? "" : name, ext);
+    recordAttributes<DB>(t.get_id(), RECORD, DB::get().attributes.get_record_layout(name), ext);
 }
 // ----------------------------------------------------------------------------
 template <typename DB>
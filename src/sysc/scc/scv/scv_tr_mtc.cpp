@@ -14,18 +14,20 @@
  * limitations under the License.
  *******************************************************************************/
 #include <array>
-#include <boost/filesystem.hpp>
-#include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
-#include <fcntl.h>
+#include <deque>
+#include <fmt/format.h>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <thread>
+#include <util/lz4_streambuf.h>
 #include <vector>
 // clang-format off
 #ifdef HAS_SCV
@@ -44,85 +46,228 @@ enum EventType { BEGIN, RECORD, END };
 using data_type = scv_extensions_if::data_type;
 // ----------------------------------------------------------------------------
 namespace {
-class Base {
-protected:
-    boost::filesystem::path dir;
-    std::ofstream out;
-    bool const is_open;
-    std::array<char, 1024> buffer;
-    Base(const std::string& name)
-    : dir(name.c_str())
-    , out(name)
-    , is_open(out.is_open()) {
-        //        if(boost::filesystem::exists(dir))
-        //            boost::filesystem::remove_all(dir);
-        //        boost::filesystem::create_directory(dir);
+const std::array<char const*, scv_extensions_if::STRING + 1> data_type_str = {{
+    "BOOLEAN",                      // bool
+    "ENUMERATION",                  // enum
+    "INTEGER",                      // char, short, int, long, long long, sc_int, sc_bigint
+    "UNSIGNED",                     // unsigned { char, short, int, long, long long }, sc_uint, sc_biguint
+    "FLOATING_POINT_NUMBER",        // float, double
+    "BIT_VECTOR",                   // sc_bit, sc_bv
+    "LOGIC_VECTOR",                 // sc_logic, sc_lv
+    "FIXED_POINT_INTEGER",          // sc_fixed
+    "UNSIGNED_FIXED_POINT_INTEGER", // sc_ufixed
+    "RECORD",                       // struct/class
+    "POINTER",                      // T*
+    "ARRAY",                        // T[N]
+    "STRING"                        // string, std::string
+}};
+/**
+ * @brief LZ4 compressing writer running in its own thread
+ *
+ * The formatted text is handed over in chunks, the writer thread compresses and writes them in the order they were
+ * submitted. Written chunks are returned to a pool so that the producer can reuse their memory. At most max_pending
+ * chunks wait for the writer thread, if it falls behind the producer blocks until one is written.
+ */
+class Compressor {
+public:
+    //! the maximum number of chunks waiting for the writer thread
+    static constexpr size_t max_pending = 64;
+
+    Compressor(const std::string& name)
+    : ofs(name, std::ios::binary | std::ios::trunc)
+    , strbuf(new util::lz4c_steambuf(ofs, 1 << 16))
+    , out(strbuf.get())
+    , worker([this]() { run(); }) {}
+
+    ~Compressor() {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            done = true;
+        }
+        cond.notify_one();
+        worker.join();
+        if(ofs.is_open()) {
+            strbuf->close();
+            ofs.close();
+        }
+    }
+
+    bool is_open() const { return ofs.is_open(); }
+
+    void write(fmt::memory_buffer&& buf) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            space.wait(lock, [this]() { return pending.size() < max_pending; });
+            pending.emplace_back(std::move(buf));
+        }
+        cond.notify_one();
     }
-    ~Base() {
-        if(is_open)
-            out.close();
+
+    fmt::memory_buffer get_buffer() {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(pool.empty())
+            return fmt::memory_buffer();
+        auto res = std::move(pool.back());
+        pool.pop_back();
+        return res;
     }
+
+private:
+    void run() {
+        for(;;) {
+            fmt::memory_buffer buf;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cond.wait(lock, [this]() { return done || !pending.empty(); });
+                if(pending.empty())
+                    return;
+                buf = std::move(pending.front());
+                pending.pop_front();
+            }
+            space.notify_one();
+            if(ofs.is_open())
+                out.write(buf.data(), buf.size());
+            buf.clear();
+            std::unique_lock<std::mutex> lock(mtx);
+            pool.emplace_back(std::move(buf));
+        }
+    }
+
+    std::ofstream ofs;
+    std::unique_ptr<util::lz4c_steambuf> strbuf;
+    std::ostream out;
+    std::mutex mtx;
+    std::condition_variable cond;
+    //! notified when the writer thread took a chunk from pending
+    std::condition_variable space;
+    std::deque<fmt::memory_buffer> pending;
+    std::vector<fmt::memory_buffer> pool;
+    bool done{false};
+    std::thread worker;
 };
+/**
+ * @brief formats the records using the text schema of scv_tr_compressed
+ *
+ * The records are formatted into a buffer owned by the simulation thread, full buffers are passed to the Compressor.
+ */
+struct Database {
+    static constexpr size_t chunk_size = 1 << 16;
+    Compressor compressor;
+    fmt::memory_buffer buf;
 
-struct Database : Base {
-    uint64_t idx{0};
     Database(const std::string& name)
-    : Base(name) {}
+    : compressor(name) {}
+
+    ~Database() { flush(); }
 
-    inline uint64_t getIdOf(const std::string& str) { return idx; }
+    inline bool is_open() const { return compressor.is_open(); }
 
-    inline void writeStream(uint64_t id, std::string const& name, std::string const& kind) {
-        if(is_open) {
-            auto len = sprintf(buffer.data(), "scv_tr_stream (ID %lu, name \"%s\", kind \"%s\")\n", id, name.c_str(), kind.c_str());
-            out.write(buffer.data(), len);
+    inline void flush() {
+        if(buf.size()) {
+            compressor.write(std::move(buf));
+            buf = compressor.get_buffer();
         }
     }
 
-    inline void writeGenerator(uint64_t id, std::string const& name, uint64_t stream) {
-        if(is_open) {
-            auto len = sprintf(buffer.data(), "scv_tr_generator (ID %lu, name \"%s\", scv_tr_stream %lu,\n", id, name.c_str(), stream);
-            out.write(buffer.data(), len);
-        }
+    inline void check_flush() {
+        if(buf.size() >= chunk_size)
+            flush();
     }
 
-    inline uint64_t writeTransaction(uint64_t id, uint64_t generator) {
-        return ++idx; // d.writeTx(id, generator, concurrencyLevel);
+    inline void writeStream(uint64_t id, char const* name, char const* kind) {
+        fmt::format_to(std::back_inserter(buf), "scv_tr_stream (ID {}, name \"{}\", kind \"{}\")\n", id, name,
+                       kind ? kind : "<no_stream_kind>");
+        check_flush();
     }
 
-    inline void writeTxTimepoint(uint64_t id, int type, uint64_t time, uint64_t file_offset) {
-        //        t.append(type, time, file_offset);
+    inline void writeGeneratorBegin(uint64_t id, char const* name, uint64_t stream) {
+        fmt::format_to(std::back_inserter(buf), "scv_tr_generator (ID {}, name \"{}\", scv_tr_stream {},\n", id, name, stream);
     }
 
-    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, const string& value) {
-        //        d.writeAttribute(id, event, c.getIdOf(name), type, c.getIdOf(value));
+    inline void writeAttributeDecl(char const* kind, unsigned idx, std::string const& name, data_type type, int bits) {
+        if(type == scv_extensions_if::BIT_VECTOR || type == scv_extensions_if::LOGIC_VECTOR)
+            fmt::format_to(std::back_inserter(buf), "{} (ID {}, name \"{}\", type \"{}[{}]\")\n", kind, idx, name, data_type_str[type], bits);
+        else
+            fmt::format_to(std::back_inserter(buf), "{} (ID {}, name \"{}\", type \"{}\")\n", kind, idx, name, data_type_str[type]);
+    }
+
+    inline void writeGeneratorEnd() {
+        fmt::format_to(std::back_inserter(buf), ")\n");
+        check_flush();
+    }
+
+    inline void writeTransaction(uint64_t id, uint64_t generator, EventType type, uint64_t time) {
+        if(type == BEGIN)
+            fmt::format_to(std::back_inserter(buf), "tx_begin {} {} {} ps\n", id, generator, time);
+        else
+            fmt::format_to(std::back_inserter(buf), "tx_end {} {} {} ps\n", id, generator, time);
+        check_flush();
+    }
+
+    inline void writeAttributePrefix(uint64_t id, EventType event, const string& name, data_type type) {
+        if(event == RECORD)
+            fmt::format_to(std::back_inserter(buf), "tx_record_attribute {} \"{}\" {} = ", id, name, data_type_str[type]);
+        else
+            fmt::format_to(std::back_inserter(buf), "a ");
+    }
+
+    inline void writeUndefined() {
+        fmt::format_to(std::back_inserter(buf), "a UNDEFINED\n");
+        check_flush();
+    }
+
+    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, char const* value) {
+        writeAttributePrefix(id, event, name, type);
+        fmt::format_to(std::back_inserter(buf), "\"{}\"\n", value);
+        check_flush();
+    }
+
+    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, bool value) {
+        writeAttributePrefix(id, event, name, type);
+        fmt::format_to(std::back_inserter(buf), "{}\n", value ? "true" : "false");
+        check_flush();
+    }
+
+    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, int64_t value) {
+        writeAttributePrefix(id, event, name, type);
+        fmt::format_to(std::back_inserter(buf), "{}\n", value);
+        check_flush();
     }
 
     inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, uint64_t value) {
-        //        d.writeAttribute(id, event, c.getIdOf(name), type, value);
+        writeAttributePrefix(id, event, name, type);
+        fmt::format_to(std::back_inserter(buf), "{}\n", value);
+        check_flush();
     }
 
     inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, double value) {
-        //        int exponent;
-        //        const double mantissa = frexp(value, &exponent);
+        writeAttributePrefix(id, event, name, type);
+        fmt::format_to(std::back_inserter(buf), "{:f}\n", value);
+        check_flush();
     }
 
-    inline void writeRelation(const std::string& name, uint64_t sink_id, uint64_t src_id) {
-        //        d.writeRelation(c.getIdOf(name), src_id, sink_id);
+    inline void writeRelation(char const* name, uint64_t sink_id, uint64_t src_id) {
+        fmt::format_to(std::back_inserter(buf), "tx_relation \"{}\" {} {}\n", name, sink_id, src_id);
+        check_flush();
     }
 };
 
 Database* db;
-std::unordered_map<uint64_t, uint64_t> id2offset;
 
 void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
     // This is called from the scv_tr_db ctor.
-    static string fName("DEFAULT_scv_tr_sqlite");
+    static string fName("DEFAULT_scv_tr_mtc");
     switch(reason) {
     case scv_tr_db::CREATE:
         if((_scv_tr_db.get_name() != nullptr) && (strlen(_scv_tr_db.get_name()) != 0))
             fName = _scv_tr_db.get_name();
         try {
             db = new Database(fName);
+            if(!db->is_open()) {
+                delete db;
+                db = nullptr;
+                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't open recording file");
+            }
         } catch(...) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't open recording file");
         }
@@ -130,6 +275,7 @@ void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void*
     case scv_tr_db::DELETE:
         try {
             delete db;
+            db = nullptr;
         } catch(...) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
         }
@@ -140,44 +286,12 @@ void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void*
 }
 // ----------------------------------------------------------------------------
 void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, void* data) {
-    if(reason == scv_tr_stream::CREATE) {
-        try {
-            db->writeStream(s.get_id(), s.get_name(), s.get_stream_kind());
-        } catch(std::runtime_error& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create stream");
-        }
-    }
-}
-// ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, const string& value) {
-    try {
-        db->writeAttribute(id, event, name, type, value);
-    } catch(std::runtime_error& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
+    if(db && reason == scv_tr_stream::CREATE) {
+        db->writeStream(s.get_id(), s.get_name(), s.get_stream_kind());
     }
 }
 // ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, long long value) {
-    try {
-        db->writeAttribute(id, event, name, type, static_cast<uint64_t>(value));
-    } catch(std::runtime_error& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-    }
-}
-// ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, double value) {
-    try {
-        db->writeAttribute(id, event, name, type, value);
-    } catch(std::runtime_error& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-    }
-}
-
 inline std::string get_name(const char* prefix, const scv_extensions_if* my_exts_p) {
-    static thread_local std::unordered_map<const scv_extensions_if*, std::string> name_lut;
-    auto it = name_lut.find(my_exts_p);
-    if(it != name_lut.end())
-        return it->second;
     string name;
     if(!prefix || strlen(prefix) == 0) {
         name = my_exts_p->get_name();
@@ -185,81 +299,115 @@ inline std::string get_name(const char* prefix, const scv_extensions_if* my_exts
         if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
             name = prefix;
         } else {
-            name = std::string(prefix) + "." + my_exts_p->get_name();
+            name = fmt::format("{}.{}", prefix, my_exts_p->get_name());
         }
     }
-    name_lut[my_exts_p] = (name == "") ? "<unnamed>" : name;
-    return (name == "") ? "<unnamed>" : name;
+    return (name == "") ? "<anonymous>" : name;
 }
-
 // ----------------------------------------------------------------------------
-void recordAttributes(uint64_t id, EventType eventType, char const* prefix, const scv_extensions_if* my_exts_p) {
+//! the way recordAttributes handles the leaf attributes
+enum AttrMode {
+    DECLARE,   //!< write the attribute declaration of the generator header
+    UNDEFINED, //!< write a placeholder value as the transaction uses the generator defaults
+    VALUE      //!< write the value
+};
+// ----------------------------------------------------------------------------
+void recordAttributes(AttrMode mode, uint64_t id, EventType eventType, char const* prefix, const scv_extensions_if* my_exts_p,
+                      unsigned& index) {
     if(my_exts_p == nullptr)
         return;
-    auto name = get_name(prefix, my_exts_p);
-    switch(my_exts_p->get_type()) {
+    auto type = my_exts_p->get_type();
+    switch(type) {
     case scv_extensions_if::RECORD: {
         int num_fields = my_exts_p->get_num_fields();
-        if(num_fields > 0) {
-            for(int field_counter = 0; field_counter < num_fields; field_counter++) {
-                const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
-                recordAttributes(id, eventType, prefix, field_data_p);
-            }
+        for(int field_counter = 0; field_counter < num_fields; field_counter++) {
+            const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
+            recordAttributes(mode, id, eventType, prefix, field_data_p, index);
         }
-    } break;
+        return;
+    }
+    case scv_extensions_if::ARRAY:
+        for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
+            const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
+            recordAttributes(mode, id, eventType, prefix, field_data_p, index);
+        }
+        return;
+    case scv_extensions_if::ENUMERATION:
+    case scv_extensions_if::BOOLEAN:
+    case scv_extensions_if::INTEGER:
+    case scv_extensions_if::FIXED_POINT_INTEGER:
+    case scv_extensions_if::UNSIGNED:
+    case scv_extensions_if::POINTER:
+    case scv_extensions_if::STRING:
+    case scv_extensions_if::FLOATING_POINT_NUMBER:
+    case scv_extensions_if::BIT_VECTOR:
+    case scv_extensions_if::LOGIC_VECTOR:
+        break;
+    default: {
+        std::array<char, 100> tmpString;
+        sprintf(tmpString.data(), "Unsupported attribute type = %d", type);
+        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
+        return;
+    }
+    }
+    if(type == scv_extensions_if::FIXED_POINT_INTEGER)
+        type = scv_extensions_if::INTEGER;
+    if(mode == DECLARE) {
+        db->writeAttributeDecl(eventType == BEGIN ? "begin_attribute" : "end_attribute", index++, get_name(prefix, my_exts_p), type,
+                               my_exts_p->get_bitwidth());
+        return;
+    }
+    if(mode == UNDEFINED) {
+        db->writeUndefined();
+        return;
+    }
+    auto name = eventType == RECORD ? get_name(prefix, my_exts_p) : std::string();
+    switch(type) {
     case scv_extensions_if::ENUMERATION:
-        recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
+        db->writeAttribute(id, eventType, name, type, my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
         break;
     case scv_extensions_if::BOOLEAN:
-        recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, my_exts_p->get_bool() ? "TRUE" : "FALSE");
+        db->writeAttribute(id, eventType, name, type, my_exts_p->get_bool());
         break;
     case scv_extensions_if::INTEGER:
-    case scv_extensions_if::FIXED_POINT_INTEGER:
-        recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, my_exts_p->get_integer());
+        db->writeAttribute(id, eventType, name, type, static_cast<int64_t>(my_exts_p->get_integer()));
         break;
     case scv_extensions_if::UNSIGNED:
-        recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, my_exts_p->get_integer());
+        db->writeAttribute(id, eventType, name, type, static_cast<uint64_t>(my_exts_p->get_unsigned()));
         break;
     case scv_extensions_if::POINTER:
-        recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)my_exts_p->get_pointer());
+        db->writeAttribute(id, eventType, name, type, static_cast<int64_t>(reinterpret_cast<intptr_t>(my_exts_p->get_pointer())));
         break;
     case scv_extensions_if::STRING:
-        recordAttribute(id, eventType, name, scv_extensions_if::STRING, my_exts_p->get_string());
+        db->writeAttribute(id, eventType, name, type, my_exts_p->get_string().c_str());
         break;
     case scv_extensions_if::FLOATING_POINT_NUMBER:
-        recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, my_exts_p->get_double());
+        db->writeAttribute(id, eventType, name, type, my_exts_p->get_double());
         break;
     case scv_extensions_if::BIT_VECTOR: {
         sc_bv_base tmp_bv(my_exts_p->get_bitwidth());
         my_exts_p->get_value(tmp_bv);
-        recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
+        db->writeAttribute(id, eventType, name, type, tmp_bv.to_string().c_str());
     } break;
     case scv_extensions_if::LOGIC_VECTOR: {
         sc_lv_base tmp_lv(my_exts_p->get_bitwidth());
         my_exts_p->get_value(tmp_lv);
-        recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
+        db->writeAttribute(id, eventType, name, type, tmp_lv.to_string().c_str());
     } break;
-    case scv_extensions_if::ARRAY:
-        for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
-            const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
-            recordAttributes(id, eventType, prefix, field_data_p);
-        }
-        break;
-    default: {
-        std::array<char, 100> tmpString;
-        sprintf(tmpString.data(), "Unsupported attribute type = %d", my_exts_p->get_type());
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
-    }
+    default:;
     }
 }
 // ----------------------------------------------------------------------------
 void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
     if(reason == scv_tr_generator_base::CREATE && db) {
-        try {
-            db->writeGenerator(g.get_id(), g.get_name(), g.get_scv_tr_stream().get_id());
-        } catch(std::runtime_error& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create generator entry");
-        }
+        db->writeGeneratorBegin(g.get_id(), g.get_name(), g.get_scv_tr_stream().get_id());
+        unsigned index = 0;
+        if(auto my_begin_exts_p = g.get_begin_exts_p())
+            recordAttributes(DECLARE, g.get_id(), BEGIN, g.get_begin_attribute_name() ? g.get_begin_attribute_name() : "", my_begin_exts_p,
+                             index);
+        if(auto my_end_exts_p = g.get_end_exts_p())
+            recordAttributes(DECLARE, g.get_id(), END, g.get_end_attribute_name() ? g.get_end_attribute_name() : "", my_end_exts_p, index);
+        db->writeGeneratorEnd();
     }
 }
 // ----------------------------------------------------------------------------
@@ -272,28 +420,28 @@ void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason
         return;
 
     uint64_t id = t.get_id();
-    vector<uint64_t>::size_type concurrencyIdx;
-    const scv_extensions_if* my_exts_p;
+    auto& gen = t.get_scv_tr_generator_base();
+    unsigned index = 0;
     switch(reason) {
     case scv_tr_handle::BEGIN: {
-        my_exts_p = t.get_begin_exts_p();
-        if(my_exts_p == nullptr)
-            my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-            recordAttributes(id, BEGIN, tmp_str, my_exts_p);
+        db->writeTransaction(id, gen.get_id(), BEGIN, t.get_begin_sc_time() / sc_core::sc_time(1, sc_core::SC_PS));
+        auto my_exts_p = t.get_begin_exts_p();
+        auto mode = VALUE;
+        if(my_exts_p == nullptr) {
+            my_exts_p = gen.get_begin_exts_p();
+            mode = UNDEFINED;
         }
+        recordAttributes(mode, id, BEGIN, gen.get_begin_attribute_name() ? gen.get_begin_attribute_name() : "", my_exts_p, index);
     } break;
     case scv_tr_handle::END: {
-        my_exts_p = t.get_end_exts_p();
-        if(my_exts_p == nullptr)
-            my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-            recordAttributes(t.get_id(), END, tmp_str, my_exts_p);
+        db->writeTransaction(id, gen.get_id(), END, t.get_end_sc_time() / sc_core::sc_time(1, sc_core::SC_PS));
+        auto my_exts_p = t.get_end_exts_p();
+        auto mode = VALUE;
+        if(my_exts_p == nullptr) {
+            my_exts_p = gen.get_end_exts_p();
+            mode = UNDEFINED;
         }
+        recordAttributes(mode, id, END, gen.get_end_attribute_name() ? gen.get_end_attribute_name() : "", my_exts_p, index);
     } break;
     default:;
     }
@@ -306,7 +454,8 @@ void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    recordAttributes(t.get_id(), RECORD, name == nullptr ? "" : name, ext);
+    unsigned index = 0;
+    recordAttributes(VALUE, t.get_id(), RECORD, name == nullptr ? "" : name, ext, index);
 }
 // ----------------------------------------------------------------------------
 void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
@@ -316,11 +465,7 @@ void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data
         return;
     if(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    try {
-        db->writeRelation(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_relation_name(relation_handle), tr_1.get_id(), tr_2.get_id());
-    } catch(std::runtime_error& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction relation");
-    }
+    db->writeRelation(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_relation_name(relation_handle), tr_1.get_id(), tr_2.get_id());
 }
 } // namespace
 // ----------------------------------------------------------------------------
@@ -0,0 +1,317 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#include "scv_tr_attributes.h"
+#include "scv_tr_raw.h"
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ftr/ftr_writer.h>
+#include <string>
+#include <unordered_map>
+#include <util/mmap_log.h>
+#include <vector>
+// clang-format off
+#ifdef HAS_SCV
+#include <scv.h>
+#else
+#include <scv-tr.h>
+namespace scv_tr {
+#endif
+// clang-format on
+// ----------------------------------------------------------------------------
+using namespace std;
+// ----------------------------------------------------------------------------
+namespace {
+using namespace scc::txraw;
+
+util::mmap_log_writer txlog;
+unordered_map<string, uint64_t> names;
+scv_tr_attribute_registry attributes;
+
+inline void write(record const& rec, char const* str = nullptr, size_t len = 0) {
+    static char const zeros[8]{};
+    txlog.append(&rec, sizeof(record));
+    if(str) {
+        txlog.append(str, len);
+        txlog.append(zeros, padded(len) - len);
+    }
+}
+
+uint64_t getNameId(string const& s) {
+    auto it = names.find(s);
+    if(it != end(names))
+        return it->second;
+    auto id = names.size();
+    names.insert({s, id});
+    record rec{NAME, 0, 0, STRING_VALUE, static_cast<uint32_t>(id), {s.size(), 0, 0, 0}};
+    write(rec, s.data(), s.size());
+    return id;
+}
+// ----------------------------------------------------------------------------
+void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
+    // This is called from the scv_tr_db ctor.
+    static string fName("DEFAULT_scv_tr_raw");
+    switch(reason) {
+    case scv_tr_db::CREATE:
+        if((_scv_tr_db.get_name() != nullptr) && (strlen(_scv_tr_db.get_name()) != 0))
+            fName = _scv_tr_db.get_name();
+        if(!txlog.open(fName)) {
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't open recording file");
+        } else {
+            file_header hdr{};
+            memcpy(hdr.magic, file_magic, sizeof(file_magic));
+            hdr.tick_ps = sc_core::sc_time::from_value(1ULL) / sc_core::sc_time(1, sc_core::SC_PS);
+            hdr.time_exp = static_cast<int64_t>(rint(log10(sc_core::sc_time::from_value(1ULL).to_seconds())));
+            txlog.append(&hdr, sizeof(hdr));
+        }
+        break;
+    case scv_tr_db::DELETE:
+        if(!txlog.close())
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL,
+                                  "Could not map the recording file while writing, the recording is incomplete");
+        names.clear();
+        attributes.clear();
+        break;
+    default:
+        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Unknown reason in scv_tr_db callback");
+    }
+}
+// ----------------------------------------------------------------------------
+void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, void* data) {
+    if(reason == scv_tr_stream::CREATE && txlog.is_open()) {
+        auto name = static_cast<uint32_t>(getNameId(s.get_name()));
+        record rec{STREAM, 0, 0, STRING_VALUE, name, {s.get_id(), getNameId(s.get_stream_kind() ? s.get_stream_kind() : ""), 0, 0}};
+        write(rec);
+    }
+}
+// ----------------------------------------------------------------------------
+inline void recordAttribute(uint64_t id, ftr::event_type event, uint64_t name, ftr::data_type type, value_kind vkind, uint64_t value) {
+    record rec{
+        ATTRIBUTE, static_cast<uint8_t>(event), static_cast<uint8_t>(type), vkind, static_cast<uint32_t>(name), {id, value, 0, 0}};
+    write(rec);
+}
+// ----------------------------------------------------------------------------
+inline void recordAttribute(uint64_t id, ftr::event_type event, uint64_t name, ftr::data_type type, char const* value, size_t len) {
+    record rec{ATTRIBUTE,
+                   static_cast<uint8_t>(event),
+                   static_cast<uint8_t>(type),
+                   STRING_VALUE,
+                   static_cast<uint32_t>(name),
+                   {id, 0, len, 0}};
+    write(rec, value, len);
+}
+// ----------------------------------------------------------------------------
+void recordAttributes(uint64_t id, ftr::event_type eventType, scv_tr_attribute_layout& layout, const scv_extensions_if* my_exts_p) {
+    if(my_exts_p == nullptr)
+        return;
+    layout.visit(my_exts_p, getNameId, [id, eventType](scv_tr_attribute_layout::leaf const& attr, const scv_extensions_if* ext) {
+        switch(attr.type) {
+        case scv_extensions_if::ENUMERATION: {
+            auto* str = ext->get_enum_string((int)(ext->get_integer()));
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::ENUMERATION, str, str ? strlen(str) : 0);
+        } break;
+        case scv_extensions_if::BOOLEAN:
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::BOOLEAN, BOOL_VALUE, ext->get_bool());
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER:
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::INTEGER, INTEGER_VALUE, ext->get_integer());
+            break;
+        case scv_extensions_if::UNSIGNED:
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::UNSIGNED, INTEGER_VALUE, ext->get_integer());
+            break;
+        case scv_extensions_if::POINTER:
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::POINTER, INTEGER_VALUE, (uint64_t)ext->get_pointer());
+            break;
+        case scv_extensions_if::STRING: {
+            auto str = ext->get_string();
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::STRING, str.data(), str.size());
+        } break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER: {
+            auto d = ext->get_double();
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(d));
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::FLOATING_POINT_NUMBER, REAL_VALUE, bits);
+        } break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(ext->get_bitwidth());
+            ext->get_value(tmp_bv);
+            auto str = tmp_bv.to_string();
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::BIT_VECTOR, str.data(), str.size());
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(ext->get_bitwidth());
+            ext->get_value(tmp_lv);
+            auto str = tmp_lv.to_string();
+            recordAttribute(id, eventType, attr.name_id, ftr::data_type::LOGIC_VECTOR, str.data(), str.size());
+        } break;
+        default: {
+            std::array<char, 100> tmpString{};
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", ext->get_type());
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
+        }
+        }
+    });
+}
+// ----------------------------------------------------------------------------
+void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
+    if(reason == scv_tr_generator_base::CREATE && txlog.is_open()) {
+        auto name = static_cast<uint32_t>(getNameId(g.get_name()));
+        record rec{GENERATOR, 0, 0, STRING_VALUE, name, {g.get_id(), g.get_scv_tr_stream().get_id(), 0, 0}};
+        write(rec);
+        attributes.add_generator(g, getNameId);
+    }
+}
+// ----------------------------------------------------------------------------
+void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason, void* data) {
+    if(!txlog.is_open() || !t.get_scv_tr_stream().get_scv_tr_db() || !t.get_scv_tr_stream().get_scv_tr_db()->get_recording())
+        return;
+    uint64_t id = t.get_id();
+    const scv_extensions_if* my_exts_p;
+    switch(reason) {
+    case scv_tr_handle::BEGIN: {
+        auto& gen = t.get_scv_tr_generator_base();
+        record rec{
+            TX_BEGIN, 0, 0, STRING_VALUE, 0, {id, gen.get_id(), gen.get_scv_tr_stream().get_id(), t.get_begin_sc_time().value()}};
+        write(rec);
+        my_exts_p = t.get_begin_exts_p();
+        if(my_exts_p == nullptr)
+            my_exts_p = gen.get_begin_exts_p();
+        recordAttributes(id, ftr::event_type::BEGIN, attributes.get_generator_layout(gen, true), my_exts_p);
+    } break;
+    case scv_tr_handle::END: {
+        auto& gen = t.get_scv_tr_generator_base();
+        my_exts_p = t.get_end_exts_p();
+        if(my_exts_p == nullptr)
+            my_exts_p = gen.get_end_exts_p();
+        recordAttributes(id, ftr::event_type::END, attributes.get_generator_layout(gen, false), my_exts_p);
+        record rec{TX_END, 0, 0, STRING_VALUE, 0, {id, 0, 0, t.get_end_sc_time().value()}};
+        write(rec);
+    } break;
+    default:;
+    }
+}
+// ----------------------------------------------------------------------------
+void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_if* ext, void* data) {
+    if(!txlog.is_open() || !t.get_scv_tr_stream().get_scv_tr_db() || !t.get_scv_tr_stream().get_scv_tr_db()->get_recording())
+        return;
+    recordAttributes(t.get_id(), ftr::event_type::RECORD, attributes.get_record_layout(name), ext);
+}
+// ----------------------------------------------------------------------------
+void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
+    auto txdb = tr_1.get_scv_tr_stream().get_scv_tr_db();
+    if(!txlog.is_open() || !txdb || !txdb->get_recording())
+        return;
+    auto name = static_cast<uint32_t>(getNameId(txdb->get_relation_name(relation_handle)));
+    auto s1 = tr_1.get_scv_tr_stream().get_id();
+    auto s2 = tr_2.get_scv_tr_stream().get_id();
+    record rec{RELATION, 0, 0, STRING_VALUE, name, {s1, tr_1.get_id(), s2, tr_2.get_id()}};
+    write(rec);
+}
+// ----------------------------------------------------------------------------
+template <bool COMPRESSED> bool convert(char const* data, size_t size, char const* out_name) {
+    ftr::ftr_writer<COMPRESSED> db(out_name);
+    if(!db.cw.enc.ofs.is_open())
+        return false;
+    file_header hdr;
+    memcpy(&hdr, data, sizeof(hdr));
+    db.writeInfo(static_cast<int8_t>(hdr.time_exp));
+    vector<string> name_tbl;
+    string str;
+    record_reader reader(data, size);
+    record rec;
+    char const* str_data;
+    size_t len;
+    while(reader.next(rec, str_data, len)) {
+        if(len)
+            str.assign(str_data, len);
+        if(rec.kind != NAME && rec.kind != TX_BEGIN && rec.kind != TX_END && rec.name >= name_tbl.size())
+            return false;
+        switch(rec.kind) {
+        case NAME:
+            if(name_tbl.size() <= rec.name)
+                name_tbl.resize(rec.name + 1);
+            name_tbl[rec.name] = len ? str : string();
+            break;
+        case STREAM:
+            db.writeStream(rec.v[0], name_tbl[rec.name].c_str(), rec.v[1] < name_tbl.size() ? name_tbl[rec.v[1]].c_str() : "");
+            break;
+        case GENERATOR:
+            db.writeGenerator(rec.v[0], name_tbl[rec.name].c_str(), rec.v[1]);
+            break;
+        case TX_BEGIN:
+            db.startTransaction(rec.v[0], rec.v[1], rec.v[2], rec.v[3] * hdr.tick_ps);
+            break;
+        case TX_END:
+            db.endTransaction(rec.v[0], rec.v[3] * hdr.tick_ps);
+            break;
+        case ATTRIBUTE: {
+            auto event = static_cast<ftr::event_type>(rec.event);
+            auto type = static_cast<ftr::data_type>(rec.type);
+            switch(rec.vkind) {
+            case STRING_VALUE:
+                if(!len)
+                    str.clear();
+                db.writeAttribute(rec.v[0], event, name_tbl[rec.name], type, str);
+                break;
+            case BOOL_VALUE:
+                db.writeAttribute(rec.v[0], event, name_tbl[rec.name], type, rec.v[1] != 0);
+                break;
+            case INTEGER_VALUE:
+                db.writeAttribute(rec.v[0], event, name_tbl[rec.name], type, static_cast<long long>(rec.v[1]));
+                break;
+            case REAL_VALUE: {
+                double d;
+                memcpy(&d, &rec.v[1], sizeof(d));
+                db.writeAttribute(rec.v[0], event, name_tbl[rec.name], type, d);
+            } break;
+            }
+        } break;
+        case RELATION:
+            db.writeRelation(name_tbl[rec.name].c_str(), rec.v[0], rec.v[1], rec.v[2], rec.v[3]);
+            break;
+        default:
+            break;
+        }
+    }
+    return !reader.failed();
+}
+} // namespace
+// ----------------------------------------------------------------------------
+void scv_tr_raw_init() {
+    scv_tr_db::register_class_cb(dbCb);
+    scv_tr_stream::register_class_cb(streamCb);
+    scv_tr_generator_base::register_class_cb(generatorCb);
+    scv_tr_handle::register_class_cb(transactionCb);
+    scv_tr_handle::register_record_attribute_cb(attributeCb);
+    scv_tr_handle::register_relation_cb(relationCb);
+}
+// ----------------------------------------------------------------------------
+bool scv_tr_raw_convert(char const* in_name, char const* out_name, bool compressed) {
+    util::mmap_file_reader in(in_name);
+    if(!in.is_open() || in.size() < sizeof(file_header) || memcmp(in.data(), file_magic, sizeof(file_magic)) != 0)
+        return false;
+    try {
+        return compressed ? convert<true>(in.data(), in.size(), out_name) : convert<false>(in.data(), in.size(), out_name);
+    } catch(...) {
+        return false;
+    }
+}
+// ----------------------------------------------------------------------------
+#ifndef HAS_SCV
+}
+#endif
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_SCV_TR_RAW_H_
+#define _SCC_SCV_TR_RAW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/** \ingroup scc-sysc
+ *  @{
+ */
+/**@{*/
+//! @brief SCC SystemC utilities
+namespace scc {
+/**
+ * @brief the layout of the raw transaction log written by scv_tr_raw_init()
+ *
+ * The raw log consists of a file header followed by fixed size records. Strings (names and string values) follow their
+ * record padded to a multiple of 8 bytes. Names are written once as NAME record and referenced by their id. A record
+ * kind of 0 marks the end of the log, it is seen if the simulation did not close the database.
+ *
+ * An indexed log (as written by tx_db_merger) has an END_OF_LOG record behind the last record followed by an array of
+ * index_entry and an index_trailer at the very end of the file.
+ */
+namespace txraw {
+//! the magic number at the start of a raw log
+constexpr char file_magic[8] = {'S', 'C', 'C', '-', 'T', 'X', 'R', '1'};
+//! the magic number at the end of an indexed raw log
+constexpr char index_magic[8] = {'S', 'C', 'C', '-', 'T', 'X', 'I', '1'};
+
+struct file_header {
+    char magic[8];
+    //! the length of a time tick in ps
+    double tick_ps;
+    //! the exponent of the time resolution in seconds
+    int64_t time_exp;
+    uint64_t reserved;
+};
+
+enum record_kind : uint8_t { END_OF_LOG = 0, NAME, STREAM, GENERATOR, TX_BEGIN, TX_END, ATTRIBUTE, RELATION };
+
+enum value_kind : uint8_t { STRING_VALUE, BOOL_VALUE, INTEGER_VALUE, REAL_VALUE };
+
+struct record {
+    record_kind kind;
+    //! the ftr::event_type of an attribute
+    uint8_t event;
+    //! the ftr::data_type of an attribute
+    uint8_t type;
+    value_kind vkind;
+    //! the id of the name of the item
+    uint32_t name;
+    /*
+     * NAME:      length of the string
+     * STREAM:    stream id, id of the kind name
+     * GENERATOR: generator id, stream id
+     * TX_BEGIN:  tx id, generator id, stream id, time
+     * TX_END:    tx id, -, -, time
+     * ATTRIBUTE: tx id, value (bool, int64 or double bits), length of a string value
+     * RELATION:  stream id 1, tx id 1, stream id 2, tx id 2
+     */
+    uint64_t v[4];
+};
+static_assert(sizeof(record) == 40, "unexpected raw record layout");
+//! an entry of the time index describing a block of records
+struct index_entry {
+    //! the file offset of the first record of the block
+    uint64_t offset;
+    //! the smallest begin or end time of a transaction in the block
+    uint64_t min_time;
+    //! the largest begin or end time of a transaction in the block
+    uint64_t max_time;
+    //! the number of records in the block
+    uint32_t records;
+    //! index_flags of the block
+    uint32_t flags;
+};
+//! the block contains NAME, STREAM or GENERATOR records
+constexpr uint32_t HAS_DEFINITIONS = 1;
+
+struct index_trailer {
+    //! the file offset of the first index_entry
+    uint64_t index_offset;
+    //! the number of index entries
+    uint64_t entries;
+    char magic[8];
+};
+//! the size of a string in the log
+inline size_t padded(size_t len) { return (len + 7) & ~size_t(7); }
+//! the length of the string following a record
+inline size_t string_length(record const& rec) {
+    return rec.kind == NAME ? rec.v[0] : rec.kind == ATTRIBUTE && rec.vkind == STRING_VALUE ? rec.v[2] : 0;
+}
+/**
+ * @brief iterates over the records of a raw log in memory
+ */
+class record_reader {
+public:
+    /**
+     * @brief constructor
+     *
+     * @param data the content of the log
+     * @param size the size of the content
+     * @param pos the offset of the first record to read, by default the one following the file header
+     */
+    record_reader(char const* data, size_t size, size_t pos = sizeof(file_header))
+    : data(data)
+    , size(size)
+    , pos(pos) {}
+    /**
+     * @brief reads the next record
+     *
+     * @param rec the record
+     * @param str the string following the record (or nullptr)
+     * @param len the length of the string
+     * @return false at the end of the log or if the record is malformed, see failed()
+     */
+    bool next(record& rec, char const*& str, size_t& len) {
+        if(pos + sizeof(record) > size)
+            return false;
+        std::memcpy(&rec, data + pos, sizeof(record));
+        // the rest of the file is the unwritten tail of a log which has not been closed or the index
+        if(rec.kind == END_OF_LOG)
+            return false;
+        if(rec.kind > RELATION) {
+            error = true;
+            return false;
+        }
+        len = string_length(rec);
+        // a string cut off by the end of file is the last record of a log which has not been closed
+        if(len > size - pos - sizeof(record))
+            return false;
+        str = len ? data + pos + sizeof(record) : nullptr;
+        pos += sizeof(record) + padded(len);
+        return true;
+    }
+    //! the offset of the next record
+    size_t position() const { return pos; }
+    //! true if a malformed record has been found
+    bool failed() const { return error; }
+
+private:
+    char const* data;
+    size_t size;
+    size_t pos;
+    bool error{false};
+};
+} // namespace txraw
+} // namespace scc
+/** @} */ // end of scc-sysc
+#endif    /* _SCC_SCV_TR_RAW_H_ */
@@ -13,14 +13,21 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include "scv_tr_attributes.h"
 #include "sqlite3.h"
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <util/slot_allocator.h>
+#include <util/spsc_queue.h>
 #include <vector>
 #ifdef HAS_SCV
 #include <scv.h>
@@ -30,7 +37,12 @@ namespace scv_tr {
 #endif
 // ----------------------------------------------------------------------------
 constexpr auto SQLITEWRAPPER_ERROR = 1000;
-constexpr auto with_transactions = false;
+//! number of rows inserted by one multi-row INSERT statement
+constexpr size_t batch_rows = 64;
+//! capacity of the queue between simulation and writer thread
+constexpr size_t queue_capacity = 1 << 16;
+//! interval of the commits done by the writer thread
+constexpr auto commit_interval = std::chrono::milliseconds(250);
 // ----------------------------------------------------------------------------
 using namespace std;
 
@@ -59,13 +71,16 @@ public:
             throw SQLiteException(nRet, sqlite3_errmsg(db), false);
         sqlite3_busy_timeout(db, busyTimeoutMs);
         sqlite3_config(SQLITE_CONFIG_MMAP_SIZE, 1ULL << 26, 1ULL << 30);
-        char* zSql = sqlite3_mprintf("PRAGMA journal_mode=OFF;\n"
-                                     "PRAGMA synchronous=OFF;\n");
+        char* zSql = sqlite3_mprintf("PRAGMA journal_mode=WAL;\n"
+                                     "PRAGMA synchronous=NORMAL;\n");
         char* zErrMsg = nullptr;
         nRet = sqlite3_exec(db, zSql, 0, 0, &zErrMsg);
-        if(nRet != SQLITE_OK)
-            throw SQLiteException(nRet, sqlite3_errmsg(db), false);
         sqlite3_free(zSql);
+        if(nRet != SQLITE_OK) {
+            string msg = zErrMsg ? zErrMsg : sqlite3_errmsg(db);
+            sqlite3_free(zErrMsg);
+            throw SQLiteException(nRet, msg.c_str(), false);
+        }
     }
 
     inline bool isOpen() { return db != nullptr; }
@@ -115,7 +130,7 @@ public:
             sqlite3_reset(stmt);
             return sqlite3_changes(db);
         } else
-            throw SQLiteException(nRet, sqlite3_errmsg(db));
+            throw SQLiteException(nRet, sqlite3_errmsg(db), false);
     }
 
 protected:
@@ -128,11 +143,6 @@ private:
     int busyTimeoutMs{60000};
     sqlite3* db{nullptr};
 };
-// ----------------------------------------------------------------------------
-static SQLiteDB db;
-static vector<vector<uint64_t>*> concurrencyLevel;
-static sqlite3_stmt *string_stmt, *stream_stmt, *gen_stmt, *tx_stmt, *evt_stmt, *attr_stmt, *rel_stmt;
-
 // ----------------------------------------------------------------------------
 enum EventType { BEGIN, RECORD, END };
 using data_type = scv_extensions_if::data_type;
@@ -145,9 +155,197 @@ using data_type = scv_extensions_if::data_type;
 #define TX_EVENT_TABLE "ScvTxEvent"
 #define TX_ATTRIBUTE_TABLE "ScvTxAttribute"
 #define TX_RELATION_TABLE "ScvTxRelation"
+// ----------------------------------------------------------------------------
+//! the kind of a row to be inserted, it is used as index into tableDesc
+enum RecordKind : uint8_t { STRING, STREAM, GENERATOR, TX, EVENT, ATTRIBUTE, REAL_ATTRIBUTE, TEXT_ATTRIBUTE, RELATION, NUM_KINDS };
+
+struct TableDesc {
+    const char* table;
+    const char* columns;
+    unsigned numColumns;
+};
+
+static const TableDesc tableDesc[NUM_KINDS] = {{STRING_TABLE, "id,value", 2},
+                                               {STREAM_TABLE, "id,name,kind", 3},
+                                               {GENERATOR_TABLE, "id,stream,name", 3},
+                                               {TX_TABLE, "id,generator,stream,concurrencyLevel", 4},
+                                               {TX_EVENT_TABLE, "tx,type,time", 3},
+                                               {TX_ATTRIBUTE_TABLE, "tx,type,name,data_type,data_value", 5},
+                                               {TX_ATTRIBUTE_TABLE, "tx,type,name,data_type,data_value", 5},
+                                               {TX_ATTRIBUTE_TABLE, "tx,type,name,data_type,data_value", 5},
+                                               {TX_RELATION_TABLE, "name,sink,src", 3}};
+/**
+ * @brief a row to be inserted
+ *
+ * All columns are integers except the value of the string table and of a TEXT_ATTRIBUTE which are held in text. The
+ * value of a REAL_ATTRIBUTE is stored bitwise in the last column.
+ */
+struct DbRecord {
+    RecordKind kind{STRING};
+    array<int64_t, 5> values{};
+    string text;
+    //! the value of a TEXT_ATTRIBUTE if it is a static string (e.g. the name of an enum value), used instead of text
+    char const* static_text{nullptr};
+};
+// ----------------------------------------------------------------------------
+static SQLiteDB db;
+/**
+ * @brief inserts the rows queued by the simulation thread in a dedicated writer thread
+ *
+ * The rows are collected per table and written using multi-row INSERT statements. The writer commits periodically so
+ * that the database (being in WAL mode) is consistent and can be queried while the simulation is running.
+ */
+class DbWriter {
+public:
+    //! joins the writer thread if the database has not been closed regularly (e.g. on exit() during simulation)
+    ~DbWriter() { stop(); }
+
+    void start() {
+        for(unsigned k = 0; k < NUM_KINDS; ++k) {
+            singleStmt[k] = db.prepare(insertSql(k, 1));
+            batchStmt[k] = db.prepare(insertSql(k, batch_rows));
+            batches[k].reserve(batch_rows);
+        }
+        db.exec("BEGIN TRANSACTION");
+        done = false;
+        worker = std::thread([this]() { run(); });
+    }
+
+    inline void push(DbRecord&& rec) { queue.push(std::move(rec)); }
+
+    //! stops the writer thread after it has written and committed all queued rows
+    void stop() {
+        if(!worker.joinable())
+            return;
+        done.store(true, std::memory_order_release);
+        worker.join();
+        for(unsigned k = 0; k < NUM_KINDS; ++k) {
+            sqlite3_finalize(singleStmt[k]);
+            sqlite3_finalize(batchStmt[k]);
+        }
+    }
+    //! the error message if the writer thread failed, empty otherwise
+    string const& getError() const { return error; }
+
+private:
+    static string insertSql(unsigned kind, size_t rows) {
+        auto const& desc = tableDesc[kind];
+        std::ostringstream ss;
+        ss << "INSERT INTO " << desc.table << " (" << desc.columns << ") values ";
+        for(size_t r = 0; r < rows; ++r) {
+            ss << (r ? ",(" : "(");
+            for(unsigned c = 0; c < desc.numColumns; ++c)
+                ss << (c ? ",?" : "?");
+            ss << ")";
+        }
+        ss << ";";
+        return ss.str();
+    }
+
+    void bindRow(sqlite3_stmt* stmt, size_t row, DbRecord const& rec) {
+        auto const numColumns = tableDesc[rec.kind].numColumns;
+        int idx = static_cast<int>(row * numColumns) + 1;
+        if(rec.kind == STRING) {
+            sqlite3_bind_int64(stmt, idx, rec.values[0]);
+            sqlite3_bind_text(stmt, idx + 1, rec.text.c_str(), static_cast<int>(rec.text.size()), SQLITE_STATIC);
+        } else if(rec.kind == TEXT_ATTRIBUTE || rec.kind == REAL_ATTRIBUTE) {
+            for(unsigned c = 0; c < numColumns - 1; ++c)
+                sqlite3_bind_int64(stmt, idx + c, rec.values[c]);
+            if(rec.kind == TEXT_ATTRIBUTE && rec.static_text)
+                sqlite3_bind_text(stmt, idx + 4, rec.static_text, -1, SQLITE_STATIC);
+            else if(rec.kind == TEXT_ATTRIBUTE)
+                sqlite3_bind_text(stmt, idx + 4, rec.text.c_str(), static_cast<int>(rec.text.size()), SQLITE_STATIC);
+            else {
+                double value;
+                memcpy(&value, &rec.values[4], sizeof(value));
+                sqlite3_bind_double(stmt, idx + 4, value);
+            }
+        } else
+            for(unsigned c = 0; c < numColumns; ++c)
+                sqlite3_bind_int64(stmt, idx + c, rec.values[c]);
+    }
+
+    void flush(unsigned kind) {
+        auto& batch = batches[kind];
+        if(batch.size() == batch_rows) {
+            for(size_t r = 0; r < batch.size(); ++r)
+                bindRow(batchStmt[kind], r, batch[r]);
+            db.exec(batchStmt[kind]);
+        } else
+            for(auto const& rec : batch) {
+                bindRow(singleStmt[kind], 0, rec);
+                db.exec(singleStmt[kind]);
+            }
+        batch.clear();
+    }
+
+    void flushAll() {
+        for(unsigned k = 0; k < NUM_KINDS; ++k)
+            flush(k);
+    }
+
+    void run() {
+        DbRecord rec;
+        auto lastCommit = std::chrono::steady_clock::now();
+        bool dirty = false;
+        try {
+            for(;;) {
+                // read the flag before draining so that all rows queued before stop() are written
+                auto finished = done.load(std::memory_order_acquire);
+                size_t count = 0;
+                while(queue.try_pop(rec)) {
+                    auto& batch = batches[rec.kind];
+                    batch.push_back(std::move(rec));
+                    if(batch.size() == batch_rows)
+                        flush(batch.back().kind);
+                    ++count;
+                }
+                dirty |= count > 0;
+                if(finished) {
+                    flushAll();
+                    db.exec("COMMIT TRANSACTION");
+                    return;
+                }
+                auto now = std::chrono::steady_clock::now();
+                if(dirty && now - lastCommit >= commit_interval) {
+                    flushAll();
+                    db.exec("COMMIT TRANSACTION");
+                    db.exec("BEGIN TRANSACTION");
+                    lastCommit = now;
+                    dirty = false;
+                }
+                if(!count)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        } catch(SQLiteDB::SQLiteException& e) {
+            error = e.what();
+        }
+        // keep draining so that the simulation thread does not block on a full queue
+        while(!done.load(std::memory_order_acquire))
+            if(!queue.try_pop(rec))
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    util::spsc_queue<DbRecord> queue{queue_capacity};
+    std::atomic<bool> done{false};
+    std::thread worker;
+    array<sqlite3_stmt*, NUM_KINDS> singleStmt{};
+    array<sqlite3_stmt*, NUM_KINDS> batchStmt{};
+    array<vector<DbRecord>, NUM_KINDS> batches;
+    string error;
+};
+static DbWriter writer;
+static util::concurrency_slots concurrencyLevel;
+static scv_tr_attribute_registry attributes;
+
+inline void pushRecord(RecordKind kind, int64_t v0, int64_t v1 = 0, int64_t v2 = 0, int64_t v3 = 0, int64_t v4 = 0) {
+    DbRecord rec;
+    rec.kind = kind;
+    rec.values = {{v0, v1, v2, v3, v4}};
+    writer.push(std::move(rec));
+}
 
 static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
-    char* tail = nullptr;
     // This is called from the scv_tr_db ctor.
     static string fName("DEFAULT_scv_tr_sqlite");
     switch(reason) {
@@ -156,12 +354,13 @@ static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason,
             fName = _scv_tr_db.get_name();
         try {
             remove(fName.c_str());
+            remove((fName + "-wal").c_str());
+            remove((fName + "-shm").c_str());
             db.open(fName);
             // performance related according to
             // http://blog.quibb.org/2010/08/fast-bulk-inserts-into-sqlite/
-            db.exec("PRAGMA synchronous=OFF");
+            // the WAL journal allows to read the database while the writer thread is adding rows
             db.exec("PRAGMA count_changes=OFF");
-            db.exec("PRAGMA journal_mode=OFF");
             db.exec("PRAGMA temp_store=MEMORY");
             // scv_out << "TB Transaction Recording has started, file = " <<
             // my_sqlite_file_name << endl;
@@ -197,7 +396,7 @@ static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason,
                     "type INTEGER, "
                     "name INTEGER REFERENCES " STRING_TABLE "(id), "
                     "data_type INTEGER, "
-                    "data_value TEXT"
+                    "data_value"
                     ");");
             db.exec("CREATE TABLE  IF NOT EXISTS " TX_RELATION_TABLE "("
                     "name INTEGER REFERENCES " STRING_TABLE "(id), "
@@ -205,24 +404,11 @@ static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason,
                     "sink INTEGER REFERENCES " TX_TABLE "(id)"
                     ");");
             db.exec("CREATE TABLE IF NOT EXISTS " SIM_PROPS "(time_resolution INTEGER);");
-            if(with_transactions)
-                db.exec("BEGIN TRANSACTION");
             std::ostringstream ss;
             ss << "INSERT INTO " SIM_PROPS " (time_resolution) values (" << (long)(sc_core::sc_get_time_resolution().to_seconds() * 1e15)
                << ");";
             db.exec(ss.str().c_str());
-            string_stmt = db.prepare("INSERT INTO " STRING_TABLE " (id, value) values (@ID,@VALUE);");
-            stream_stmt = db.prepare("INSERT INTO " STREAM_TABLE " (id, name, kind) values (@ID,@NAME,@KIND);");
-            gen_stmt = db.prepare("INSERT INTO " GENERATOR_TABLE " (id,stream, name)"
-                                  " values (@ID,@STRM_DI,@NAME);");
-            tx_stmt = db.prepare("INSERT INTO " TX_TABLE " (id,generator,stream, concurrencyLevel)"
-                                 " values (@ID,@GEN_ID,@STREAM_ID,@CONC_LEVEL);");
-            evt_stmt = db.prepare("INSERT INTO " TX_EVENT_TABLE " (tx,type,time)"
-                                  " values (@TX_ID,@TYPE,@TIMESTAMP);");
-            attr_stmt = db.prepare("INSERT INTO " TX_ATTRIBUTE_TABLE " (tx,type,name,data_type,data_value) "
-                                   "values (@ID,@EVENTID,@NAME,@TYPE,@VALUE);");
-            rel_stmt = db.prepare("INSERT INTO " TX_RELATION_TABLE " (name,sink,src)"
-                                  "values (@NAME,@ID1,@ID2);");
+            writer.start();
         } catch(SQLiteDB::SQLiteException& e) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't open recording file");
         }
@@ -231,8 +417,16 @@ static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason,
         try {
             // scv_out << "Transaction Recording is closing file: " <<
             // my_sqlite_file_name << endl;
-            if(with_transactions)
-                db.exec("COMMIT TRANSACTION");
+            writer.stop();
+            attributes.clear();
+            if(writer.getError().size())
+                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, writer.getError().c_str());
+            // indexes are created once at the end as maintaining them during the run slows down the inserts
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_EVENT_TABLE "_tx_idx ON " TX_EVENT_TABLE "(tx);");
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_ATTRIBUTE_TABLE "_tx_idx ON " TX_ATTRIBUTE_TABLE "(tx);");
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_TABLE "_stream_idx ON " TX_TABLE "(stream);");
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_RELATION_TABLE "_src_idx ON " TX_RELATION_TABLE "(src);");
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_RELATION_TABLE "_sink_idx ON " TX_RELATION_TABLE "(sink);");
             db.close();
         } catch(SQLiteDB::SQLiteException& e) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
@@ -250,134 +444,100 @@ uint64_t getStringId(std::string const& s) {
         return it->second;
     auto id = str_map.size();
     str_map.insert({s, id});
-    try {
-        sqlite3_bind_int64(string_stmt, 1, id);
-        sqlite3_bind_text(string_stmt, 2, s.c_str(), -1, SQLITE_TRANSIENT);
-        db.exec(string_stmt);
-    } catch(SQLiteDB::SQLiteException& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create string entry");
-    }
+    DbRecord rec;
+    rec.kind = STRING;
+    rec.values[0] = id;
+    rec.text = s;
+    writer.push(std::move(rec));
     return id;
 }
 // ----------------------------------------------------------------------------
 static void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, void* data) {
     if(reason == scv_tr_stream::CREATE && db.isOpen()) {
-        try {
-            sqlite3_bind_int64(stream_stmt, 1, s.get_id());
-            sqlite3_bind_int64(stream_stmt, 2, getStringId(s.get_name()));
-            sqlite3_bind_int64(stream_stmt, 3, getStringId(s.get_stream_kind() ? s.get_stream_kind() : "<unnamed>"));
-            db.exec(stream_stmt);
-            if(concurrencyLevel.size() <= s.get_id())
-                concurrencyLevel.resize(s.get_id() + 1);
-            concurrencyLevel[s.get_id()] = new vector<uint64_t>();
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create stream");
-        }
+        pushRecord(STREAM, s.get_id(), getStringId(s.get_name()),
+                   getStringId(s.get_stream_kind() ? s.get_stream_kind() : "<unnamed>"));
     }
 }
 // ----------------------------------------------------------------------------
-void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, const string& value) {
-    try {
-        sqlite3_bind_int64(attr_stmt, 1, id);
-        sqlite3_bind_int64(attr_stmt, 2, event);
-        sqlite3_bind_int64(attr_stmt, 3, getStringId(name));
-        sqlite3_bind_int64(attr_stmt, 4, type);
-        sqlite3_bind_int64(attr_stmt, 5, getStringId(value));
-        db.exec(attr_stmt);
-    } catch(SQLiteDB::SQLiteException& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-    }
+inline void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, int64_t value) {
+    pushRecord(ATTRIBUTE, id, event, name, type, value);
 }
 // ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, long long value) {
-    recordAttribute(id, event, name, type, std::to_string(value));
+inline void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, double value) {
+    DbRecord rec;
+    rec.kind = REAL_ATTRIBUTE;
+    rec.values = {{static_cast<int64_t>(id), event, static_cast<int64_t>(name), type, 0}};
+    memcpy(&rec.values[4], &value, sizeof(value));
+    writer.push(std::move(rec));
 }
 // ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, double value) {
-    recordAttribute(id, event, name, type, std::to_string(value));
+inline void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, string&& value) {
+    DbRecord rec;
+    rec.kind = TEXT_ATTRIBUTE;
+    rec.values = {{static_cast<int64_t>(id), event, static_cast<int64_t>(name), type, 0}};
+    rec.text = std::move(value);
+    writer.push(std::move(rec));
 }
 // ----------------------------------------------------------------------------
-static void recordAttributes(uint64_t id, EventType eventType, string& prefix, const scv_extensions_if* my_exts_p) {
+//! records a string value living until the end of the simulation
+inline void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, char const* value) {
+    DbRecord rec;
+    rec.kind = TEXT_ATTRIBUTE;
+    rec.values = {{static_cast<int64_t>(id), event, static_cast<int64_t>(name), type, 0}};
+    rec.static_text = value;
+    writer.push(std::move(rec));
+}
+// ----------------------------------------------------------------------------
+static void recordAttributes(uint64_t id, EventType eventType, scv_tr_attribute_layout& layout, const scv_extensions_if* my_exts_p) {
     if(my_exts_p == nullptr)
         return;
-    string name;
-    if(prefix == "") {
-        name = my_exts_p->get_name();
-    } else {
-        if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
-            name = prefix;
-        } else {
-            name = prefix + "." + my_exts_p->get_name();
+    layout.visit(my_exts_p, getStringId, [id, eventType](scv_tr_attribute_layout::leaf const& attr, const scv_extensions_if* ext) {
+        switch(attr.type) {
+        case scv_extensions_if::ENUMERATION:
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::ENUMERATION, ext->get_enum_string((int)(ext->get_integer())));
+            break;
+        case scv_extensions_if::BOOLEAN:
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::BOOLEAN, static_cast<int64_t>(ext->get_bool()));
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER:
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::INTEGER, static_cast<int64_t>(ext->get_integer()));
+            break;
+        case scv_extensions_if::UNSIGNED:
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::UNSIGNED, static_cast<int64_t>(ext->get_integer()));
+            break;
+        case scv_extensions_if::POINTER:
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::POINTER, (int64_t)ext->get_pointer());
+            break;
+        case scv_extensions_if::STRING:
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::STRING, ext->get_string());
+            break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::FLOATING_POINT_NUMBER, ext->get_double());
+            break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(ext->get_bitwidth());
+            ext->get_value(tmp_bv);
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(ext->get_bitwidth());
+            ext->get_value(tmp_lv);
+            recordAttribute(id, eventType, attr.name_id, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
+        } break;
+        default: {
+            std::array<char, 100> tmpString{};
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", ext->get_type());
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
         }
-    }
-    if(name == "")
-        name = "<unnamed>";
-    switch(my_exts_p->get_type()) {
-    case scv_extensions_if::RECORD: {
-        int num_fields = my_exts_p->get_num_fields();
-        if(num_fields > 0) {
-            for(int field_counter = 0; field_counter < num_fields; field_counter++) {
-                const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
-                recordAttributes(id, eventType, prefix, field_data_p);
-            }
         }
-    } break;
-    case scv_extensions_if::ENUMERATION:
-        recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
-        break;
-    case scv_extensions_if::BOOLEAN:
-        recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, my_exts_p->get_bool() ? "TRUE" : "FALSE");
-        break;
-    case scv_extensions_if::INTEGER:
-    case scv_extensions_if::FIXED_POINT_INTEGER:
-        recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::UNSIGNED:
-        recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::POINTER:
-        recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)my_exts_p->get_pointer());
-        break;
-    case scv_extensions_if::STRING:
-        recordAttribute(id, eventType, name, scv_extensions_if::STRING, my_exts_p->get_string());
-        break;
-    case scv_extensions_if::FLOATING_POINT_NUMBER:
-        recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, my_exts_p->get_double());
-        break;
-    case scv_extensions_if::BIT_VECTOR: {
-        sc_bv_base tmp_bv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_bv);
-        recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
-    } break;
-    case scv_extensions_if::LOGIC_VECTOR: {
-        sc_lv_base tmp_lv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_lv);
-        recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
-    } break;
-    case scv_extensions_if::ARRAY:
-        for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
-            const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
-            recordAttributes(id, eventType, prefix, field_data_p);
-        }
-        break;
-    default: {
-        std::array<char, 100> tmpString{};
-        sprintf(tmpString.data(), "Unsupported attribute type = %d", my_exts_p->get_type());
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
-    }
-    }
+    });
 }
 // ----------------------------------------------------------------------------
 static void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
     if(reason == scv_tr_generator_base::CREATE && db.isOpen()) {
-        try {
-            sqlite3_bind_int64(gen_stmt, 1, g.get_id());
-            sqlite3_bind_int64(gen_stmt, 2, g.get_scv_tr_stream().get_id());
-            sqlite3_bind_int64(gen_stmt, 3, getStringId(g.get_name()));
-            db.exec(gen_stmt);
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create generator entry");
-        }
+        pushRecord(GENERATOR, g.get_id(), g.get_scv_tr_stream().get_id(), getStringId(g.get_name()));
+        attributes.add_generator(g, getStringId);
     }
 }
 // ----------------------------------------------------------------------------
@@ -391,74 +551,26 @@ static void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason
 
     uint64_t id = t.get_id();
     uint64_t streamId = t.get_scv_tr_stream().get_id();
-    vector<uint64_t>::size_type concurrencyIdx;
     const scv_extensions_if* my_exts_p;
     switch(reason) {
     case scv_tr_handle::BEGIN: {
-        try {
-            if(concurrencyLevel.size() <= streamId)
-                concurrencyLevel.resize(streamId + 1);
-            vector<uint64_t>* levels = concurrencyLevel[streamId];
-            if(levels == nullptr) {
-                levels = new vector<uint64_t>();
-                concurrencyLevel[id] = levels;
-            }
-            for(concurrencyIdx = 0; concurrencyIdx < levels->size(); ++concurrencyIdx)
-                if((*levels)[concurrencyIdx] == 0)
-                    break;
-            if(concurrencyIdx == levels->size())
-                levels->push_back(id);
-            else
-                (*levels)[concurrencyIdx] = id;
-
-            sqlite3_bind_int64(tx_stmt, 1, id);
-            sqlite3_bind_int64(tx_stmt, 2, t.get_scv_tr_generator_base().get_id());
-            sqlite3_bind_int64(tx_stmt, 3, t.get_scv_tr_stream().get_id());
-            sqlite3_bind_int64(tx_stmt, 3, concurrencyIdx);
-            db.exec(tx_stmt);
-
-            sqlite3_bind_int64(evt_stmt, 1, id);
-            sqlite3_bind_int(evt_stmt, 2, BEGIN);
-            sqlite3_bind_int64(evt_stmt, 3, t.get_begin_sc_time().value());
-            db.exec(evt_stmt);
-
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, e.errorMessage());
-        }
+        auto concurrencyIdx = concurrencyLevel.begin(streamId, id);
+        pushRecord(TX, id, t.get_scv_tr_generator_base().get_id(), streamId, concurrencyIdx);
+        pushRecord(EVENT, id, BEGIN, t.get_begin_sc_time().value());
         my_exts_p = t.get_begin_exts_p();
         if(my_exts_p == nullptr) {
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
         }
-        string tmp_str =
-            t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-        recordAttributes(id, BEGIN, tmp_str, my_exts_p);
+        recordAttributes(id, BEGIN, attributes.get_generator_layout(t.get_scv_tr_generator_base(), true), my_exts_p);
     } break;
     case scv_tr_handle::END: {
-        try {
-            vector<uint64_t>* levels = concurrencyLevel[streamId];
-            for(concurrencyIdx = 0; concurrencyIdx < levels->size(); ++concurrencyIdx)
-                if((*levels)[concurrencyIdx] == id)
-                    break;
-            if(concurrencyIdx == levels->size())
-                levels->push_back(id);
-            else
-                levels->at(concurrencyIdx) = id;
-
-            sqlite3_bind_int64(evt_stmt, 1, t.get_id());
-            sqlite3_bind_int(evt_stmt, 2, END);
-            sqlite3_bind_int64(evt_stmt, 3, t.get_end_sc_time().value());
-            db.exec(evt_stmt);
-
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction end");
-        }
+        concurrencyLevel.end(streamId, id);
+        pushRecord(EVENT, t.get_id(), END, t.get_end_sc_time().value());
         my_exts_p = t.get_end_exts_p();
         if(my_exts_p == nullptr) {
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
         }
-        string tmp_str =
-            t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-        recordAttributes(t.get_id(), END, tmp_str, my_exts_p);
+        recordAttributes(t.get_id(), END, attributes.get_generator_layout(t.get_scv_tr_generator_base(), false), my_exts_p);
     } break;
     default:;
     }
@@ -471,8 +583,7 @@ static void attributeCb(const scv_tr_handle& t, const char* name, const scv_exte
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    string tmp_str(name == nullptr ? "" : name);
-    recordAttributes(t.get_id(), RECORD, tmp_str, ext);
+    recordAttributes(t.get_id(), RECORD, attributes.get_record_layout(name), ext);
 }
 // ----------------------------------------------------------------------------
 static void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
@@ -482,14 +593,8 @@ static void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, voi
         return;
     if(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    try {
-        sqlite3_bind_int64(rel_stmt, 1, getStringId(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_relation_name(relation_handle)));
-        sqlite3_bind_int64(rel_stmt, 2, tr_1.get_id());
-        sqlite3_bind_int64(rel_stmt, 3, tr_2.get_id());
-        db.exec(rel_stmt);
-    } catch(SQLiteDB::SQLiteException& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction relation");
-    }
+    pushRecord(RELATION, getStringId(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_relation_name(relation_handle)), tr_1.get_id(),
+               tr_2.get_id());
 }
 // ----------------------------------------------------------------------------
 void scv_tr_sqlite_init() {
@@ -0,0 +1,765 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "tx_db_merger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <ftr/ftr_writer.h>
+#include <memory>
+#include <unordered_map>
+#include <util/lz4_streambuf.h>
+#ifdef WITH_SQLITE
+#include <sqlite3.h>
+#endif
+
+namespace scc {
+using namespace txraw;
+constexpr size_t tx_db_merger::default_block_size;
+
+namespace {
+char const lz4_magic[4] = {0x04, 0x22, 0x4d, 0x18};
+char const sqlite_magic[16] = {'S', 'Q', 'L', 'i', 't', 'e', ' ', 'f', 'o', 'r', 'm', 'a', 't', ' ', '3', 0};
+/*
+ * appends records to the merged log and builds the time index
+ */
+class merged_writer {
+public:
+    merged_writer(size_t block_size)
+    : block_size(block_size) {}
+
+    bool open(std::string const& name, double tick_ps) {
+        if(!out.open(name))
+            return false;
+        file_header hdr{};
+        std::memcpy(hdr.magic, file_magic, sizeof(file_magic));
+        hdr.tick_ps = tick_ps;
+        hdr.time_exp = static_cast<int64_t>(std::lround(std::log10(tick_ps))) - 12;
+        out.append(&hdr, sizeof(hdr));
+        return true;
+    }
+
+    void write(record const& rec, char const* str = nullptr, size_t len = 0) {
+        static char const zeros[8]{};
+        if(cur.records && out.size() - cur.offset >= block_size)
+            finish_block();
+        if(!cur.records)
+            cur = index_entry{out.size(), UINT64_MAX, 0, 0, 0};
+        ++cur.records;
+        switch(rec.kind) {
+        case NAME:
+        case STREAM:
+        case GENERATOR:
+            cur.flags |= HAS_DEFINITIONS;
+            break;
+        case TX_BEGIN:
+        case TX_END:
+            cur.min_time = std::min(cur.min_time, rec.v[3]);
+            cur.max_time = std::max(cur.max_time, rec.v[3]);
+            break;
+        default:
+            break;
+        }
+        out.append(&rec, sizeof(record));
+        if(len) {
+            out.append(str, len);
+            out.append(zeros, padded(len) - len);
+        }
+    }
+
+    uint32_t name_id(std::string const& name) {
+        auto it = names.find(name);
+        if(it != names.end())
+            return it->second;
+        auto id = static_cast<uint32_t>(names.size());
+        names.emplace(name, id);
+        write(record{NAME, 0, 0, STRING_VALUE, id, {name.size(), 0, 0, 0}}, name.data(), name.size());
+        return id;
+    }
+
+    bool close() {
+        finish_block();
+        record eol{};
+        out.append(&eol, sizeof(eol));
+        index_trailer trailer{out.size(), index.size(), {}};
+        std::memcpy(trailer.magic, index_magic, sizeof(index_magic));
+        out.append(index.data(), index.size() * sizeof(index_entry));
+        out.append(&trailer, sizeof(trailer));
+        auto ok = out.size() == trailer.index_offset + index.size() * sizeof(index_entry) + sizeof(trailer);
+        return out.close() && ok;
+    }
+
+    uint64_t next_stream_id{1};
+    uint64_t next_generator_id{1};
+    uint64_t next_tx_id{1};
+
+private:
+    void finish_block() {
+        if(cur.records)
+            index.push_back(cur);
+        cur.records = 0;
+    }
+
+    util::mmap_log_writer out;
+    size_t block_size;
+    std::unordered_map<std::string, uint32_t> names;
+    std::vector<index_entry> index;
+    index_entry cur{};
+};
+/*
+ * the id mapping of an input
+ */
+struct input_ids {
+    merged_writer& out;
+    std::string const& prefix;
+    double time_scale;
+    uint64_t tx_base;
+    std::unordered_map<uint64_t, uint64_t> streams;
+    std::unordered_map<uint64_t, uint64_t> generators;
+
+    input_ids(merged_writer& out, std::string const& prefix, double time_scale)
+    : out(out)
+    , prefix(prefix)
+    , time_scale(time_scale)
+    , tx_base(out.next_tx_id) {}
+
+    uint64_t add_stream(uint64_t id, std::string const& name, std::string const& kind) {
+        auto out_id = out.next_stream_id++;
+        streams[id] = out_id;
+        auto name_id = out.name_id(prefix.empty() ? name : prefix + "." + name);
+        out.write(record{STREAM, 0, 0, STRING_VALUE, name_id, {out_id, out.name_id(kind), 0, 0}});
+        return out_id;
+    }
+
+    uint64_t add_generator(uint64_t id, std::string const& name, uint64_t stream) {
+        auto out_id = out.next_generator_id++;
+        generators[id] = out_id;
+        out.write(record{GENERATOR, 0, 0, STRING_VALUE, out.name_id(name), {out_id, stream_id(stream), 0, 0}});
+        return out_id;
+    }
+
+    uint64_t stream_id(uint64_t id) const {
+        auto it = streams.find(id);
+        return it != streams.end() ? it->second : 0;
+    }
+
+    uint64_t generator_id(uint64_t id) const {
+        auto it = generators.find(id);
+        return it != generators.end() ? it->second : 0;
+    }
+
+    uint64_t tx_id(uint64_t id) {
+        auto res = tx_base + id;
+        if(res >= out.next_tx_id)
+            out.next_tx_id = res + 1;
+        return res;
+    }
+
+    uint64_t time(uint64_t t) const { return time_scale == 1.0 ? t : static_cast<uint64_t>(std::llround(t * time_scale)); }
+};
+
+bool merge_raw(std::string const& name, input_ids& ids, std::string& error) {
+    util::mmap_file_reader in(name);
+    if(!in.is_open()) {
+        error = "could not open " + name;
+        return false;
+    }
+    std::vector<std::string> name_tbl;
+    std::vector<uint32_t> name_ids;
+    auto get_name = [&name_tbl](uint32_t id) -> std::string const& {
+        static std::string const empty;
+        return id < name_tbl.size() ? name_tbl[id] : empty;
+    };
+    record_reader reader(in.data(), in.size());
+    record rec;
+    char const* str;
+    size_t len;
+    while(reader.next(rec, str, len)) {
+        switch(rec.kind) {
+        case NAME:
+            if(name_tbl.size() <= rec.name) {
+                name_tbl.resize(rec.name + 1);
+                name_ids.resize(rec.name + 1, UINT32_MAX);
+            }
+            name_tbl[rec.name].assign(str ? str : "", len);
+            break;
+        case STREAM:
+            ids.add_stream(rec.v[0], get_name(rec.name), get_name(static_cast<uint32_t>(rec.v[1])));
+            break;
+        case GENERATOR:
+            ids.add_generator(rec.v[0], get_name(rec.name), rec.v[1]);
+            break;
+        case TX_BEGIN:
+            rec.v[0] = ids.tx_id(rec.v[0]);
+            rec.v[1] = ids.generator_id(rec.v[1]);
+            rec.v[2] = ids.stream_id(rec.v[2]);
+            rec.v[3] = ids.time(rec.v[3]);
+            ids.out.write(rec);
+            break;
+        case TX_END:
+            rec.v[0] = ids.tx_id(rec.v[0]);
+            rec.v[3] = ids.time(rec.v[3]);
+            ids.out.write(rec);
+            break;
+        case ATTRIBUTE:
+        case RELATION:
+            // names are only mapped when used since the names of streams and generators may get a prefix
+            if(rec.name >= name_ids.size()) {
+                error = "undefined name in " + name;
+                return false;
+            }
+            if(name_ids[rec.name] == UINT32_MAX)
+                name_ids[rec.name] = ids.out.name_id(name_tbl[rec.name]);
+            rec.name = name_ids[rec.name];
+            if(rec.kind == ATTRIBUTE)
+                rec.v[0] = ids.tx_id(rec.v[0]);
+            else {
+                rec.v[0] = ids.stream_id(rec.v[0]);
+                rec.v[1] = ids.tx_id(rec.v[1]);
+                rec.v[2] = ids.stream_id(rec.v[2]);
+                rec.v[3] = ids.tx_id(rec.v[3]);
+            }
+            ids.out.write(rec, str, len);
+            break;
+        default:
+            break;
+        }
+    }
+    if(reader.failed()) {
+        error = "malformed record in " + name;
+        return false;
+    }
+    return true;
+}
+/*
+ * the SCV text format, see scv_tr_text.cpp:
+ * scv_tr_stream (ID <id>, name "<full_name>", kind "<kind>")
+ * scv_tr_generator (ID <id>, name "<name>", scv_tr_stream <id>,
+ * begin_attribute (ID <id1>, name "<name1>", type <"type_name">)
+ * end_attribute (ID <id3>, name "<name3>", type <"type_name">)
+ * )
+ * tx_begin <this_transaction_id> <generator_id> <begin_time>
+ * a <value>
+ * tx_end <this_transaction_id> <generator_id> <end_time>
+ * a <value>
+ * tx_record_attribute <id> "<name>" <type> = <value>
+ * tx_relation <"relation_name"> <tx_id_1> <tx_id_2>
+ */
+struct text_attr {
+    uint32_t name;
+    uint8_t type;
+    value_kind vkind;
+};
+
+struct text_generator {
+    uint64_t id;
+    uint64_t stream;
+    std::vector<text_attr> begin_attrs;
+    std::vector<text_attr> end_attrs;
+};
+
+bool starts_with(std::string const& s, char const* prefix) { return s.compare(0, std::strlen(prefix), prefix) == 0; }
+
+std::string quoted(std::string const& line, size_t pos = 0) {
+    auto start = line.find('"', pos);
+    auto end = line.rfind('"');
+    return start != std::string::npos && end > start ? line.substr(start + 1, end - start - 1) : std::string();
+}
+
+std::string field(std::string const& line, char const* key) {
+    auto pos = line.find(key);
+    if(pos == std::string::npos)
+        return {};
+    pos += std::strlen(key);
+    if(pos < line.size() && line[pos] == '"') {
+        auto end = line.find('"', pos + 1);
+        return line.substr(pos + 1, end == std::string::npos ? std::string::npos : end - pos - 1);
+    }
+    auto end = line.find_first_of(",)", pos);
+    return line.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+}
+
+bool type_of(std::string name, uint8_t& type, value_kind& vkind) {
+    auto bracket = name.find('[');
+    if(bracket != std::string::npos)
+        name.resize(bracket);
+    static std::unordered_map<std::string, std::pair<ftr::data_type, value_kind>> const types{
+        {"BOOLEAN", {ftr::data_type::BOOLEAN, BOOL_VALUE}},
+        {"ENUMERATION", {ftr::data_type::ENUMERATION, STRING_VALUE}},
+        {"INTEGER", {ftr::data_type::INTEGER, INTEGER_VALUE}},
+        {"UNSIGNED", {ftr::data_type::UNSIGNED, INTEGER_VALUE}},
+        {"FLOATING_POINT_NUMBER", {ftr::data_type::FLOATING_POINT_NUMBER, REAL_VALUE}},
+        {"BIT_VECTOR", {ftr::data_type::BIT_VECTOR, STRING_VALUE}},
+        {"LOGIC_VECTOR", {ftr::data_type::LOGIC_VECTOR, STRING_VALUE}},
+        {"FIXED_POINT_INTEGER", {ftr::data_type::FIXED_POINT_INTEGER, INTEGER_VALUE}},
+        {"UNSIGNED_FIXED_POINT_INTEGER", {ftr::data_type::UNSIGNED_FIXED_POINT_INTEGER, INTEGER_VALUE}},
+        {"POINTER", {ftr::data_type::POINTER, INTEGER_VALUE}},
+        {"STRING", {ftr::data_type::STRING, STRING_VALUE}}};
+    auto it = types.find(name);
+    if(it == types.end())
+        return false;
+    type = static_cast<uint8_t>(it->second.first);
+    vkind = it->second.second;
+    return true;
+}
+
+double unit_ps(std::string const& unit) {
+    if(unit == "fs")
+        return 1e-3;
+    if(unit == "ps" || unit.empty())
+        return 1.0;
+    if(unit == "ns")
+        return 1e3;
+    if(unit == "us")
+        return 1e6;
+    if(unit == "ms")
+        return 1e9;
+    if(unit == "s" || unit == "sec")
+        return 1e12;
+    return 0.0;
+}
+
+class text_merger {
+public:
+    text_merger(input_ids& ids, std::string const& name, std::string& error)
+    : ids(ids)
+    , name(name)
+    , error(error) {}
+
+    bool merge(std::istream& is) {
+        std::string line;
+        while(std::getline(is, line)) {
+            ++line_no;
+            if(!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if(!parse(line)) {
+                error = "could not parse line " + std::to_string(line_no) + " of " + name;
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    bool parse(std::string const& line) {
+        char* end;
+        if(starts_with(line, "a ")) {
+            if(!cur_attrs || cur_attr_idx >= cur_attrs->size())
+                return false;
+            auto const& attr = (*cur_attrs)[cur_attr_idx++];
+            return write_attribute(cur_tx, cur_event, attr.name, attr.type, attr.vkind, line.substr(2));
+        } else if(starts_with(line, "tx_begin ") || starts_with(line, "tx_end ")) {
+            auto begin = line[3] == 'b';
+            auto id = std::strtoull(line.c_str() + (begin ? 9 : 7), &end, 10);
+            auto gen_id = std::strtoull(end, &end, 10);
+            auto t = std::strtod(end, &end);
+            while(*end == ' ')
+                ++end;
+            auto scale = unit_ps(end);
+            auto it = generators.find(gen_id);
+            if(it == generators.end() || scale == 0.0)
+                return false;
+            auto& gen = it->second;
+            cur_tx = ids.tx_id(id);
+            cur_event = static_cast<uint8_t>(begin ? ftr::event_type::BEGIN : ftr::event_type::END);
+            cur_attrs = begin ? &gen.begin_attrs : &gen.end_attrs;
+            cur_attr_idx = 0;
+            auto time = static_cast<uint64_t>(std::llround(t * scale * ids.time_scale));
+            if(begin) {
+                if(tx_streams.size() <= id)
+                    tx_streams.resize(std::max<size_t>(id + 1, tx_streams.size() * 2));
+                tx_streams[id] = static_cast<uint32_t>(gen.stream);
+                ids.out.write(record{TX_BEGIN, 0, 0, STRING_VALUE, 0, {cur_tx, gen.id, gen.stream, time}});
+            } else
+                ids.out.write(record{TX_END, 0, 0, STRING_VALUE, 0, {cur_tx, 0, 0, time}});
+        } else if(starts_with(line, "tx_record_attribute ")) {
+            cur_attrs = nullptr;
+            auto id = std::strtoull(line.c_str() + 20, &end, 10);
+            auto name_start = line.find('"');
+            auto name_end = line.find('"', name_start + 1);
+            auto eq = line.find(" = ", name_end);
+            if(name_start == std::string::npos || name_end == std::string::npos || eq == std::string::npos)
+                return false;
+            uint8_t type;
+            value_kind vkind;
+            auto type_start = name_end + 2;
+            if(!type_of(line.substr(type_start, eq - type_start), type, vkind))
+                return false;
+            return write_attribute(ids.tx_id(id), static_cast<uint8_t>(ftr::event_type::RECORD),
+                                   ids.out.name_id(line.substr(name_start + 1, name_end - name_start - 1)), type, vkind,
+                                   line.substr(eq + 3));
+        } else if(starts_with(line, "tx_relation ")) {
+            cur_attrs = nullptr;
+            auto name_end = line.find('"', 13);
+            if(name_end == std::string::npos)
+                return false;
+            auto tx1 = std::strtoull(line.c_str() + name_end + 1, &end, 10);
+            auto tx2 = std::strtoull(end, &end, 10);
+            auto rel = ids.out.name_id(line.substr(13, name_end - 13));
+            ids.out.write(record{RELATION, 0, 0, STRING_VALUE, rel, {stream_of(tx1), ids.tx_id(tx1), stream_of(tx2), ids.tx_id(tx2)}});
+        } else if(starts_with(line, "scv_tr_stream ")) {
+            cur_attrs = nullptr;
+            ids.add_stream(std::strtoull(field(line, "ID ").c_str(), nullptr, 10), field(line, "name "), field(line, "kind "));
+        } else if(starts_with(line, "scv_tr_generator ")) {
+            cur_attrs = nullptr;
+            auto id = std::strtoull(field(line, "ID ").c_str(), nullptr, 10);
+            auto stream = std::strtoull(field(line, "scv_tr_stream ").c_str(), nullptr, 10);
+            cur_gen = &generators[id];
+            cur_gen->id = ids.add_generator(id, field(line, "name "), stream);
+            cur_gen->stream = ids.stream_id(stream);
+        } else if(starts_with(line, "begin_attribute ") || starts_with(line, "end_attribute ")) {
+            if(!cur_gen)
+                return false;
+            text_attr attr;
+            if(!type_of(field(line, "type "), attr.type, attr.vkind))
+                return false;
+            attr.name = ids.out.name_id(field(line, "name "));
+            (line[0] == 'b' ? cur_gen->begin_attrs : cur_gen->end_attrs).push_back(attr);
+        } else if(line == ")")
+            cur_gen = nullptr;
+        // everything else (e.g. comments or empty lines) is ignored
+        return true;
+    }
+
+    bool write_attribute(uint64_t tx, uint8_t event, uint32_t name, uint8_t type, value_kind vkind, std::string const& value) {
+        record rec{ATTRIBUTE, event, type, vkind, name, {tx, 0, 0, 0}};
+        switch(vkind) {
+        case STRING_VALUE: {
+            auto str = value.size() && value[0] == '"' ? quoted(value) : value;
+            rec.v[2] = str.size();
+            ids.out.write(rec, str.data(), str.size());
+            return true;
+        }
+        case BOOL_VALUE:
+            rec.v[1] = value == "true" || value == "1";
+            break;
+        case INTEGER_VALUE:
+            rec.v[1] = value.size() && value[0] == '-' ? static_cast<uint64_t>(std::strtoll(value.c_str(), nullptr, 0))
+                                                        : std::strtoull(value.c_str(), nullptr, 0);
+            break;
+        case REAL_VALUE: {
+            auto d = std::strtod(value.c_str(), nullptr);
+            std::memcpy(&rec.v[1], &d, sizeof(d));
+        } break;
+        }
+        ids.out.write(rec);
+        return true;
+    }
+
+    uint64_t stream_of(uint64_t tx) const { return tx < tx_streams.size() ? tx_streams[tx] : 0; }
+
+    input_ids& ids;
+    std::string const& name;
+    std::string& error;
+    uint64_t line_no{0};
+    std::unordered_map<uint64_t, text_generator> generators;
+    text_generator* cur_gen{nullptr};
+    std::vector<text_attr> const* cur_attrs{nullptr};
+    size_t cur_attr_idx{0};
+    uint64_t cur_tx{0};
+    uint8_t cur_event{0};
+    //! the (output) stream of each transaction (by input id) to resolve relations
+    std::vector<uint32_t> tx_streams;
+};
+#ifdef WITH_SQLITE
+/*
+ * the SQLite database written by scv_tr_sqlite.cpp:
+ * ScvSimProps (time_resolution in fs)
+ * ScvStrings (id, value)
+ * ScvStream (id, name, kind), ScvGenerator (id, stream, name) referencing the strings
+ * ScvTx (id, generator, stream, concurrencyLevel)
+ * ScvTxEvent (tx, type, time) with the type being BEGIN (0) or END (2)
+ * ScvTxAttribute (tx, type, name, data_type, data_value) with the type being BEGIN, RECORD (1) or END and data_type
+ * being a scv_extensions_if::data_type
+ * ScvTxRelation (name, sink, src) where sink is the first and src the second transaction of the relation
+ */
+class sqlite_reader {
+public:
+    ~sqlite_reader() {
+        for(auto* stmt : stmts)
+            sqlite3_finalize(stmt);
+        if(db)
+            sqlite3_close(db);
+    }
+
+    bool open(std::string const& name) {
+        return sqlite3_open_v2(name.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK;
+    }
+    //! returns a prepared statement which is finalized with the reader, nullptr if the schema does not match
+    sqlite3_stmt* prepare(char const* sql) {
+        sqlite3_stmt* stmt = nullptr;
+        if(sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+            return nullptr;
+        stmts.push_back(stmt);
+        return stmt;
+    }
+    //! the length of a time tick in ps, 0 if it can not be read
+    double tick_ps() {
+        auto* stmt = prepare("SELECT time_resolution FROM ScvSimProps;");
+        return stmt && sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) / 1000.0 : 0.0;
+    }
+
+    std::string error_msg() const { return db ? sqlite3_errmsg(db) : "out of memory"; }
+
+private:
+    sqlite3* db{nullptr};
+    std::vector<sqlite3_stmt*> stmts;
+};
+
+std::string column_text(sqlite3_stmt* stmt, int col) {
+    auto* text = reinterpret_cast<char const*>(sqlite3_column_text(stmt, col));
+    return text ? std::string(text, sqlite3_column_bytes(stmt, col)) : std::string();
+}
+// maps a scv_extensions_if::data_type to the type of the raw log
+bool scv_type_of(int64_t scv_type, uint8_t& type, value_kind& vkind) {
+    static std::pair<ftr::data_type, value_kind> const types[] = {
+        {ftr::data_type::BOOLEAN, BOOL_VALUE},
+        {ftr::data_type::ENUMERATION, STRING_VALUE},
+        {ftr::data_type::INTEGER, INTEGER_VALUE},
+        {ftr::data_type::UNSIGNED, INTEGER_VALUE},
+        {ftr::data_type::FLOATING_POINT_NUMBER, REAL_VALUE},
+        {ftr::data_type::BIT_VECTOR, STRING_VALUE},
+        {ftr::data_type::LOGIC_VECTOR, STRING_VALUE},
+        {ftr::data_type::FIXED_POINT_INTEGER, INTEGER_VALUE},
+        {ftr::data_type::UNSIGNED_FIXED_POINT_INTEGER, INTEGER_VALUE},
+        {ftr::data_type::STRING, STRING_VALUE}, // RECORD, never recorded
+        {ftr::data_type::POINTER, INTEGER_VALUE},
+        {ftr::data_type::STRING, STRING_VALUE}, // ARRAY, never recorded
+        {ftr::data_type::STRING, STRING_VALUE}};
+    if(scv_type < 0 || scv_type >= static_cast<int64_t>(sizeof(types) / sizeof(types[0])))
+        return false;
+    type = static_cast<uint8_t>(types[scv_type].first);
+    vkind = types[scv_type].second;
+    return true;
+}
+
+bool merge_sqlite(std::string const& name, input_ids& ids, std::string& error) {
+    sqlite_reader db;
+    if(!db.open(name)) {
+        error = "could not open " + name + ": " + db.error_msg();
+        return false;
+    }
+    auto* strings_stmt = db.prepare("SELECT id, value FROM ScvStrings;");
+    auto* stream_stmt = db.prepare("SELECT id, name, kind FROM ScvStream ORDER BY id;");
+    auto* gen_stmt = db.prepare("SELECT id, stream, name FROM ScvGenerator ORDER BY id;");
+    // the events are stored in the order of recording
+    auto* event_stmt = db.prepare("SELECT e.tx, e.type, e.time, t.generator, t.stream FROM ScvTxEvent e LEFT JOIN ScvTx t ON t.id = e.tx "
+                                  "ORDER BY e.rowid;");
+    auto* attr_stmt = db.prepare("SELECT tx, type, name, data_type, data_value FROM ScvTxAttribute ORDER BY rowid;");
+    auto* rel_stmt = db.prepare("SELECT r.name, r.sink, t1.stream, r.src, t2.stream FROM ScvTxRelation r "
+                                "LEFT JOIN ScvTx t1 ON t1.id = r.sink LEFT JOIN ScvTx t2 ON t2.id = r.src;");
+    if(!strings_stmt || !stream_stmt || !gen_stmt || !event_stmt || !attr_stmt || !rel_stmt) {
+        error = "unexpected database schema in " + name + ": " + db.error_msg();
+        return false;
+    }
+    std::unordered_map<int64_t, std::string> strings;
+    while(sqlite3_step(strings_stmt) == SQLITE_ROW)
+        strings[sqlite3_column_int64(strings_stmt, 0)] = column_text(strings_stmt, 1);
+    auto get_string = [&strings](int64_t id) -> std::string const& {
+        static std::string const empty;
+        auto it = strings.find(id);
+        return it != strings.end() ? it->second : empty;
+    };
+    while(sqlite3_step(stream_stmt) == SQLITE_ROW)
+        ids.add_stream(sqlite3_column_int64(stream_stmt, 0), get_string(sqlite3_column_int64(stream_stmt, 1)),
+                       get_string(sqlite3_column_int64(stream_stmt, 2)));
+    while(sqlite3_step(gen_stmt) == SQLITE_ROW)
+        ids.add_generator(sqlite3_column_int64(gen_stmt, 0), get_string(sqlite3_column_int64(gen_stmt, 2)),
+                          sqlite3_column_int64(gen_stmt, 1));
+    std::unordered_map<int64_t, uint32_t> name_ids;
+    auto name_id = [&](int64_t id) {
+        auto it = name_ids.find(id);
+        return it != name_ids.end() ? it->second : name_ids.emplace(id, ids.out.name_id(get_string(id))).first->second;
+    };
+    auto write_attribute = [&](uint64_t tx) {
+        uint8_t type;
+        value_kind vkind;
+        if(!scv_type_of(sqlite3_column_int64(attr_stmt, 3), type, vkind)) {
+            error = "unknown attribute type in " + name;
+            return false;
+        }
+        record rec{ATTRIBUTE, static_cast<uint8_t>(sqlite3_column_int64(attr_stmt, 1)), type, vkind,
+                   name_id(sqlite3_column_int64(attr_stmt, 2)), {ids.tx_id(tx), 0, 0, 0}};
+        switch(vkind) {
+        case STRING_VALUE: {
+            auto str = column_text(attr_stmt, 4);
+            rec.v[2] = str.size();
+            ids.out.write(rec, str.data(), str.size());
+            return true;
+        }
+        case BOOL_VALUE:
+            // older databases stored the booleans as text
+            if(sqlite3_column_type(attr_stmt, 4) == SQLITE_TEXT) {
+                auto str = column_text(attr_stmt, 4);
+                rec.v[1] = str == "TRUE" || str == "true" || str == "1";
+            } else
+                rec.v[1] = sqlite3_column_int64(attr_stmt, 4) != 0;
+            break;
+        case INTEGER_VALUE:
+            rec.v[1] = static_cast<uint64_t>(sqlite3_column_int64(attr_stmt, 4));
+            break;
+        case REAL_VALUE: {
+            auto d = sqlite3_column_double(attr_stmt, 4);
+            std::memcpy(&rec.v[1], &d, sizeof(d));
+        } break;
+        }
+        ids.out.write(rec);
+        return true;
+    };
+    /*
+     * events and attributes are each stored in the order of recording, so both tables are read once and merged: the
+     * attributes following an event are written as long as they belong to it or are recorded for a transaction which
+     * has begun already (the transaction ids increase with their begin).
+     */
+    auto has_attr = sqlite3_step(attr_stmt) == SQLITE_ROW;
+    uint64_t max_begun = 0;
+    int rc;
+    while((rc = sqlite3_step(event_stmt)) == SQLITE_ROW) {
+        auto id = static_cast<uint64_t>(sqlite3_column_int64(event_stmt, 0));
+        auto event = sqlite3_column_int64(event_stmt, 1);
+        auto tx = ids.tx_id(id);
+        auto time = ids.time(sqlite3_column_int64(event_stmt, 2));
+        if(event == static_cast<int64_t>(ftr::event_type::BEGIN)) {
+            ids.out.write(record{TX_BEGIN, 0, 0, STRING_VALUE, 0,
+                                 {tx, ids.generator_id(sqlite3_column_int64(event_stmt, 3)),
+                                  ids.stream_id(sqlite3_column_int64(event_stmt, 4)), time}});
+            max_begun = std::max(max_begun, id);
+        } else
+            ids.out.write(record{TX_END, 0, 0, STRING_VALUE, 0, {tx, 0, 0, time}});
+        for(; has_attr; has_attr = sqlite3_step(attr_stmt) == SQLITE_ROW) {
+            auto attr_tx = static_cast<uint64_t>(sqlite3_column_int64(attr_stmt, 0));
+            auto attr_event = sqlite3_column_int64(attr_stmt, 1);
+            if(attr_event == static_cast<int64_t>(ftr::event_type::RECORD) ? attr_tx > max_begun : attr_tx != id || attr_event != event)
+                break;
+            if(!write_attribute(attr_tx))
+                return false;
+        }
+    }
+    if(rc != SQLITE_DONE) {
+        error = "could not read " + name + ": " + db.error_msg();
+        return false;
+    }
+    // attributes of transactions without events
+    for(; has_attr; has_attr = sqlite3_step(attr_stmt) == SQLITE_ROW)
+        if(!write_attribute(sqlite3_column_int64(attr_stmt, 0)))
+            return false;
+    while(sqlite3_step(rel_stmt) == SQLITE_ROW)
+        ids.out.write(record{RELATION, 0, 0, STRING_VALUE, name_id(sqlite3_column_int64(rel_stmt, 0)),
+                             {ids.stream_id(sqlite3_column_int64(rel_stmt, 2)), ids.tx_id(sqlite3_column_int64(rel_stmt, 1)),
+                              ids.stream_id(sqlite3_column_int64(rel_stmt, 4)), ids.tx_id(sqlite3_column_int64(rel_stmt, 3))}});
+    return true;
+}
+#endif
+} // namespace
+
+bool tx_db_merger::add_input(std::string const& name, std::string const& prefix) {
+    std::ifstream ifs(name, std::ios::binary);
+    if(!ifs.is_open()) {
+        error = "could not open " + name;
+        return false;
+    }
+    file_header hdr{};
+    ifs.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+    auto count = static_cast<size_t>(ifs.gcount());
+    if(count == sizeof(hdr) && std::memcmp(hdr.magic, file_magic, sizeof(file_magic)) == 0) {
+        if(!(hdr.tick_ps > 0)) {
+            error = "invalid time resolution in " + name;
+            return false;
+        }
+        inputs.push_back({name, prefix, format::RAW, hdr.tick_ps});
+    } else if(count >= sizeof(sqlite_magic) && std::memcmp(&hdr, sqlite_magic, sizeof(sqlite_magic)) == 0) {
+#ifdef WITH_SQLITE
+        sqlite_reader db;
+        auto tick_ps = db.open(name) ? db.tick_ps() : 0.0;
+        if(!(tick_ps > 0)) {
+            error = "could not read the time resolution of " + name;
+            return false;
+        }
+        inputs.push_back({name, prefix, format::SQLITE, tick_ps});
+#else
+        error = "SQLite support is not built in, can not read " + name;
+        return false;
+#endif
+    } else if(count >= sizeof(lz4_magic) && std::memcmp(hdr.magic, lz4_magic, sizeof(lz4_magic)) == 0)
+        inputs.push_back({name, prefix, format::LZ4_TEXT, 1.0});
+    else if(count && (starts_with(std::string(hdr.magic, std::min(count, sizeof(hdr.magic))), "scv_tr_") ||
+                      starts_with(std::string(hdr.magic, std::min(count, sizeof(hdr.magic))), "tx_")))
+        inputs.push_back({name, prefix, format::TEXT, 1.0});
+    else {
+        error = "unknown format of " + name;
+        return false;
+    }
+    return true;
+}
+
+bool tx_db_merger::merge(std::string const& out_name, size_t block_size) {
+    double tick_ps = 1.0;
+    for(auto const& in : inputs)
+        tick_ps = std::min(tick_ps, in.tick_ps);
+    merged_writer out(block_size);
+    if(!out.open(out_name, tick_ps)) {
+        error = "could not create " + out_name;
+        return false;
+    }
+    for(auto const& in : inputs) {
+        input_ids ids(out, in.prefix, in.tick_ps / tick_ps);
+        if(in.fmt == format::RAW) {
+            if(!merge_raw(in.name, ids, error))
+                return false;
+#ifdef WITH_SQLITE
+        } else if(in.fmt == format::SQLITE) {
+            if(!merge_sqlite(in.name, ids, error))
+                return false;
+#endif
+        } else {
+            std::ifstream ifs(in.name, std::ios::binary);
+            std::unique_ptr<util::lz4d_streambuf> buf;
+            std::istream is(ifs.rdbuf());
+            if(in.fmt == format::LZ4_TEXT) {
+                buf.reset(new util::lz4d_streambuf(ifs, 64 * 1024));
+                is.rdbuf(buf.get());
+            }
+            if(!text_merger(ids, in.name, error).merge(is))
+                return false;
+        }
+    }
+    if(!out.close()) {
+        error = "could not write " + out_name;
+        return false;
+    }
+    return true;
+}
+
+bool tx_db_index::open(std::string const& name) {
+    entries.clear();
+    if(!file.open(name) || file.size() < sizeof(file_header) + sizeof(index_trailer))
+        return false;
+    file_header hdr;
+    index_trailer trailer;
+    std::memcpy(&hdr, file.data(), sizeof(hdr));
+    std::memcpy(&trailer, file.data() + file.size() - sizeof(trailer), sizeof(trailer));
+    if(std::memcmp(hdr.magic, file_magic, sizeof(file_magic)) != 0 || std::memcmp(trailer.magic, index_magic, sizeof(index_magic)) != 0 ||
+       trailer.index_offset > file.size() - sizeof(trailer) ||
+       trailer.entries != (file.size() - sizeof(trailer) - trailer.index_offset) / sizeof(index_entry) ||
+       trailer.index_offset + trailer.entries * sizeof(index_entry) + sizeof(trailer) != file.size())
+        return false;
+    entries.resize(trailer.entries);
+    std::memcpy(entries.data(), file.data() + trailer.index_offset, trailer.entries * sizeof(index_entry));
+    tick_ps = hdr.tick_ps;
+    return true;
+}
+} // namespace scc
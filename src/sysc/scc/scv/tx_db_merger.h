@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_TX_DB_MERGER_H_
+#define _SCC_TX_DB_MERGER_H_
+
+#include "scv_tr_raw.h"
+#include <string>
+#include <util/mmap_log.h>
+#include <vector>
+
+/** \ingroup scc-sysc
+ *  @{
+ */
+/**@{*/
+//! @brief SCC SystemC utilities
+namespace scc {
+/**
+ * @class tx_db_merger
+ * @brief merges several transaction recording databases into one indexed raw log
+ *
+ * Supported inputs are raw logs (see scv_tr_raw_init(), merged logs can be merged again) and SCV text logs written
+ * uncompressed or LZ4 compressed (scv_tr_text_init(), scv_tr_plain_init(), scv_tr_lz4_init() and scv_tr_mtc_init()) as
+ * well as SQLite databases (scv_tr_sqlite_init(), if the library is built with SQLite support).
+ * Stream, generator and transaction ids are remapped so that they are unique in the merged log, times are converted
+ * to the finest time resolution of the inputs.
+ *
+ * The inputs are streamed one after the other and the output is appended through a memory mapped window, so the size
+ * of the inputs is not limited by the available memory. Memory is needed for the names, the stream and generator ids
+ * and for text inputs 4 bytes per transaction to find the streams of related transactions.
+ *
+ * The merged log is a raw log followed by a time index of blocks of records (see txraw::index_entry) which is used by
+ * tx_db_index for range queries. It can be converted to FTR using scv_tr_raw_convert().
+ */
+class tx_db_merger {
+public:
+    //! the default size of the blocks described by one index entry
+    static constexpr size_t default_block_size = 64 * 1024;
+    /**
+     * @brief adds an input database
+     *
+     * @param name the file name of the database
+     * @param prefix if not empty it is prepended to the stream names (separated by a dot) to keep the streams of
+     * different inputs apart
+     * @return false if the file can not be opened or has an unknown format, see get_error()
+     */
+    bool add_input(std::string const& name, std::string const& prefix = "");
+    /**
+     * @brief merges all inputs
+     *
+     * @param out_name the file name of the merged log
+     * @param block_size the number of bytes of records described by one index entry
+     * @return false if an input could not be read or the output could not be written, see get_error()
+     */
+    bool merge(std::string const& out_name, size_t block_size = default_block_size);
+    //! the description of the last error
+    std::string const& get_error() const { return error; }
+
+private:
+    enum class format { RAW, TEXT, LZ4_TEXT, SQLITE };
+    struct input {
+        std::string name;
+        std::string prefix;
+        format fmt;
+        double tick_ps;
+    };
+    std::vector<input> inputs;
+    std::string error;
+};
+/**
+ * @class tx_db_index
+ * @brief read access to a merged raw log using its time index
+ */
+class tx_db_index {
+public:
+    /**
+     * @brief opens a merged log
+     *
+     * @param name the file name
+     * @return false if the file can not be opened or has no index
+     */
+    bool open(std::string const& name);
+    //! true if a log is open
+    bool is_open() const { return file.is_open() && !entries.empty(); }
+    //! the length of a time tick of the log in ps
+    double get_tick_ps() const { return tick_ps; }
+    //! the index entries
+    std::vector<txraw::index_entry> const& get_entries() const { return entries; }
+    /**
+     * @brief calls a function for all NAME, STREAM and GENERATOR records
+     *
+     * @param func the function called with the record, the following string and its length
+     * @return false if a malformed record has been found
+     */
+    template <typename FUNC> bool for_each_definition(FUNC func) const {
+        for(auto const& e : entries)
+            if(e.flags & txraw::HAS_DEFINITIONS && !visit(e, [&func](txraw::record const& rec, char const* str, size_t len) {
+                   if(rec.kind == txraw::NAME || rec.kind == txraw::STREAM || rec.kind == txraw::GENERATOR)
+                       func(rec, str, len);
+               }))
+                return false;
+        return true;
+    }
+    /**
+     * @brief calls a function for the records of all blocks containing transaction events in a time range
+     *
+     * The blocks may contain records outside of the range, the function needs to check the times of the TX_BEGIN and
+     * TX_END records.
+     *
+     * @param start the start of the range in ticks
+     * @param end the end of the range (inclusive) in ticks
+     * @param func the function called with the record, the following string and its length
+     * @return false if a malformed record has been found
+     */
+    template <typename FUNC> bool for_each_in_range(uint64_t start, uint64_t end, FUNC func) const {
+        for(auto const& e : entries)
+            if(e.min_time <= end && e.max_time >= start && !visit(e, func))
+                return false;
+        return true;
+    }
+
+private:
+    template <typename FUNC> bool visit(txraw::index_entry const& e, FUNC func) const {
+        txraw::record_reader reader(file.data(), file.size(), e.offset);
+        txraw::record rec;
+        char const* str;
+        size_t len;
+        for(auto i = 0U; i < e.records && reader.next(rec, str, len); ++i)
+            func(rec, str, len);
+        return !reader.failed();
+    }
+
+    util::mmap_file_reader file;
+    std::vector<txraw::index_entry> entries;
+    double tick_ps{1.0};
+};
+} // namespace scc
+/** @} */ // end of scc-sysc
+#endif    /* _SCC_TX_DB_MERGER_H_ */
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#include "tx_db_merger.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+void usage(char const* prog) {
+    std::cerr << "usage: " << prog << " [-p] [-b <block size>] -o <out.txraw> <input>...\n"
+              << "  merges raw (.txraw), SCV text (.txlog, plain or LZ4 compressed) and SQLite transaction databases into an\n"
+              << "  indexed raw log\n"
+              << "  -p  prefix the stream names of all inputs with the base name of their input file\n"
+              << "  -b  the number of bytes of records per time index entry (default "
+              << scc::tx_db_merger::default_block_size << ")\n"
+              << "  the result can be converted to FTR using txraw2ftr\n";
+}
+
+std::string base_name(std::string const& name) {
+    auto slash = name.find_last_of("/\\");
+    auto res = slash == std::string::npos ? name : name.substr(slash + 1);
+    auto dot = res.find('.');
+    return dot == std::string::npos || dot == 0 ? res : res.substr(0, dot);
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool prefix = false;
+    size_t block_size = scc::tx_db_merger::default_block_size;
+    std::string out_name;
+    std::vector<char const*> inputs;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "-p") == 0)
+            prefix = true;
+        else if(std::strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            block_size = std::strtoull(argv[++i], nullptr, 0);
+        else if(std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            out_name = argv[++i];
+        else if(argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else
+            inputs.push_back(argv[i]);
+    }
+    if(out_name.empty() || inputs.empty() || !block_size) {
+        usage(argv[0]);
+        return 1;
+    }
+    // the inputs are added after all options have been parsed so that -p applies regardless of its position
+    scc::tx_db_merger merger;
+    for(auto* input : inputs)
+        if(!merger.add_input(input, prefix ? base_name(input) : std::string())) {
+            std::cerr << merger.get_error() << "\n";
+            return 2;
+        }
+    if(!merger.merge(out_name, block_size)) {
+        std::cerr << merger.get_error() << "\n";
+        return 2;
+    }
+    return 0;
+}
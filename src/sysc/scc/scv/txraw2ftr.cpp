@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#include "scv_tr_db.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+#ifndef HAS_SCV
+#define SCVNS ::scv_tr::
+#else
+#define SCVNS
+#endif
+
+int main(int argc, char* argv[]) {
+    bool compressed = false;
+    int idx = 1;
+    if(idx < argc && std::strcmp(argv[idx], "-c") == 0) {
+        compressed = true;
+        ++idx;
+    }
+    if(idx >= argc || argc - idx > 2) {
+        std::cerr << "usage: " << argv[0] << " [-c] <in.txraw> [out.ftr]\n"
+                  << "  converts a raw transaction log into a FTR database, -c writes a compressed (CFTR) database\n";
+        return 1;
+    }
+    std::string in_name{argv[idx]};
+    std::string out_name;
+    if(idx + 1 < argc)
+        out_name = argv[idx + 1];
+    else {
+        auto pos = in_name.rfind(".txraw");
+        out_name = (pos != std::string::npos ? in_name.substr(0, pos) : in_name) + ".ftr";
+    }
+    if(!SCVNS scv_tr_raw_convert(in_name.c_str(), out_name.c_str(), compressed)) {
+        std::cerr << "could not convert " << in_name << " to " << out_name << "\n";
+        return 2;
+    }
+    return 0;
+}
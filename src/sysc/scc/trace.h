@@ -46,6 +46,11 @@ void close_vcd_mt_trace_file(sc_core::sc_trace_file* tf);
 sc_core::sc_trace_file* create_fst_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
 //! close the FST file
 void close_fst_trace_file(sc_core::sc_trace_file* tf);
+
+//! create indexed waveform format (IWF) file which uses pull mechanism and allows random access by time
+sc_core::sc_trace_file* create_iwf_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
+//! close the IWF file
+void close_iwf_trace_file(sc_core::sc_trace_file* tf);
 } // namespace scc
 /** @} */ // end of scc-sysc
 #endif    // SCC_SC_VCD_TRACE_H
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#ifndef _SCC_TRACE_VCD_SOA_STORE_HH_
+#define _SCC_TRACE_VCD_SOA_STORE_HH_
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace scc {
+namespace trace {
+//! the value buckets of the struct-of-arrays store
+enum class soa_kind : uint8_t { NONE, BOOL, U8, U16, U32 };
+/**
+ * @brief classifies a traced type into a soa_kind, all integral types up to 32 bits are zero extended into the
+ * common U32 value array
+ */
+template <typename T> constexpr soa_kind get_soa_kind() {
+    return std::is_same<T, bool>::value ? soa_kind::BOOL
+           : (!std::is_integral<T>::value || sizeof(T) > sizeof(uint32_t)) ? soa_kind::NONE
+           : sizeof(T) == 1 ? soa_kind::U8
+           : sizeof(T) == 2 ? soa_kind::U16
+           : soa_kind::U32;
+}
+/**
+ * @brief type bucketed struct-of-arrays store for bool and up-to-32bit integer traces
+ *
+ * All bool values are kept in one bitset and all integer values in one uint32_t array. Change detection is
+ * done by a XOR over the contiguous arrays, the VCD identifiers are pre-formatted at finalize() time so
+ * emitting a change is a single append to the output buffer.
+ */
+class vcd_soa_store {
+public:
+    /**
+     * @brief registers a value to be tracked, needs to be called before finalize()
+     *
+     * @param kind the bucket of the value, must not be soa_kind::NONE
+     * @param value pointer to the traced object
+     * @param hndl the VCD identifier of the trace
+     * @return true if the value has been taken over into the store
+     */
+    bool add(soa_kind kind, void const* value, std::string const& hndl) {
+        if(kind == soa_kind::NONE)
+            return false;
+        pending.push_back({kind, value, hndl});
+        return true;
+    }
+    /**
+     * @brief lays out the registered values in contiguous arrays, bool values first followed by the integer
+     * values ordered by their width
+     */
+    void finalize() {
+        std::stable_sort(std::begin(pending), std::end(pending),
+                         [](entry const& a, entry const& b) { return a.kind < b.kind; });
+        for(auto& e : pending) {
+            switch(e.kind) {
+            case soa_kind::BOOL:
+                bool_val.push_back(static_cast<bool const*>(e.value));
+                bool_hndl.push_back(e.hndl + '\n');
+                break;
+            case soa_kind::U8:
+                u8_val.push_back(static_cast<uint8_t const*>(e.value));
+                int_hndl.push_back(' ' + e.hndl + '\n');
+                break;
+            case soa_kind::U16:
+                u16_val.push_back(static_cast<uint16_t const*>(e.value));
+                int_hndl.push_back(' ' + e.hndl + '\n');
+                break;
+            case soa_kind::U32:
+                u32_val.push_back(static_cast<uint32_t const*>(e.value));
+                int_hndl.push_back(' ' + e.hndl + '\n');
+                break;
+            default:
+                break;
+            }
+        }
+        pending.clear();
+        pending.shrink_to_fit();
+        auto words = (bool_val.size() + 63) / 64;
+        bool_old.assign(words, 0);
+        bool_cur.assign(words, 0);
+        int_old.assign(int_hndl.size(), 0);
+        int_cur.assign(int_hndl.size(), 0);
+    }
+    //! the number of values held in the store
+    size_t size() const { return bool_val.size() + int_cur.size(); }
+    /**
+     * @brief samples all values and writes all of them to the buffer (used for $dumpvars)
+     */
+    template <typename BUF> void record_all(BUF& buf) {
+        gather();
+        for(size_t i = 0; i < bool_val.size(); ++i)
+            emit_bool(buf, i, (bool_cur[i >> 6] >> (i & 63)) & 1);
+        for(size_t i = 0; i < int_cur.size(); ++i)
+            emit_int(buf, i);
+        std::swap(bool_old, bool_cur);
+        std::swap(int_old, int_cur);
+    }
+    /**
+     * @brief samples all values and writes the changed ones to the buffer
+     *
+     * @return the number of value changes written
+     */
+    template <typename BUF> size_t record_changes(BUF& buf) {
+        gather();
+        size_t count = 0;
+        for(size_t w = 0; w < bool_cur.size(); ++w) {
+            auto diff = bool_cur[w] ^ bool_old[w];
+            while(diff) {
+                auto bit = ctz(diff);
+                diff &= diff - 1;
+                emit_bool(buf, w * 64 + bit, (bool_cur[w] >> bit) & 1);
+                ++count;
+            }
+        }
+        size_t const block_size = 16;
+        auto const n = int_cur.size();
+        for(size_t blk = 0; blk < n; blk += block_size) {
+            auto const end = std::min(n, blk + block_size);
+            uint32_t acc = 0;
+            for(size_t i = blk; i < end; ++i)
+                acc |= int_cur[i] ^ int_old[i];
+            if(!acc)
+                continue;
+            for(size_t i = blk; i < end; ++i)
+                if(int_cur[i] != int_old[i]) {
+                    emit_int(buf, i);
+                    ++count;
+                }
+        }
+        std::swap(bool_old, bool_cur);
+        std::swap(int_old, int_cur);
+        return count;
+    }
+
+private:
+    struct entry {
+        soa_kind kind;
+        void const* value;
+        std::string hndl;
+    };
+
+    static inline unsigned ctz(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(v);
+#else
+        unsigned r = 0;
+        while(!(v & 1)) {
+            v >>= 1;
+            ++r;
+        }
+        return r;
+#endif
+    }
+
+    inline void gather() {
+        std::fill(std::begin(bool_cur), std::end(bool_cur), 0);
+        for(size_t i = 0; i < bool_val.size(); ++i)
+            bool_cur[i >> 6] |= static_cast<uint64_t>(*bool_val[i]) << (i & 63);
+        auto* dst = int_cur.data();
+        for(auto* p : u8_val)
+            *dst++ = *p;
+        for(auto* p : u16_val)
+            *dst++ = *p;
+        for(auto* p : u32_val)
+            *dst++ = *p;
+    }
+
+    template <typename BUF> inline void emit_bool(BUF& buf, size_t idx, bool val) {
+        buf.push_back(val ? '1' : '0');
+        auto const& h = bool_hndl[idx];
+        buf.append(h.data(), h.data() + h.size());
+    }
+
+    template <typename BUF> inline void emit_int(BUF& buf, size_t idx) {
+        fmt::format_to(std::back_inserter(buf), "b{:b}", int_cur[idx]);
+        auto const& h = int_hndl[idx];
+        buf.append(h.data(), h.data() + h.size());
+    }
+
+    std::vector<entry> pending;
+    std::vector<bool const*> bool_val;
+    std::vector<uint8_t const*> u8_val;
+    std::vector<uint16_t const*> u16_val;
+    std::vector<uint32_t const*> u32_val;
+    std::vector<uint64_t> bool_old, bool_cur;
+    std::vector<uint32_t> int_old, int_cur;
+    std::vector<std::string> bool_hndl, int_hndl;
+};
+} // namespace trace
+} // namespace scc
+#endif // _SCC_TRACE_VCD_SOA_STORE_HH_
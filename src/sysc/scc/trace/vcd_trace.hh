@@ -17,6 +17,7 @@
 #define _SCC_TRACE_VCD_TRACE_HH_
 
 #include "types.hh"
+#include "vcd_soa_store.hh"
 #ifndef FWRITE
 #include <cstdio>
 #define FWRITE(BUF, SZ, LEN, FP) std::fwrite(BUF, SZ, LEN, FP)
@@ -132,6 +133,8 @@ struct vcd_trace {
 
     virtual uintptr_t get_hash() = 0;
 
+    virtual soa_kind get_soa_kind() const { return soa_kind::NONE; }
+
     virtual ~vcd_trace(){};
 
     const std::string name;
@@ -183,6 +186,8 @@ struct vcd_trace_t : public vcd_trace {
 
     uintptr_t get_hash() override { return reinterpret_cast<uintptr_t>(&act_val);}
 
+    soa_kind get_soa_kind() const override { return trace::get_soa_kind<T>(); }
+
     inline bool changed() { return !is_alias && old_val!=act_val; }
 
     void update() override { old_val=act_val; }
@@ -24,7 +24,9 @@
 #include "report.h"
 #include "sc_vcd_trace.h"
 #include "scv/scv_tr_db.h"
+#include "tx_recording_stats.h"
 #include "utilities.h"
+#include "vcd_pull_trace.hh"
 #include <scc/sc_vcd_trace.h>
 #include <scc/trace.h>
 #ifdef HAS_SCV
@@ -38,6 +40,7 @@
 #define SCVNS ::scv_tr::
 #endif
 #endif
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <lwtr/lwtr.h>
@@ -46,6 +49,21 @@
 using namespace sc_core;
 using namespace scc;
 
+namespace {
+sc_core::sc_report_handler_proc prev_report_handler{nullptr};
+std::vector<vcd_pull_trace_file*> flight_recorders;
+
+void flight_recorder_report_handler(const sc_core::sc_report& rep, const sc_core::sc_actions& actions) {
+    if(rep.get_severity() >= sc_core::SC_ERROR)
+        for(auto* f : flight_recorders)
+            f->flush_flight_recorder();
+    if(prev_report_handler)
+        prev_report_handler(rep, actions);
+    else
+        sc_core::sc_report_handler::default_handler(rep, actions);
+}
+} // namespace
+
 tracer::tracer(std::string const&& name, file_type tx_type, file_type sig_type, sc_core::sc_object* top, sc_core::sc_module_name const& nm)
 : tracer_base(nm)
 , cci_broker(cci::cci_get_broker())
@@ -55,18 +73,24 @@ tracer::tracer(std::string const&& name, file_type tx_type, file_type sig_type,
     if(sig_type == ENABLE)
         sig_type = static_cast<file_type>(sig_trace_type.get_value());
     if(sig_type != NONE) {
+        auto enable = [this]() -> bool { return is_capture_enabled(); };
+        capture_supported = true;
         switch(sig_type) {
         default:
             trf = sc_create_vcd_trace_file(name.c_str());
+            capture_supported = false;
             break;
         case PULL_VCD:
-            trf = scc::create_vcd_pull_trace_file(name.c_str());
+            trf = scc::create_vcd_pull_trace_file(name.c_str(), enable);
             break;
         case PUSH_VCD:
-            trf = scc::create_vcd_push_trace_file(name.c_str());
+            trf = scc::create_vcd_push_trace_file(name.c_str(), enable);
             break;
         case FST:
-            trf = scc::create_fst_trace_file(name.c_str());
+            trf = scc::create_fst_trace_file(name.c_str(), enable);
+            break;
+        case IWF:
+            trf = scc::create_iwf_trace_file(name.c_str(), enable);
             break;
         }
     }
@@ -87,8 +111,12 @@ tracer::tracer(std::string const&& name, file_type tx_type, sc_core::sc_trace_fi
 }
 
 tracer::~tracer() {
+    if(flight_recorder)
+        flight_recorders.erase(std::remove(flight_recorders.begin(), flight_recorders.end(), flight_recorder), flight_recorders.end());
     delete txdb;
     delete lwtr_db;
+    if(stats_pending)
+        report_tx_recording_stats();
     if(trf && owned)
         scc_close_vcd_trace_file(trf);
 }
@@ -97,6 +125,13 @@ void tracer::init_tx_db(file_type type, std::string const&& name) {
     if(type != NONE) {
         std::stringstream ss;
         ss << name;
+        auto lwtr = type == LWFTR || type == LWCFTR;
+        auto& stats = scc::tx_recording_stats::get();
+        if(measure_tx_recording.get_value()) {
+            stats.set_enabled(true);
+            if(!lwtr)
+                stats.begin_scv_backend();
+        }
         switch(type) {
         default:
             SCVNS scv_tr_text_init();
@@ -140,8 +175,22 @@ void tracer::init_tx_db(file_type type, std::string const&& name) {
             SCVNS scv_tr_mtc_init();
             ss << ".txlog";
             break;
+#ifdef WITH_TXRAW
+        case RAW:
+            SCVNS scv_tr_raw_init();
+            ss << ".txraw";
+            break;
+#endif
+        }
+        if(stats.is_enabled()) {
+            if(lwtr)
+                stats.add_file(scc::tx_recording_stats::lwtr_backend, name + ".ftr");
+            else {
+                stats.end_scv_backend();
+                stats.add_file(scc::tx_recording_stats::scv_backend, type == FTR || type == CFTR ? ss.str() + ".ftr" : ss.str());
+            }
         }
-        if(type == LWFTR || type == LWCFTR) {
+        if(lwtr) {
             lwtr_db = new lwtr::tx_db(name.c_str());
         } else {
             txdb = new SCVNS scv_tr_db(ss.str().c_str());
@@ -153,6 +202,7 @@ void tracer::init_tx_db(file_type type, std::string const&& name) {
 }
 
 void tracer::end_of_elaboration() {
+    init_capture_control();
     if(trf) {
         if(top) {
             descend(top, trf);
@@ -164,14 +214,91 @@ void tracer::end_of_elaboration() {
 }
 
 void tracer::end_of_simulation() {
+    if(flight_recorder)
+        flight_recorder->flush_flight_recorder();
     if(close_db_in_eos.get_value()) {
         delete txdb;
         txdb = nullptr;
         delete lwtr_db;
         lwtr_db = nullptr;
         if(trf && owned) {
+            if(flight_recorder) {
+                flight_recorders.erase(std::remove(flight_recorders.begin(), flight_recorders.end(), flight_recorder),
+                                       flight_recorders.end());
+                flight_recorder = nullptr;
+            }
             scc_close_vcd_trace_file(trf);
             trf = nullptr;
         }
     }
+    // the backends writing in a background thread complete their files when the database is closed, so the file sizes
+    // are only final then
+    if(close_db_in_eos.get_value())
+        report_tx_recording_stats();
+    else
+        stats_pending = measure_tx_recording.get_value();
+}
+
+void tracer::report_tx_recording_stats() {
+    if(!measure_tx_recording.get_value())
+        return;
+    std::ostringstream os;
+    scc::tx_recording_stats::get().report(os);
+    SCCINFO(SCMOD) << "transaction recording overhead:\n" << os.str();
+}
+
+bool tracer::is_capture_enabled() {
+    if(!capture_windowed)
+        return true;
+    auto const& now = sc_core::sc_time_stamp();
+    if(now < capture_start || (capture_stop > SC_ZERO_TIME && now >= capture_stop))
+        return false;
+    return capture_triggered;
+}
+
+void tracer::init_capture_control() {
+    capture_start = trace_start_time.get_value();
+    capture_stop = trace_stop_time.get_value();
+    capture_triggered = trace_start_trigger.get_value().empty();
+    capture_windowed = capture_start > SC_ZERO_TIME || capture_stop > SC_ZERO_TIME || !trace_start_trigger.get_value().empty() ||
+                       !trace_stop_trigger.get_value().empty();
+    if(capture_windowed && trf && !capture_supported)
+        SCCWARN(SCMOD) << "trace_start_time, trace_stop_time and the trace triggers are only supported for PULL_VCD, PUSH_VCD, FST and "
+                          "IWF signal traces, ignoring them";
+    if(!trace_start_trigger.get_value().empty())
+        add_capture_trigger(trace_start_trigger.get_value(), true);
+    if(!trace_stop_trigger.get_value().empty())
+        add_capture_trigger(trace_stop_trigger.get_value(), false);
+    if(flight_recorder_window.get_value() > SC_ZERO_TIME) {
+        if(auto* vcd = dynamic_cast<vcd_pull_trace_file*>(trf)) {
+            vcd->set_flight_recorder(flight_recorder_window.get_value());
+            flight_recorder = vcd;
+            if(flight_recorders.empty()) {
+                prev_report_handler = sc_core::sc_report_handler::get_handler();
+                sc_core::sc_report_handler::set_handler(flight_recorder_report_handler);
+            }
+            flight_recorders.push_back(vcd);
+        } else
+            SCCWARN(SCMOD) << "flight recorder mode is only supported for PULL_VCD signal traces, ignoring it";
+    }
+}
+
+void tracer::add_capture_trigger(std::string const& name, bool start) {
+    sc_core::sc_event const* evt{nullptr};
+    if(auto* sig = dynamic_cast<sc_core::sc_signal_in_if<bool>*>(sc_core::sc_find_object(name.c_str())))
+        evt = &sig->posedge_event();
+#if(SYSTEMC_VERSION >= 20171012)
+    else
+        evt = sc_core::sc_find_event(name.c_str());
+#endif
+    if(!evt) {
+        SCCWARN(SCMOD) << "could not find event or bool signal " << name << " to " << (start ? "start" : "stop") << " tracing";
+        return;
+    }
+    sc_core::sc_spawn_options opts;
+    opts.spawn_method();
+    opts.dont_initialize();
+    opts.set_sensitivity(evt);
+    sc_core::sc_spawn([this, start]() { capture_triggered = start; }, sc_core::sc_gen_unique_name(start ? "capture_start" : "capture_stop"),
+                      &opts);
 }
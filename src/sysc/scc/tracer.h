@@ -35,6 +35,7 @@ class tx_db;
 namespace sc_core {
 class sc_object;
 class sc_trace_file;
+class sc_event;
 } // namespace sc_core
 
 /** \ingroup scc-sysc
@@ -43,6 +44,7 @@ class sc_trace_file;
 /**@{*/
 //! @brief SCC SystemC utilities
 namespace scc {
+struct vcd_pull_trace_file;
 /**
  * @class tracer
  * @brief a component traversing the SystemC object hierarchy and tracing the objects
@@ -55,6 +57,8 @@ public:
      * @brief defines the transaction trace output type
      *
      * CUSTOM means the caller needs to initialize the database driver (scv_tr_text_init() or alike)
+     * RAW writes an unencoded memory mapped log which needs to be converted to FTR/CFTR after the simulation (see
+     * scv_tr_raw_convert() and the txraw2ftr tool)
      */
     enum file_type {
         NONE,
@@ -67,10 +71,12 @@ public:
         LWFTR,
         LWCFTR,
         CUSTOM,
+        RAW,
         SC_VCD = TEXT,
         PULL_VCD = COMPRESSED,
         PUSH_VCD = SQLITE,
-        FST
+        FST,
+        IWF
     };
     /**
      * cci parameter to determine the file type being used to trace transaction if not specified explicitly
@@ -87,6 +93,41 @@ public:
      */
     cci::cci_param<bool> close_db_in_eos{"close_db_in_eos", false,
                                          "Close the waveform/transaction tracing databases during end_of_simulation"};
+    /**
+     * cci parameter to enable measuring the overhead of transaction recording, see scc::tx_recording_stats. The report
+     * is issued when the databases are closed (in end_of_simulation if close_db_in_eos is set, otherwise in the
+     * destructor) as the file sizes are only final then.
+     */
+    cci::cci_param<bool> measure_tx_recording{"tx_recording_stats", false,
+                                              "Measure the time spent in transaction recording per stream and report it when the "
+                                              "databases are closed"};
+    /**
+     * cci parameter to determine the simulation time when signal tracing starts
+     */
+    cci::cci_param<sc_core::sc_time> trace_start_time{"trace_start_time", sc_core::SC_ZERO_TIME,
+                                                      "Simulation time when signal tracing starts"};
+    /**
+     * cci parameter to determine the simulation time when signal tracing stops
+     */
+    cci::cci_param<sc_core::sc_time> trace_stop_time{"trace_stop_time", sc_core::SC_ZERO_TIME,
+                                                     "Simulation time when signal tracing stops, SC_ZERO_TIME means no stop"};
+    /**
+     * cci parameter naming the sc_event or bool signal which starts signal tracing
+     */
+    cci::cci_param<std::string> trace_start_trigger{
+        "trace_start_trigger", "", "Hierarchical name of a sc_event or bool signal which starts signal tracing when notified resp. rising"};
+    /**
+     * cci parameter naming the sc_event or bool signal which stops signal tracing
+     */
+    cci::cci_param<std::string> trace_stop_trigger{
+        "trace_stop_trigger", "", "Hierarchical name of a sc_event or bool signal which stops signal tracing when notified resp. rising"};
+    /**
+     * cci parameter to enable the flight recorder mode of the signal trace
+     */
+    cci::cci_param<sc_core::sc_time> flight_recorder_window{
+        "flight_recorder_window", sc_core::SC_ZERO_TIME,
+        "If non-zero only this last window of value changes is kept in memory and written to the signal trace upon an error or at "
+        "the end of simulation. Only supported for PULL_VCD signal traces"};
     /**
      * @fn  tracer(const std::string&&, file_type, bool=true)
      * @brief the constructor
@@ -159,6 +200,8 @@ protected:
            sc_core::sc_module_name const& nm);
     void end_of_elaboration() override;
     void end_of_simulation() override;
+    //! check whether the current simulation time is within the capture window
+    bool is_capture_enabled();
 #ifdef HAS_SCV
     scv_tr_db* txdb;
 #else
@@ -170,7 +213,18 @@ protected:
 
 private:
     void init_tx_db(file_type type, std::string const&& name);
+    void init_capture_control();
+    void report_tx_recording_stats();
+    void add_capture_trigger(std::string const& name, bool start);
     bool owned{false};
+    //! true if the recording statistics are reported when the databases are closed in the destructor
+    bool stats_pending{false};
+    bool capture_windowed{false};
+    //! true if the signal trace file created by the tracer evaluates is_capture_enabled()
+    bool capture_supported{false};
+    bool capture_triggered{true};
+    sc_core::sc_time capture_start, capture_stop;
+    vcd_pull_trace_file* flight_recorder{nullptr};
     sc_core::sc_object* top{nullptr};
 };
 
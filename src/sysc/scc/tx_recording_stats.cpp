@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "tx_recording_stats.h"
+#include <fstream>
+#include <iomanip>
+#include <util/id_map.h>
+#ifdef HAS_SCV
+#include <scv.h>
+#else
+#include <scv-tr.h>
+using namespace scv_tr;
+#endif
+
+namespace scc {
+constexpr char const* tx_recording_stats::scv_backend;
+constexpr char const* tx_recording_stats::lwtr_backend;
+
+namespace {
+// the SCV callbacks are called in registration order, the begin callbacks run before and the end callbacks after the
+// ones of the backend. SCV calls them from the simulation thread only so no synchronization is needed
+uint64_t scv_start{0};
+util::id_map<tx_recording_counters*> scv_streams;
+
+tx_recording_counters* get_stream_counters(const scv_tr_stream& s) {
+    auto* counters = scv_streams.find(s.get_id() + 1);
+    if(counters)
+        return *counters;
+    return scv_streams[s.get_id() + 1] = tx_recording_stats::get().get_counters(tx_recording_stats::scv_backend, s.get_name());
+}
+
+inline void add_ticks(tx_recording_counters* counters) {
+    if(counters)
+        counters->ticks += util::tsc_clock::now() - scv_start;
+}
+
+void db_begin_cb(const scv_tr_db&, scv_tr_db::callback_reason, void*) { scv_start = util::tsc_clock::now(); }
+
+void db_end_cb(const scv_tr_db&, scv_tr_db::callback_reason, void*) {
+    add_ticks(tx_recording_stats::get().get_counters(tx_recording_stats::scv_backend));
+}
+
+void stream_begin_cb(const scv_tr_stream&, scv_tr_stream::callback_reason, void*) { scv_start = util::tsc_clock::now(); }
+
+void stream_end_cb(const scv_tr_stream& s, scv_tr_stream::callback_reason, void*) { add_ticks(get_stream_counters(s)); }
+
+void generator_begin_cb(const scv_tr_generator_base&, scv_tr_generator_base::callback_reason, void*) {
+    scv_start = util::tsc_clock::now();
+}
+
+void generator_end_cb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason, void*) {
+    add_ticks(get_stream_counters(g.get_scv_tr_stream()));
+}
+
+void tx_begin_cb(const scv_tr_handle&, scv_tr_handle::callback_reason, void*) { scv_start = util::tsc_clock::now(); }
+
+void tx_end_cb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason, void*) {
+    auto* counters = get_stream_counters(t.get_scv_tr_stream());
+    if(counters) {
+        add_ticks(counters);
+        if(reason == scv_tr_handle::BEGIN)
+            ++counters->transactions;
+    }
+}
+
+void attribute_begin_cb(const scv_tr_handle&, const char*, const scv_extensions_if*, void*) { scv_start = util::tsc_clock::now(); }
+
+void attribute_end_cb(const scv_tr_handle& t, const char*, const scv_extensions_if*, void*) {
+    auto* counters = get_stream_counters(t.get_scv_tr_stream());
+    if(counters) {
+        add_ticks(counters);
+        ++counters->attributes;
+    }
+}
+
+void relation_begin_cb(const scv_tr_handle&, const scv_tr_handle&, void*, scv_tr_relation_handle_t) {
+    scv_start = util::tsc_clock::now();
+}
+
+void relation_end_cb(const scv_tr_handle& t, const scv_tr_handle&, void*, scv_tr_relation_handle_t) {
+    auto* counters = get_stream_counters(t.get_scv_tr_stream());
+    if(counters) {
+        add_ticks(counters);
+        ++counters->relations;
+    }
+}
+
+uint64_t get_file_size(std::string const& name) {
+    std::ifstream ifs(name, std::ios::binary | std::ios::ate);
+    if(!ifs.is_open())
+        return 0;
+    auto size = ifs.tellg();
+    return size > 0 ? static_cast<uint64_t>(size) : 0;
+}
+
+void print(std::ostream& os, std::string const& name, tx_recording_counters const& c) {
+    os << std::left << std::setw(40) << name << std::right << ' ' << std::setw(12) << c.transactions << " tx " << std::setw(12)
+       << c.attributes << " attr " << std::setw(10) << c.relations << " rel ";
+    if(c.bytes)
+        os << std::setw(14) << c.bytes << " bytes ";
+    os << std::fixed << std::setprecision(6) << std::setw(12) << c.seconds() << "s";
+    if(c.transactions)
+        os << ' ' << std::setprecision(1) << std::setw(10) << 1e9 * c.seconds() / c.transactions << "ns/tx";
+    os << std::defaultfloat << "\n";
+}
+} // namespace
+
+tx_recording_stats& tx_recording_stats::get() {
+    static tx_recording_stats inst;
+    return inst;
+}
+
+tx_recording_counters* tx_recording_stats::get_counters(std::string const& backend, std::string const& stream) {
+    return enabled ? &backends[backend].streams[stream] : nullptr;
+}
+
+tx_recording_counters* tx_recording_stats::get_counters(std::string const& backend) {
+    return enabled ? &backends[backend].own : nullptr;
+}
+
+void tx_recording_stats::add_file(std::string const& backend, std::string const& file_name) {
+    backends[backend].files.push_back(file_name);
+}
+
+void tx_recording_stats::begin_scv_backend() {
+    if(scv_begin_registered)
+        return;
+    scv_begin_registered = true;
+    scv_tr_db::register_class_cb(db_begin_cb);
+    scv_tr_stream::register_class_cb(stream_begin_cb);
+    scv_tr_generator_base::register_class_cb(generator_begin_cb);
+    scv_tr_handle::register_class_cb(tx_begin_cb);
+    scv_tr_handle::register_record_attribute_cb(attribute_begin_cb);
+    scv_tr_handle::register_relation_cb(relation_begin_cb);
+}
+
+void tx_recording_stats::end_scv_backend() {
+    if(!scv_begin_registered || scv_end_registered)
+        return;
+    scv_end_registered = true;
+    scv_tr_db::register_class_cb(db_end_cb);
+    scv_tr_stream::register_class_cb(stream_end_cb);
+    scv_tr_generator_base::register_class_cb(generator_end_cb);
+    scv_tr_handle::register_class_cb(tx_end_cb);
+    scv_tr_handle::register_record_attribute_cb(attribute_end_cb);
+    scv_tr_handle::register_relation_cb(relation_end_cb);
+}
+
+std::vector<std::string> tx_recording_stats::get_backends() const {
+    std::vector<std::string> res;
+    for(auto const& e : backends)
+        res.push_back(e.first);
+    return res;
+}
+
+tx_recording_counters tx_recording_stats::get_totals(std::string const& backend) const {
+    tx_recording_counters res;
+    auto it = backends.find(backend);
+    if(it == backends.end())
+        return res;
+    res += it->second.own;
+    for(auto const& s : it->second.streams)
+        res += s.second;
+    for(auto const& f : it->second.files)
+        res.bytes += get_file_size(f);
+    return res;
+}
+
+std::vector<std::pair<std::string, tx_recording_counters>> tx_recording_stats::get_streams(std::string const& backend) const {
+    std::vector<std::pair<std::string, tx_recording_counters>> res;
+    auto it = backends.find(backend);
+    if(it != backends.end())
+        for(auto const& s : it->second.streams)
+            res.emplace_back(s.first, s.second);
+    return res;
+}
+
+void tx_recording_stats::report(std::ostream& os) const {
+    for(auto const& e : backends) {
+        print(os, e.first, get_totals(e.first));
+        for(auto const& s : e.second.streams)
+            print(os, "  " + s.first, s.second);
+    }
+}
+} // namespace scc
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_TX_RECORDING_STATS_H_
+#define _SCC_TX_RECORDING_STATS_H_
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <util/tsc_clock.h>
+#include <utility>
+#include <vector>
+
+/** \ingroup scc-sysc
+ *  @{
+ */
+/**@{*/
+//! @brief SCC SystemC utilities
+namespace scc {
+/**
+ * @struct tx_recording_counters
+ * @brief the overhead counters of a transaction stream or a recording backend
+ */
+struct tx_recording_counters {
+    //! the number of recorded transactions
+    uint64_t transactions{0};
+    //! the number of attribute recordings including the begin and end attributes of a transaction (a compound
+    //! attribute and an extension recording count once)
+    uint64_t attributes{0};
+    //! the number of recorded relations
+    uint64_t relations{0};
+    //! the number of bytes written to the database
+    uint64_t bytes{0};
+    //! the time spent recording in util::tsc_clock ticks
+    uint64_t ticks{0};
+    //! the time spent recording in seconds
+    double seconds() const { return util::tsc_clock::to_seconds(ticks); }
+
+    tx_recording_counters& operator+=(tx_recording_counters const& o) {
+        transactions += o.transactions;
+        attributes += o.attributes;
+        relations += o.relations;
+        bytes += o.bytes;
+        ticks += o.ticks;
+        return *this;
+    }
+};
+/**
+ * @class tx_recording_scope
+ * @brief measures the time spent recording in a scope
+ *
+ * If no counters are given (since measuring is disabled) the scope does nothing.
+ */
+class tx_recording_scope {
+public:
+    explicit tx_recording_scope(tx_recording_counters* counters)
+    : counters(counters)
+    , start(counters ? util::tsc_clock::now() : 0) {}
+
+    tx_recording_scope(tx_recording_scope const&) = delete;
+
+    tx_recording_scope& operator=(tx_recording_scope const&) = delete;
+
+    ~tx_recording_scope() { pause(); }
+    //! stops measuring, e.g. while a recorded transaction is forwarded
+    void pause() {
+        if(counters && running) {
+            counters->ticks += util::tsc_clock::now() - start;
+            running = false;
+        }
+    }
+    //! continues measuring after pause()
+    void resume() {
+        if(counters && !running) {
+            start = util::tsc_clock::now();
+            running = true;
+        }
+    }
+    /**
+     * @brief counts recorded items
+     *
+     * @param transactions the number of transactions
+     * @param attributes the number of attribute recordings
+     * @param relations the number of relations
+     */
+    void count(uint64_t transactions, uint64_t attributes = 0, uint64_t relations = 0) {
+        if(counters) {
+            counters->transactions += transactions;
+            counters->attributes += attributes;
+            counters->relations += relations;
+        }
+    }
+
+private:
+    tx_recording_counters* counters;
+    uint64_t start;
+    bool running{true};
+};
+/**
+ * @class tx_recording_stats
+ * @brief collects the overhead of transaction recording per backend and per stream
+ *
+ * Recording components ask for the counters of their streams when creating them and update them using
+ * tx_recording_scope. For SCV based recording the backend callbacks are measured as a whole by bracketing them with
+ * callbacks of this class (see begin_scv_backend()), so every SCV backend is covered without changes.
+ * The number of bytes is only known per backend, it is the size of the database files at the time of the query. Backends
+ * writing in a background thread complete their files when the database is closed, so only a query afterwards yields
+ * the final size.
+ */
+class tx_recording_stats {
+public:
+    //! the name of the backend counting the SCV based recording
+    static constexpr char const* scv_backend = "SCV";
+    //! the name of the backend counting the LWTR based recording
+    static constexpr char const* lwtr_backend = "LWTR";
+    /**
+     * @fn tx_recording_stats& get()
+     * @brief get the global instance
+     *
+     * @return the instance
+     */
+    static tx_recording_stats& get();
+    //! enables or disables measuring for streams being created afterwards
+    void set_enabled(bool enable) { enabled = enable; }
+    //! true if measuring is enabled
+    bool is_enabled() const { return enabled; }
+    /**
+     * @brief gets the counters of a stream
+     *
+     * @param backend the name of the recording backend
+     * @param stream the name of the stream
+     * @return the counters (stable for the life time of the program) or nullptr if measuring is disabled
+     */
+    tx_recording_counters* get_counters(std::string const& backend, std::string const& stream);
+    /**
+     * @brief gets the counters of a backend not belonging to a stream (e.g. opening and closing the database)
+     *
+     * @param backend the name of the recording backend
+     * @return the counters or nullptr if measuring is disabled
+     */
+    tx_recording_counters* get_counters(std::string const& backend);
+    /**
+     * @brief adds a database file whose size is counted as bytes written by the backend
+     *
+     * @param backend the name of the recording backend
+     * @param file_name the name of the file
+     */
+    void add_file(std::string const& backend, std::string const& file_name);
+    /**
+     * @brief registers the callbacks taking the start time stamps of SCV callbacks
+     *
+     * SCV calls callbacks in the order of their registration, hence this needs to be called before the backend is
+     * initialized (e.g. by scv_tr_ftr_init()) and end_scv_backend() afterwards. The callbacks are registered only once.
+     */
+    void begin_scv_backend();
+    //! registers the callbacks taking the end time stamps of SCV callbacks, see begin_scv_backend()
+    void end_scv_backend();
+    //! the names of the backends having counters
+    std::vector<std::string> get_backends() const;
+    /**
+     * @brief gets the sum of all counters of a backend
+     *
+     * @param backend the name of the recording backend
+     * @return the counters including the size of the database files
+     */
+    tx_recording_counters get_totals(std::string const& backend) const;
+    /**
+     * @brief gets the counters of all streams of a backend
+     *
+     * @param backend the name of the recording backend
+     * @return pairs of stream name and counters
+     */
+    std::vector<std::pair<std::string, tx_recording_counters>> get_streams(std::string const& backend) const;
+    /**
+     * @brief writes a human readable report of all counters
+     *
+     * @param os the stream to write to
+     */
+    void report(std::ostream& os) const;
+
+private:
+    tx_recording_stats() = default;
+
+    struct backend_entry {
+        tx_recording_counters own;
+        std::map<std::string, tx_recording_counters> streams;
+        std::vector<std::string> files;
+    };
+    std::map<std::string, backend_entry> backends;
+    bool enabled{false};
+    bool scv_begin_registered{false};
+    bool scv_end_registered{false};
+};
+} // namespace scc
+/** @} */ // end of scc-sysc
+#endif    /* _SCC_TX_RECORDING_STATS_H_ */
@@ -16,6 +16,8 @@
 
 #include "vcd_pull_trace.hh"
 #include "sc_vcd_trace.h"
+#define FWRITE(BUF, SZ, LEN, FP) (FP)->append(static_cast<char const*>(BUF), static_cast<char const*>(BUF) + (SZ) * (LEN))
+#define FPTR fmt::memory_buffer*
 #include "trace/vcd_trace.hh"
 #include "utilities.h"
 
@@ -33,16 +35,8 @@
 #include <unordered_map>
 #include <vector>
 
-#define FPRINT(FP, FMTSTR)                                                                                                                 \
-    {                                                                                                                                      \
-        auto buf = fmt::format(FMTSTR);                                                                                                    \
-        std::fwrite(buf.c_str(), 1, buf.size(), FP);                                                                                       \
-    }
-#define FPRINTF(FP, FMTSTR, ...)                                                                                                           \
-    {                                                                                                                                      \
-        auto buf = fmt::format(FMTSTR, __VA_ARGS__);                                                                                       \
-        std::fwrite(buf.c_str(), 1, buf.size(), FP);                                                                                       \
-    }
+#define FPRINT(FP, FMTSTR) fmt::format_to(std::back_inserter(FP), FMTSTR);
+#define FPRINTF(FP, FMTSTR, ...) fmt::format_to(std::back_inserter(FP), FMTSTR, __VA_ARGS__);
 
 namespace scc {
 /*******************************************************************************************************
@@ -65,7 +59,9 @@ vcd_pull_trace_file::vcd_pull_trace_file(const char* name, std::function<bool()>
 
 vcd_pull_trace_file::~vcd_pull_trace_file() {
     if(vcd_out) {
-        FPRINTF(vcd_out, "#{}\n", sc_core::sc_time_stamp() / 1_ps);
+        flush_flight_recorder();
+        FPRINTF(out_buf, "#{}\n", sc_core::sc_time_stamp() / 1_ps);
+        write_out();
         fclose(vcd_out);
     }
     for(auto t : all_traces)
@@ -163,7 +159,10 @@ std::string vcd_pull_trace_file::obtain_name() {
     return std::string(buf);
 }
 
-void vcd_pull_trace_file::write_comment(const std::string& comment) { FPRINTF(vcd_out, "$comment\n{}\n$end\n\n", comment); }
+void vcd_pull_trace_file::write_comment(const std::string& comment) {
+    FPRINTF(out_buf, "$comment\n{}\n$end\n\n", comment);
+    write_out();
+}
 
 void vcd_pull_trace_file::init() {
     std::sort(std::begin(all_traces), std::end(all_traces),
@@ -179,8 +178,10 @@ void vcd_pull_trace_file::init() {
             alias_map.insert({e.trc->get_hash(), e.trc->trc_hndl});
         scope.add_trace(e.trc);
     }
-    std::copy_if(std::begin(all_traces), std::end(all_traces), std::back_inserter(active_traces),
-                 [](trace_entry const& e) { return !e.trc->is_alias; });
+    for(auto& e : all_traces)
+        if(!e.trc->is_alias && !soa_traces.add(e.trc->get_soa_kind(), reinterpret_cast<void const*>(e.trc->get_hash()), e.trc->trc_hndl))
+            active_traces.push_back(e);
+    soa_traces.finalize();
     changed_traces.reserve(active_traces.size());
     // date:
     char tbuf[200];
@@ -188,15 +189,15 @@ void vcd_pull_trace_file::init() {
     time(&long_time);
     struct tm* p_tm = localtime(&long_time);
     strftime(tbuf, 199, "%b %d, %Y       %H:%M:%S", p_tm);
-    FPRINTF(vcd_out, "$date\n     {}\n$end\n\n", tbuf);
+    FPRINTF(out_buf, "$date\n     {}\n$end\n\n", tbuf);
     // version:
-    FPRINTF(vcd_out, "$version\n {}\n$end\n\n", sc_core::sc_version());
+    FPRINTF(out_buf, "$version\n {}\n$end\n\n", sc_core::sc_version());
     // timescale:
-    FPRINTF(vcd_out, "$timescale\n     {}\n$end\n\n", (1_ps).to_string());
+    FPRINTF(out_buf, "$timescale\n     {}\n$end\n\n", (1_ps).to_string());
     std::stringstream ss;
-    ss << "tracing " << active_traces.size() << " distinct traces out of " << all_traces.size() << " traces";
+    ss << "tracing " << active_traces.size() + soa_traces.size() << " distinct traces out of " << all_traces.size() << " traces";
     write_comment(ss.str());
-    scope.print(vcd_out);
+    scope.print(&out_buf);
 }
 
 std::string vcd_pull_trace_file::prune_name(std::string const& orig_name) {
@@ -232,12 +233,23 @@ void vcd_pull_trace_file::cycle(bool delta_cycle) {
     if(!initialized) {
         init();
         initialized = true;
-        FPRINT(vcd_out, "$enddefinitions  $end\n\n$dumpvars\n");
+        FPRINT(out_buf, "$enddefinitions  $end\n\n");
+        write_out();
+        if(!ring_window)
+            FPRINT(out_buf, "$dumpvars\n");
         for(auto& e : active_traces) {
             e.compare_and_update(e.trc);
-            e.trc->record(vcd_out);
+            e.trc->record(&out_buf);
+        }
+        soa_traces.record_all(out_buf);
+        if(ring_window) {
+            update_baseline(out_buf.data(), out_buf.size());
+            ring_base_time = static_cast<uint64_t>(sc_core::sc_time_stamp() / 1_ps);
+            out_buf.clear();
+        } else {
+            FPRINT(out_buf, "$end\n\n");
+            write_out();
         }
-        FPRINT(vcd_out, "$end\n\n");
     } else {
         if(check_enabled && !check_enabled())
             return;
@@ -246,12 +258,83 @@ void vcd_pull_trace_file::cycle(bool delta_cycle) {
             if(e.compare_and_update(e.trc))
                 changed_traces.push_back(e.trc);
         }
-        if(changed_traces.size()) {
-            FPRINTF(vcd_out, "#{}\n", sc_core::sc_time_stamp() / 1_ps);
+        soa_buf.clear();
+        soa_traces.record_changes(soa_buf);
+        if(changed_traces.size() || soa_buf.size()) {
+            auto now = static_cast<uint64_t>(sc_core::sc_time_stamp() / 1_ps);
+            if(!ring_window)
+                FPRINTF(out_buf, "#{}\n", now);
+            out_buf.append(soa_buf.data(), soa_buf.data() + soa_buf.size());
             for(auto& t : changed_traces)
-                t->record(vcd_out);
+                t->record(&out_buf);
+            if(ring_window)
+                push_ring(now);
+            else
+                write_out();
+        }
+    }
+}
+
+void vcd_pull_trace_file::write_out() {
+    if(out_buf.size())
+        std::fwrite(out_buf.data(), 1, out_buf.size(), vcd_out);
+    out_buf.clear();
+}
+
+void vcd_pull_trace_file::set_flight_recorder(sc_core::sc_time const& window) {
+    if(initialized) {
+        SC_REPORT_WARNING(sc_core::SC_ID_TRACING_OBJECT_IGNORED_, "flight recorder needs to be enabled before simulation start");
+        return;
+    }
+    ring_window = static_cast<uint64_t>(window / 1_ps);
+}
+
+void vcd_pull_trace_file::push_ring(uint64_t now) {
+    ring.emplace_back(now, std::string(out_buf.data(), out_buf.size()));
+    out_buf.clear();
+    while(ring.size() && ring.front().first + ring_window < now) {
+        update_baseline(ring.front().second.data(), ring.front().second.size());
+        ring_base_time = ring.front().first;
+        ring_evicted = true;
+        ring.pop_front();
+    }
+}
+
+void vcd_pull_trace_file::update_baseline(char const* data, size_t len) {
+    auto const* end = data + len;
+    while(data < end) {
+        auto const* eol = static_cast<char const*>(std::memchr(data, '\n', end - data));
+        eol = eol ? eol + 1 : end;
+        auto const* hndl = data + 1;
+        if(*data == 'b' || *data == 'r') {
+            hndl = static_cast<char const*>(std::memchr(data, ' ', eol - data));
+            hndl = hndl ? hndl + 1 : eol;
         }
+        auto const* hndl_end = eol > hndl && *(eol - 1) == '\n' ? eol - 1 : eol;
+        ring_baseline[std::string(hndl, hndl_end)].assign(data, eol);
+        data = eol;
+    }
+}
+
+void vcd_pull_trace_file::flush_flight_recorder() {
+    if(!ring_window || !initialized)
+        return;
+    if(!baseline_written || ring_evicted) {
+        FPRINTF(out_buf, "#{}\n", ring_base_time);
+        for(auto& e : ring_baseline)
+            out_buf.append(e.second.data(), e.second.data() + e.second.size());
+        baseline_written = true;
+        ring_evicted = false;
+    }
+    for(auto& e : ring) {
+        FPRINTF(out_buf, "#{}\n", e.first);
+        out_buf.append(e.second.data(), e.second.data() + e.second.size());
+        update_baseline(e.second.data(), e.second.size());
+        ring_base_time = e.first;
     }
+    ring.clear();
+    write_out();
+    fflush(vcd_out);
 }
 
 void vcd_pull_trace_file::set_time_unit(double v, sc_core::sc_time_unit tu) {}
@@ -19,8 +19,12 @@
 
 #include <sysc/tracing/sc_trace.h>
 #include <sysc/kernel/sc_ver.h>
-#include <vector>
+#include <deque>
 #include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "trace/vcd_soa_store.hh"
 
 namespace sc_core {
 class sc_time;
@@ -40,6 +44,21 @@ struct vcd_pull_trace_file : public sc_core::sc_trace_file {
     vcd_pull_trace_file(const char *name, std::function<bool()>& enable);
 
     virtual ~vcd_pull_trace_file();
+    /**
+     * @brief switches the trace file into flight recorder mode
+     *
+     * In this mode the value changes are kept in an in-memory ring buffer covering the given window of simulation time
+     * and only written to the file when calling flush_flight_recorder() or when closing the trace file.
+     *
+     * @param window the simulation time span to keep, SC_ZERO_TIME disables the flight recorder
+     */
+    void set_flight_recorder(sc_core::sc_time const& window);
+    /**
+     * @brief writes the content of the flight recorder ring buffer to the file
+     *
+     * The values at the start of the window are written first so that the waveform is complete.
+     */
+    void flush_flight_recorder();
 
 protected:
 #define DECL_TRACE_METHOD_A(tp) void trace(const tp& object, const std::string& name) override;
@@ -106,6 +125,9 @@ private:
 #endif
 
     void init();
+    void write_out();
+    void push_ring(uint64_t now);
+    void update_baseline(char const* data, size_t len);
     std::string prune_name(std::string const& name);
     std::string obtain_name();
     std::function<bool()> check_enabled;
@@ -118,6 +140,15 @@ private:
     };
     std::vector<trace_entry> all_traces, active_traces;
     std::vector<trace::vcd_trace*> changed_traces;;
+    trace::vcd_soa_store soa_traces;
+    fmt::memory_buffer soa_buf;
+    fmt::memory_buffer out_buf;
+    uint64_t ring_window{0};
+    uint64_t ring_base_time{0};
+    bool ring_evicted{false};
+    bool baseline_written{false};
+    std::deque<std::pair<uint64_t, std::string>> ring;
+    std::unordered_map<std::string, std::string> ring_baseline;
     bool initialized{false};
     unsigned vcd_name_index{0};
     std::string name;
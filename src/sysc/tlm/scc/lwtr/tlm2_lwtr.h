@@ -21,13 +21,16 @@
 #include <cci_configuration>
 #include <regex>
 #include <scc/peq.h>
+#include <scc/tx_recording_stats.h>
 #include <sstream>
 #include <string>
 #include <sysc/kernel/sc_dynamic_processes.h>
 #include <tlm/scc/lwtr/lwtr4tlm2_extension_registry.h>
 #include <tlm/scc/tlm_gp_shared.h>
 #include <tlm/scc/tlm_mm.h>
+#include <tlm/scc/tlm_recording_filter.h>
 #include <unordered_map>
+#include <util/id_map.h>
 
 //! @brief LWTR components for TLM2
 namespace tlm {
@@ -92,6 +95,9 @@ public:
     //! \brief the attribute to selectively enable/disable DMI recording
     cci::cci_param<bool> enableDmiTracing{"enableDmiTracing", false};
 
+    //! \brief the parameter holding the rules selecting the recorded transactions, see tlm::scc::tlm_recording_filter
+    cci::cci_param<std::string> recordingFilter{"recordingFilter", ""};
+
     /**
      * @fn  tlm2_lwtr(bool=true, tr_db*=tr_db::get_default_db())
      * @brief The constructor of the component
@@ -126,6 +132,13 @@ public:
         opts.dont_initialize();
         opts.set_sensitivity(&nb_timed_peq.event());
         sc_core::sc_spawn([this]() { nbtx_cb(); }, nullptr, &opts);
+        filter.parse(recordingFilter.get_value());
+        recordingFilter.register_post_write_callback(
+            cci::cci_param_post_write_callback_untyped([this](const cci::cci_param_write_event<>& ev) {
+                std::string spec;
+                if(ev.new_value.try_get(spec))
+                    filter.parse(spec);
+            }));
         initialize_streams();
     }
 
@@ -218,6 +231,12 @@ public:
      * recording is bypassed
      */
     inline bool isRecordingNonBlockingTxEnabled() const { return m_db && enableNbTracing.get_value(); }
+    /*! \brief get the filter selecting the recorded transactions
+     *
+     * The rules of the filter are replaced by the ones of the recordingFilter parameter if it is written.
+     * \return the filter
+     */
+    tlm::scc::tlm_recording_filter& get_filter() { return filter; }
 
 protected:
     //! \brief the port where fw accesses are forwarded to
@@ -266,6 +285,32 @@ private:
     //! transaction generator handle for DMI transactions
     tx_generator<>* dmi_trGetHandle{nullptr};
     tx_generator<sc_dt::uint64, sc_dt::uint64>* dmi_trInvalidateHandle{nullptr};
+    //! the overhead counters of the streams, nullptr if not measured
+    ::scc::tx_recording_counters* b_stats{nullptr};
+    ::scc::tx_recording_counters* nb_stats{nullptr};
+    ::scc::tx_recording_counters* nb_timed_stats{nullptr};
+    ::scc::tx_recording_counters* dmi_stats{nullptr};
+    //! the filter selecting the recorded transactions
+    tlm::scc::tlm_recording_filter filter;
+    //! the non-blocking transactions in flight which have been rejected by the filter at BEGIN_REQ, keyed by address
+    util::id_map<bool> nb_filtered;
+    /*! \brief checks if a non-blocking transaction is excluded from recording
+     *
+     * The filter is evaluated once per transaction when the BEGIN_REQ phase is forwarded, all later phases of
+     * the transaction follow this decision. The rejected transactions are checked even if the filter has been cleared
+     * in the meantime as they have no transaction handles to record their later phases.
+     */
+    bool is_nb_filtered(typename TYPES::tlm_payload_type& trans, const typename TYPES::tlm_phase_type& phase, bool fw) {
+        if(fw && phase == tlm::BEGIN_REQ) {
+            if(filter.accept(trans)) {
+                nb_filtered.erase(reinterpret_cast<uintptr_t>(&trans));
+                return false;
+            }
+            nb_filtered[reinterpret_cast<uintptr_t>(&trans)] = true;
+            return true;
+        }
+        return nb_filtered.find(reinterpret_cast<uintptr_t>(&trans)) != nullptr;
+    }
 
 protected:
     void initialize_streams() {
@@ -275,6 +320,8 @@ protected:
         }
         if(isRecordingBlockingTxEnabled() && !b_streamHandle) {
             b_streamHandle = new tx_fiber((full_name + "_bl").c_str(), "[TLM][base-protocol][b]", m_db);
+            // the timed transactions are recorded in the same call and are accounted for this stream
+            b_stats = ::scc::tx_recording_stats::get().get_counters(::scc::tx_recording_stats::lwtr_backend, full_name + "_bl");
             b_trHandle[tlm::TLM_READ_COMMAND] =
                 new tx_generator<sc_core::sc_time, sc_core::sc_time>("read", *b_streamHandle, "start_delay", "end_delay");
             b_trHandle[tlm::TLM_WRITE_COMMAND] =
@@ -290,16 +337,20 @@ protected:
         }
         if(isRecordingNonBlockingTxEnabled() && !nb_streamHandle) {
             nb_streamHandle = new tx_fiber((full_name + "_nb").c_str(), "[TLM][base-protocol][nb]", m_db);
+            nb_stats = ::scc::tx_recording_stats::get().get_counters(::scc::tx_recording_stats::lwtr_backend, full_name + "_nb");
             nb_trHandle[FW] = new tx_generator<std::string, std::string>("fw", *nb_streamHandle, "tlm_phase", "tlm_phase[return_path]");
             nb_trHandle[BW] = new tx_generator<std::string, std::string>("bw", *nb_streamHandle, "tlm_phase", "tlm_phase[return_path]");
             if(enableTimedTracing.get_value()) {
                 nb_streamHandleTimed = new tx_fiber((full_name + "_nb_timed").c_str(), "[TLM][base-protocol][nb][timed]", m_db);
+                nb_timed_stats =
+                    ::scc::tx_recording_stats::get().get_counters(::scc::tx_recording_stats::lwtr_backend, full_name + "_nb_timed");
                 nb_trTimedHandle[FW] = new tx_generator<>("request", *nb_streamHandleTimed);
                 nb_trTimedHandle[BW] = new tx_generator<>("response", *nb_streamHandleTimed);
             }
         }
         if(m_db && enableDmiTracing.get_value() && !dmi_streamHandle) {
             dmi_streamHandle = new tx_fiber((full_name + "_dmi").c_str(), "[TLM][base-protocol][dmi]", m_db);
+            dmi_stats = ::scc::tx_recording_stats::get().get_counters(::scc::tx_recording_stats::lwtr_backend, full_name + "_dmi");
             dmi_trGetHandle = new tx_generator<>("get", *dmi_streamHandle);
             dmi_trInvalidateHandle =
                 new tx_generator<sc_dt::uint64, sc_dt::uint64>("invalidate", *dmi_streamHandle, "start_addr", "end_addr");
@@ -336,25 +387,32 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename TYPES> void tlm2_lwtr<TYPES>::b_transport(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay) {
-    if(!isRecordingBlockingTxEnabled()) {
+    if(!isRecordingBlockingTxEnabled() || (filter.is_active() && !filter.accept(trans))) {
         fw_port->b_transport(trans, delay);
         return;
     }
+    ::scc::tx_recording_scope rec_scope(b_stats);
     // Get a handle for the new transaction
     tx_handle h = b_trHandle[trans.get_command()]->begin_tx(delay);
+    rec_scope.count(1, 1);
     tx_handle htim;
     /*************************************************************************
      * do the timed notification
      *************************************************************************/
-    if(b_streamHandleTimed)
+    if(b_streamHandleTimed) {
         htim = b_trTimedHandle[trans.get_command()]->begin_tx_delayed(sc_core::sc_time_stamp() + delay, par_chld_hndl, h);
+        rec_scope.count(1, 0, 1);
+    }
 
     if(registered)
         for(auto& extensionRecording : lwtr4tlm2_extension_registry<TYPES>::inst().get())
             if(extensionRecording) {
                 extensionRecording->recordBeginTx(h, trans);
-                if(htim.is_valid())
+                rec_scope.count(0, 1);
+                if(htim.is_valid()) {
                     extensionRecording->recordBeginTx(htim, trans);
+                    rec_scope.count(0, 1);
+                }
             }
     link_pred_ext* preExt = nullptr;
 
@@ -367,10 +425,13 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::b_transport(typename TYPES::tlm
             trans.set_extension(preExt);
     } else {
         h.add_relation(pred_succ_hndl, preExt->txHandle);
+        rec_scope.count(0, 0, 1);
     }
     tx_handle preTx{preExt->txHandle};
     preExt->txHandle = h;
+    rec_scope.pause();
     fw_port->b_transport(trans, delay);
+    rec_scope.resume();
     trans.get_extension(preExt);
     if(preExt->creator == this) {
         // clean-up the extension if this is the original creator
@@ -382,19 +443,25 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::b_transport(typename TYPES::tlm
         preExt->txHandle = preTx;
     }
     h.record_attribute("trans", trans);
+    rec_scope.count(0, 1);
     if(registered)
         for(auto& extensionRecording : lwtr4tlm2_extension_registry<TYPES>::inst().get())
             if(extensionRecording) {
                 extensionRecording->recordEndTx(h, trans);
-                if(htim.is_active())
+                rec_scope.count(0, 1);
+                if(htim.is_active()) {
                     extensionRecording->recordEndTx(htim, trans);
+                    rec_scope.count(0, 1);
+                }
             }
     // End the transaction
     h.end_tx(delay);
+    rec_scope.count(0, 1);
     // and now the stuff for the timed tx
     if(htim.is_valid()) {
         htim.record_attribute("trans", trans);
         htim.end_tx_delayed(sc_core::sc_time_stamp() + delay);
+        rec_scope.count(0, 1);
     }
 }
 
@@ -403,11 +470,19 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw(typename TYPES::tlm_payload
                                                      sc_core::sc_time& delay) {
     if(!isRecordingNonBlockingTxEnabled())
         return fw_port->nb_transport_fw(trans, phase, delay);
+    if((filter.is_active() || !nb_filtered.empty()) && is_nb_filtered(trans, phase, true)) {
+        auto status = fw_port->nb_transport_fw(trans, phase, delay);
+        if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+            nb_filtered.erase(reinterpret_cast<uintptr_t>(&trans));
+        return status;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
+    ::scc::tx_recording_scope rec_scope(nb_stats);
     // Get a handle for the new transaction
     tx_handle h = nb_trHandle[FW]->begin_tx(phase2string(phase));
+    rec_scope.count(1, 1);
     link_pred_ext* preExt = nullptr;
     trans.get_extension(preExt);
     if(preExt == nullptr) { // we are the first recording this transaction
@@ -419,14 +494,18 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw(typename TYPES::tlm_payload
     } else {
         // link handle if we have a predecessor
         h.add_relation(pred_succ_hndl, preExt->txHandle);
+        rec_scope.count(0, 0, 1);
     }
     // update the extension
     preExt->txHandle = h;
     h.record_attribute("delay", delay);
+    rec_scope.count(0, 1);
     if(registered)
         for(auto& extensionRecording : lwtr4tlm2_extension_registry<TYPES>::inst().get())
-            if(extensionRecording)
+            if(extensionRecording) {
                 extensionRecording->recordBeginTx(h, trans);
+                rec_scope.count(0, 1);
+            }
     /*************************************************************************
      * do the timed notification
      *************************************************************************/
@@ -438,17 +517,22 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw(typename TYPES::tlm_payload
     /*************************************************************************
      * do the access
      *************************************************************************/
+    rec_scope.pause();
     tlm::tlm_sync_enum status = fw_port->nb_transport_fw(trans, phase, delay);
+    rec_scope.resume();
     /*************************************************************************
      * handle recording
      *************************************************************************/
     h.record_attribute("tlm_sync", status);
     h.record_attribute("delay[return_path]", delay);
     h.record_attribute("trans", trans);
+    rec_scope.count(0, 3);
     if(registered)
         for(auto& extensionRecording : lwtr4tlm2_extension_registry<TYPES>::inst().get())
-            if(extensionRecording)
+            if(extensionRecording) {
                 extensionRecording->recordEndTx(h, trans);
+                rec_scope.count(0, 1);
+            }
     // get the extension and free the memory if it was mine
     if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_ACCEPTED && phase == tlm::END_RESP)) {
         trans.get_extension(preExt);
@@ -473,6 +557,7 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw(typename TYPES::tlm_payload
     }
     // End the transaction
     nb_trHandle[FW]->end_tx(h, phase2string(phase));
+    rec_scope.count(0, 1);
     return status;
 }
 
@@ -481,24 +566,36 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_bw(typename TYPES::tlm_payload
                                                      sc_core::sc_time& delay) {
     if(!isRecordingNonBlockingTxEnabled())
         return bw_port->nb_transport_bw(trans, phase, delay);
+    if((filter.is_active() || !nb_filtered.empty()) && is_nb_filtered(trans, phase, false)) {
+        auto status = bw_port->nb_transport_bw(trans, phase, delay);
+        if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+            nb_filtered.erase(reinterpret_cast<uintptr_t>(&trans));
+        return status;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
+    ::scc::tx_recording_scope rec_scope(nb_stats);
     link_pred_ext* preExt = nullptr;
     trans.get_extension(preExt);
     // Get a handle for the new transaction
     tx_handle h = nb_trHandle[BW]->begin_tx(phase2string(phase));
+    rec_scope.count(1, 1);
     // link handle if we have a predecessor and that's not ourself
     if(preExt) {
         h.add_relation(pred_succ_hndl, preExt->txHandle);
+        rec_scope.count(0, 0, 1);
         // and set the extension handle to this transaction
         preExt->txHandle = h;
     }
     // and set the extension handle to this transaction
     h.record_attribute("delay", delay);
+    rec_scope.count(0, 1);
     for(auto& extensionRecording : lwtr4tlm2_extension_registry<TYPES>::inst().get())
-        if(extensionRecording)
+        if(extensionRecording) {
             extensionRecording->recordBeginTx(h, trans);
+            rec_scope.count(0, 1);
+        }
     /*************************************************************************
      * do the timed notification
      *************************************************************************/
@@ -510,19 +607,25 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_bw(typename TYPES::tlm_payload
     /*************************************************************************
      * do the access
      *************************************************************************/
+    rec_scope.pause();
     tlm::tlm_sync_enum status = bw_port->nb_transport_bw(trans, phase, delay);
+    rec_scope.resume();
     /*************************************************************************
      * handle recording
      *************************************************************************/
     h.record_attribute("tlm_sync", status);
     h.record_attribute("delay[return_path]", delay);
     h.record_attribute("trans", trans);
+    rec_scope.count(0, 3);
     if(registered)
         for(auto& extensionRecording : lwtr4tlm2_extension_registry<TYPES>::inst().get())
-            if(extensionRecording)
+            if(extensionRecording) {
                 extensionRecording->recordEndTx(h, trans);
+                rec_scope.count(0, 1);
+            }
     // End the transaction
     nb_trHandle[BW]->end_tx(h, phase2string(phase));
+    rec_scope.count(0, 1);
     // get the extension and free the memory if it was mine
     if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_UPDATED && phase == tlm::END_RESP)) {
         // the transaction is finished
@@ -548,12 +651,14 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_bw(typename TYPES::tlm_payload
 template <typename TYPES> void tlm2_lwtr<TYPES>::nbtx_cb() {
     auto opt = nb_timed_peq.get_next();
     if(opt) {
+        ::scc::tx_recording_scope rec_scope(nb_timed_stats);
         auto& e = opt.get();
         tx_handle h;
         switch(e.ph) { // Now process outstanding recordings
         case tlm::BEGIN_REQ:
             h = nb_trTimedHandle[REQ]->begin_tx(par_chld_hndl, e.parent);
             nbtx_req_handle_map[e.id] = h;
+            rec_scope.count(1, 0, 1);
             break;
         case tlm::END_REQ: {
             auto it = nbtx_req_handle_map.find(e.id);
@@ -563,6 +668,7 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::nbtx_cb() {
             h.record_attribute("trans", *e.tr);
             h.end_tx();
             nbtx_last_req_handle_map[e.id] = h;
+            rec_scope.count(0, 1);
         } break;
         case tlm::BEGIN_RESP: {
             auto it = nbtx_req_handle_map.find(e.id);
@@ -572,14 +678,17 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::nbtx_cb() {
                 h.record_attribute("trans", *e.tr);
                 h.end_tx();
                 nbtx_last_req_handle_map[e.id] = h;
+                rec_scope.count(0, 1);
             }
             h = nb_trTimedHandle[RESP]->begin_tx(par_chld_hndl, e.parent);
             nbtx_req_handle_map[e.id] = h;
+            rec_scope.count(1, 0, 1);
             it = nbtx_last_req_handle_map.find(e.id);
             if(it != nbtx_last_req_handle_map.end()) {
                 tx_handle pred = it->second;
                 nbtx_last_req_handle_map.erase(it);
                 h.add_relation(pred_succ_hndl, pred);
+                rec_scope.count(0, 0, 1);
             }
         } break;
         case tlm::END_RESP: {
@@ -589,6 +698,7 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::nbtx_cb() {
                 nbtx_req_handle_map.erase(it);
                 h.record_attribute("trans", *e.tr);
                 h.end_tx();
+                rec_scope.count(0, 1);
             }
         } break;
         default:
@@ -602,10 +712,15 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::nbtx_cb() {
 template <typename TYPES> bool tlm2_lwtr<TYPES>::get_direct_mem_ptr(typename TYPES::tlm_payload_type& trans, tlm::tlm_dmi& dmi_data) {
     if(!(m_db && enableDmiTracing.get_value()))
         return fw_port->get_direct_mem_ptr(trans, dmi_data);
+    ::scc::tx_recording_scope rec_scope(dmi_stats);
     tx_handle h = dmi_trGetHandle->begin_tx();
+    rec_scope.count(1);
+    rec_scope.pause();
     bool status = fw_port->get_direct_mem_ptr(trans, dmi_data);
+    rec_scope.resume();
     h.record_attribute("trans", trans);
     h.record_attribute("dmi_data", dmi_data);
+    rec_scope.count(0, 2);
     h.end_tx();
     return status;
 }
@@ -620,9 +735,14 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::invalidate_direct_mem_ptr(sc_dt
         bw_port->invalidate_direct_mem_ptr(start_addr, end_addr);
         return;
     }
+    ::scc::tx_recording_scope rec_scope(dmi_stats);
     tx_handle h = dmi_trInvalidateHandle->begin_tx(start_addr);
+    rec_scope.count(1, 1);
+    rec_scope.pause();
     bw_port->invalidate_direct_mem_ptr(start_addr, end_addr);
+    rec_scope.resume();
     dmi_trInvalidateHandle->end_tx(h, end_addr);
+    rec_scope.count(0, 1);
     return;
 }
 /*! \brief The debug transportfunction
@@ -24,10 +24,12 @@
 #include <sstream>
 #include <string>
 #include <sysc/kernel/sc_dynamic_processes.h>
-#include <tlm/scc/tlm_mm.h>
+#include <tlm/scc/tlm_recording_filter.h>
 #include <tlm>
 #include <tlm_utils/peq_with_cb_and_phase.h>
-#include <unordered_map>
+#include <memory>
+#include <util/id_map.h>
+#include <vector>
 
 //! @brief SystemC TLM
 namespace tlm {
@@ -45,6 +47,8 @@ namespace impl {
 template <typename TYPES = tlm::tlm_base_protocol_types> class tlm_recording_payload : public TYPES::tlm_payload_type {
 public:
     SCVNS scv_tr_handle parent;
+    //! the handle of the timed transaction of a blocking transaction
+    SCVNS scv_tr_handle timed;
     uint64_t id;
     tlm_recording_payload& operator=(const typename TYPES::tlm_payload_type& x) {
         id = reinterpret_cast<uintptr_t>(&x);
@@ -67,6 +71,44 @@ template <typename TYPES = tlm::tlm_base_protocol_types> struct tlm_recording_ty
     using tlm_payload_type = tlm_recording_payload<TYPES>;
     using tlm_phase_type = typename TYPES::tlm_phase_type;
 };
+/**
+ * @brief a memory manager recycling the payloads of the timed recording
+ *
+ * Returned payloads are kept fully constructed (including their extension array) on a free list so that taking a
+ * payload from the pool does not touch the heap once enough payloads for the transactions in flight exist.
+ */
+template <typename TYPES = tlm::tlm_base_protocol_types> class tlm_recording_payload_pool : public tlm::tlm_mm_interface {
+public:
+    tlm_recording_payload<TYPES>* allocate() {
+        if(free_list.empty()) {
+            payloads.emplace_back(new tlm_recording_payload<TYPES>(this));
+            free_list.reserve(payloads.size());
+            return payloads.back().get();
+        }
+        auto* ret = free_list.back();
+        free_list.pop_back();
+        return ret;
+    }
+
+    void free(tlm::tlm_generic_payload* trans) override {
+        auto* rec = static_cast<tlm_recording_payload<TYPES>*>(trans);
+        rec->parent = SCVNS scv_tr_handle();
+        rec->timed = SCVNS scv_tr_handle();
+        rec->reset();
+        free_list.push_back(rec);
+    }
+
+private:
+    std::vector<std::unique_ptr<tlm_recording_payload<TYPES>>> payloads;
+    std::vector<tlm_recording_payload<TYPES>*> free_list;
+};
+//! the handles of the timed view of a non-blocking transaction
+struct nb_timed_handles {
+    //! the currently open request or response transaction
+    SCVNS scv_tr_handle open;
+    //! the last finished request transaction, the predecessor of the response transaction
+    SCVNS scv_tr_handle last;
+};
 
 } // namespace impl
 /*! \brief The TLM2 transaction recorder
@@ -87,7 +129,6 @@ class tlm_recorder : public virtual tlm::tlm_fw_transport_if<TYPES>, public virt
 
 public:
     using recording_types = impl::tlm_recording_types<TYPES>;
-    using mm = tlm::scc::tlm_mm<recording_types>;
     using tlm_recording_payload = impl::tlm_recording_payload<TYPES>;
 
     //! \brief the attribute to selectively enable/disable recording of blocking protocol tx
@@ -102,6 +143,9 @@ public:
     //! \brief the attribute to selectively enable/disable DMI recording
     sc_core::sc_attribute<bool> enableDmiTracing{"enableDmiTracing", false};
 
+    //! \brief the attribute holding the rules selecting the recorded transactions, see tlm::scc::tlm_recording_filter
+    sc_core::sc_attribute<std::string> recordingFilter{"recordingFilter", ""};
+
     //! \brief the port where fw accesses are forwarded to
     sc_core::sc_port_b<tlm::tlm_fw_transport_if<TYPES>>& fw_port;
 
@@ -151,9 +195,7 @@ public:
     , fixed_basename(name) {}
 
     virtual ~tlm_recorder() override {
-        btx_handle_map.clear();
-        nbtx_req_handle_map.clear();
-        nbtx_last_req_handle_map.clear();
+        nbtx_handles.clear();
         delete b_streamHandle;
         for(auto* p : b_trHandle)
             delete p; // NOLINT
@@ -240,6 +282,13 @@ public:
      * recording is bypassed
      */
     inline bool isRecordingNonBlockingTxEnabled() const { return m_db && enableNbTracing.value; }
+    /*! \brief get the filter selecting the recorded transactions
+     *
+     * The rules of the filter are replaced by the ones of the recordingFilter attribute if it is changed, the
+     * attribute is checked with each recorded transaction.
+     * \return the filter
+     */
+    tlm::scc::tlm_recording_filter& get_filter() { return filter; }
 
 private:
     //! event queue to hold time points of blocking transactions
@@ -267,7 +316,6 @@ private:
     //! transaction generator handle for blocking transactions with annotated
     //! delays
     std::array<SCVNS scv_tr_generator<>*, 3> b_trTimedHandle{{nullptr, nullptr, nullptr}};
-    std::unordered_map<uint64_t, SCVNS scv_tr_handle> btx_handle_map;
 
     enum DIR { FW, BW, REQ = FW, RESP = BW };
     //! non-blocking transaction recording stream handle
@@ -278,14 +326,60 @@ private:
     std::array<SCVNS scv_tr_generator<std::string, std::string>*, 2> nb_trHandle{{nullptr, nullptr}};
     //! transaction generator handle for non-blocking transactions with annotated delays
     std::array<SCVNS scv_tr_generator<>*, 2> nb_trTimedHandle{{nullptr, nullptr}};
-    std::unordered_map<uint64_t, SCVNS scv_tr_handle> nbtx_req_handle_map;
-    std::unordered_map<uint64_t, SCVNS scv_tr_handle> nbtx_last_req_handle_map;
+    //! the handles of the timed view of the non-blocking transactions in flight
+    util::id_map<impl::nb_timed_handles> nbtx_handles;
+    //! the payloads carrying the timed recording data through the event queues
+    impl::tlm_recording_payload_pool<TYPES> rec_pool;
+    /*! \brief takes a payload from the pool and fills it for the timed recording
+     *
+     * \param trans the payload of the transaction being recorded
+     * \param parent the handle of the untimed transaction
+     * \return the acquired recording payload
+     */
+    tlm_recording_payload* get_timed_payload(typename TYPES::tlm_payload_type const& trans, SCVNS scv_tr_handle const& parent) {
+        auto* req = rec_pool.allocate();
+        req->acquire();
+        (*req) = trans;
+        req->parent = parent;
+        return req;
+    }
 
     //! dmi transaction recording stream handle
     SCVNS scv_tr_stream* dmi_streamHandle{nullptr};
     //! transaction generator handle for DMI transactions
     SCVNS scv_tr_generator<>* dmi_trGetHandle{nullptr};
     SCVNS scv_tr_generator<sc_dt::uint64, sc_dt::uint64>* dmi_trInvalidateHandle{nullptr};
+    //! the filter selecting the recorded transactions
+    tlm::scc::tlm_recording_filter filter;
+    //! the filter rules last taken from the recordingFilter attribute
+    std::string filter_spec;
+    //! the non-blocking transactions in flight which have been rejected by the filter at BEGIN_REQ, keyed by address
+    util::id_map<bool> nb_filtered;
+    /*! \brief checks if a non-blocking transaction is excluded from recording
+     *
+     * The filter is evaluated once per transaction when the BEGIN_REQ phase is forwarded, all later phases of
+     * the transaction follow this decision. The rejected transactions are checked even if the filter has been cleared
+     * in the meantime as they have no transaction handles to record their later phases.
+     */
+    bool is_nb_filtered(typename TYPES::tlm_payload_type& trans, const typename TYPES::tlm_phase_type& phase, bool fw) {
+        if(fw && phase == tlm::BEGIN_REQ) {
+            if(filter.accept(trans)) {
+                nb_filtered.erase(reinterpret_cast<uintptr_t>(&trans));
+                return false;
+            }
+            nb_filtered[reinterpret_cast<uintptr_t>(&trans)] = true;
+            return true;
+        }
+        return nb_filtered.find(reinterpret_cast<uintptr_t>(&trans)) != nullptr;
+    }
+
+    //! takes over the rules of the recordingFilter attribute if it has been changed since sc_attribute has no callbacks
+    inline void update_filter() {
+        if(recordingFilter.value != filter_spec) {
+            filter_spec = recordingFilter.value;
+            filter.parse(filter_spec);
+        }
+    }
 
 public:
     void initialize_streams() {
@@ -346,16 +440,18 @@ template <typename TYPES> void tlm_recorder<TYPES>::b_transport(typename TYPES::
         return;
     } else if(!b_streamHandle)
         initialize_streams();
+    update_filter();
+    if(filter.is_active() && !filter.accept(trans)) {
+        fw_port->b_transport(trans, delay);
+        return;
+    }
     // Get a handle for the new transaction
     SCVNS scv_tr_handle h = b_trHandle[trans.get_command()]->begin_transaction(delay.value(), sc_core::sc_time_stamp());
     /*************************************************************************
      * do the timed notification
      *************************************************************************/
     if(b_streamHandleTimed) {
-        req = mm::get().allocate();
-        req->acquire();
-        (*req) = trans;
-        req->parent = h;
+        req = get_timed_payload(trans, h);
         req->id = h.get_id();
         b_timed_peq.notify(*req, tlm::BEGIN_REQ, delay);
     }
@@ -406,13 +502,11 @@ template <typename TYPES> void tlm_recorder<TYPES>::btx_cb(tlm_recording_payload
     case tlm::BEGIN_REQ: {
         h = b_trTimedHandle[rec_parts.get_command()]->begin_transaction();
         h.add_relation(rel_str(PARENT_CHILD), rec_parts.parent);
-        btx_handle_map[rec_parts.id] = h;
+        rec_parts.timed = h;
     } break;
     case tlm::END_RESP: {
-        auto it = btx_handle_map.find(rec_parts.id);
-        sc_assert(it != btx_handle_map.end());
-        h = it->second;
-        btx_handle_map.erase(it);
+        h = rec_parts.timed;
+        sc_assert(h.is_valid());
         record(h, rec_parts);
         h.end_transaction();
         rec_parts.release();
@@ -430,6 +524,13 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
         return fw_port->nb_transport_fw(trans, phase, delay);
     else if(!nb_streamHandle)
         initialize_streams();
+    update_filter();
+    if((filter.is_active() || !nb_filtered.empty()) && is_nb_filtered(trans, phase, true)) {
+        auto status = fw_port->nb_transport_fw(trans, phase, delay);
+        if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+            nb_filtered.erase(reinterpret_cast<uintptr_t>(&trans));
+        return status;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -458,11 +559,7 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
      * do the timed notification
      *************************************************************************/
     if(nb_streamHandleTimed) {
-        auto* req = mm::get().allocate();
-        req->acquire();
-        (*req) = trans;
-        req->parent = h;
-        nb_timed_peq.notify(*req, phase, delay);
+        nb_timed_peq.notify(*get_timed_payload(trans, h), phase, delay);
     }
     /*************************************************************************
      * do the access
@@ -490,18 +587,11 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
          * do the timed notification if req. finished here
          *************************************************************************/
         if(nb_streamHandleTimed) {
-            tlm_recording_payload* req = mm::get().allocate();
-            req->acquire();
-            (*req) = trans;
-            req->parent = h;
-            nb_timed_peq.notify(*req, (status == tlm::TLM_COMPLETED && phase == tlm::BEGIN_REQ) ? tlm::END_RESP : phase, delay);
+            nb_timed_peq.notify(*get_timed_payload(trans, h),
+                                (status == tlm::TLM_COMPLETED && phase == tlm::BEGIN_REQ) ? tlm::END_RESP : phase, delay);
         }
     } else if(nb_streamHandleTimed && status == tlm::TLM_UPDATED) {
-        tlm_recording_payload* req = mm::get().allocate();
-        req->acquire();
-        (*req) = trans;
-        req->parent = h;
-        nb_timed_peq.notify(*req, phase, delay);
+        nb_timed_peq.notify(*get_timed_payload(trans, h), phase, delay);
     }
     // End the transaction
     nb_trHandle[FW]->end_transaction(h, phase2string(phase));
@@ -515,6 +605,13 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payl
         return bw_port->nb_transport_bw(trans, phase, delay);
     else if(!nb_streamHandle)
         initialize_streams();
+    update_filter();
+    if((filter.is_active() || !nb_filtered.empty()) && is_nb_filtered(trans, phase, false)) {
+        auto status = bw_port->nb_transport_bw(trans, phase, delay);
+        if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+            nb_filtered.erase(reinterpret_cast<uintptr_t>(&trans));
+        return status;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -537,11 +634,7 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payl
      * do the timed notification
      *************************************************************************/
     if(nb_streamHandleTimed) {
-        tlm_recording_payload* req = mm::get().allocate();
-        req->acquire();
-        (*req) = trans;
-        req->parent = h;
-        nb_timed_peq.notify(*req, phase, delay);
+        nb_timed_peq.notify(*get_timed_payload(trans, h), phase, delay);
     }
     /*************************************************************************
      * do the access
@@ -571,11 +664,7 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payl
          * do the timed notification if req. finished here
          *************************************************************************/
         if(nb_streamHandleTimed) {
-            tlm_recording_payload* req = mm::get().allocate();
-            req->acquire();
-            (*req) = trans;
-            req->parent = h;
-            nb_timed_peq.notify(*req, phase, delay);
+            nb_timed_peq.notify(*get_timed_payload(trans, h), phase, delay);
         }
     }
     return status;
@@ -583,45 +672,40 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payl
 
 template <typename TYPES> void tlm_recorder<TYPES>::nbtx_cb(tlm_recording_payload& rec_parts, const typename TYPES::tlm_phase_type& phase) {
     SCVNS scv_tr_handle h;
-    std::unordered_map<uint64_t, SCVNS scv_tr_handle>::iterator it;
+    impl::nb_timed_handles* handles;
     switch(phase) { // Now process outstanding recordings
     case tlm::BEGIN_REQ:
         h = nb_trTimedHandle[REQ]->begin_transaction(rel_str(PARENT_CHILD), rec_parts.parent);
         record(h, rec_parts);
-        nbtx_req_handle_map[rec_parts.id] = h;
+        nbtx_handles[rec_parts.id].open = h;
         break;
     case tlm::END_REQ:
-        it = nbtx_req_handle_map.find(rec_parts.id);
-        sc_assert(it != nbtx_req_handle_map.end());
-        h = it->second;
-        nbtx_req_handle_map.erase(it);
-        h.end_transaction();
-        nbtx_last_req_handle_map[rec_parts.id] = h;
+        handles = nbtx_handles.find(rec_parts.id);
+        sc_assert(handles != nullptr && handles->open.is_valid());
+        handles->open.end_transaction();
+        handles->last = handles->open;
+        handles->open = SCVNS scv_tr_handle();
         break;
     case tlm::BEGIN_RESP:
-        it = nbtx_req_handle_map.find(rec_parts.id);
-        if(it != nbtx_req_handle_map.end()) {
-            h = it->second;
-            nbtx_req_handle_map.erase(it);
-            h.end_transaction();
-            nbtx_last_req_handle_map[rec_parts.id] = h;
+        handles = &nbtx_handles[rec_parts.id];
+        if(handles->open.is_valid()) {
+            handles->open.end_transaction();
+            handles->last = handles->open;
         }
         h = nb_trTimedHandle[RESP]->begin_transaction(rel_str(PARENT_CHILD), rec_parts.parent);
         record(h, rec_parts);
-        nbtx_req_handle_map[rec_parts.id] = h;
-        it = nbtx_last_req_handle_map.find(rec_parts.id);
-        if(it != nbtx_last_req_handle_map.end()) {
-            SCVNS scv_tr_handle pred = it->second;
-            nbtx_last_req_handle_map.erase(it);
-            h.add_relation(rel_str(PREDECESSOR_SUCCESSOR), pred);
+        handles->open = h;
+        if(handles->last.is_valid()) {
+            h.add_relation(rel_str(PREDECESSOR_SUCCESSOR), handles->last);
+            handles->last = SCVNS scv_tr_handle();
         }
         break;
     case tlm::END_RESP:
-        it = nbtx_req_handle_map.find(rec_parts.id);
-        if(it != nbtx_req_handle_map.end()) {
-            h = it->second;
-            nbtx_req_handle_map.erase(it);
-            h.end_transaction();
+        handles = nbtx_handles.find(rec_parts.id);
+        if(handles) {
+            if(handles->open.is_valid())
+                handles->open.end_transaction();
+            nbtx_handles.erase(rec_parts.id);
         }
         break;
     default:
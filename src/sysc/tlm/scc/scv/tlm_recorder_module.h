@@ -62,6 +62,7 @@ public:
         add_attribute(recorder->enableNbTracing);
         add_attribute(recorder->enableTimedTracing);
         add_attribute(recorder->enableDmiTracing);
+        add_attribute(recorder->recordingFilter);
         // bind the sockets to the module
         is.bind(*recorder);
         ts.bind(*recorder);
@@ -0,0 +1,326 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <systemc>
+#include <tlm>
+#include <utility>
+#include <vector>
+
+//! @brief SystemC TLM
+namespace tlm {
+//! @brief SCC TLM utilities
+namespace scc {
+/**
+ * @brief selects the transactions a transaction recorder records
+ *
+ * The filter is evaluated before any transaction handle is created so rejected transactions only cost the evaluation
+ * of the rules. The rules are applied in the order command, address, sampling and rate limit; a transaction is recorded
+ * if it passes all configured rules:
+ * - command: only transactions having one of the given commands are recorded
+ * - address: only transactions accessing one of the given (inclusive) address ranges are recorded
+ * - sampling: only each N-th of the transactions passing the command and address rules is recorded
+ * - rate limit: at most N transactions are recorded per window of simulation time
+ *
+ * The rules can be given as string of semicolon separated clauses, e.g.
+ * @code
+ * cmd=read,write;addr=0x1000-0x1fff,0x8000-0x80ff;sample=16;rate=1000/1us
+ * @endcode
+ * An empty string removes all rules. Numbers are decimal, octal or hexadecimal, a clause having a negative, non-numeric
+ * or out of range number is invalid. Invalid clauses are reported as warning and leave the filter without rules.
+ */
+class tlm_recording_filter {
+public:
+    /**
+     * @brief adds an address range, transactions overlapping any of the ranges pass the address rule
+     *
+     * @param start the first address of the range
+     * @param end the last address of the range
+     */
+    void add_address_range(uint64_t start, uint64_t end) {
+        if(end < start)
+            std::swap(start, end);
+        ranges.emplace_back(start, end);
+        std::sort(std::begin(ranges), std::end(ranges));
+        // merge overlapping and adjacent ranges so that a lookup is a single binary search
+        auto out = std::begin(ranges);
+        for(auto it = std::next(out); it != std::end(ranges); ++it) {
+            if(out->second == UINT64_MAX || it->first <= out->second + 1)
+                out->second = std::max(out->second, it->second);
+            else
+                *++out = *it;
+        }
+        ranges.erase(std::next(out), std::end(ranges));
+        update_active();
+    }
+    /**
+     * @brief sets the commands passing the command rule
+     *
+     * @param read if true read commands pass
+     * @param write if true write commands pass
+     * @param ignore if true ignore commands pass
+     */
+    void set_commands(bool read, bool write, bool ignore) {
+        cmd_mask = (read ? 1U << tlm::TLM_READ_COMMAND : 0) | (write ? 1U << tlm::TLM_WRITE_COMMAND : 0) |
+                   (ignore ? 1U << tlm::TLM_IGNORE_COMMAND : 0);
+        update_active();
+    }
+    /**
+     * @brief sets the sampling rate
+     *
+     * @param n each n-th transaction passes the sampling rule, 0 and 1 disable sampling
+     */
+    void set_sampling(unsigned n) {
+        sample_rate = n > 1 ? n : 1;
+        sample_cnt = 0;
+        update_active();
+    }
+    /**
+     * @brief sets the rate limit
+     *
+     * @param max_tx the maximum number of transactions being recorded per window, 0 disables the limit
+     * @param window the length of the window
+     */
+    void set_rate_limit(uint64_t max_tx, sc_core::sc_time const& window) {
+        rate_max = window.value() ? max_tx : 0;
+        rate_window = window.value();
+        rate_start = 0;
+        rate_cnt = 0;
+        update_active();
+    }
+    //! removes all rules
+    void clear() {
+        ranges.clear();
+        cmd_mask = all_cmds;
+        set_sampling(1);
+        set_rate_limit(0, sc_core::SC_ZERO_TIME);
+    }
+    /**
+     * @brief replaces the rules by the ones given in textual form
+     *
+     * @param spec the rules as described in the class documentation
+     * @return false if the string could not be parsed, the filter has no rules then
+     */
+    bool parse(std::string const& spec) {
+        clear();
+        size_t pos = 0;
+        while(pos < spec.size()) {
+            auto end = spec.find(';', pos);
+            if(end == std::string::npos)
+                end = spec.size();
+            auto clause = trim(spec.substr(pos, end - pos));
+            pos = end + 1;
+            if(clause.empty())
+                continue;
+            auto eq = clause.find('=');
+            if(eq == std::string::npos || !parse_clause(trim(clause.substr(0, eq)), trim(clause.substr(eq + 1)))) {
+                SC_REPORT_WARNING("/SCC/tlm_recording_filter", ("invalid recording filter clause '" + clause + "'").c_str());
+                clear();
+                return false;
+            }
+        }
+        return true;
+    }
+    //! true if any rule is set
+    bool is_active() const { return active; }
+    /**
+     * @brief evaluates the rules for a transaction
+     *
+     * @param cmd the command of the transaction
+     * @param addr the address of the transaction
+     * @param length the data length of the transaction
+     * @param now the current simulation time
+     * @return true if the transaction shall be recorded
+     */
+    bool accept(tlm::tlm_command cmd, uint64_t addr, unsigned length, sc_core::sc_time const& now) {
+        if(!active)
+            return true;
+        if(!(cmd_mask & (1U << cmd)) || !in_range(addr, length) || !sampled() || !within_rate(now.value())) {
+            ++rejected_cnt;
+            return false;
+        }
+        ++accepted_cnt;
+        return true;
+    }
+    /**
+     * @brief evaluates the rules for a transaction
+     *
+     * @param trans the generic payload of the transaction
+     * @return true if the transaction shall be recorded
+     */
+    bool accept(tlm::tlm_generic_payload const& trans) {
+        return !active || accept(trans.get_command(), trans.get_address(), trans.get_data_length(), sc_core::sc_time_stamp());
+    }
+    //! the number of transactions which passed the filter
+    uint64_t get_accepted() const { return accepted_cnt; }
+    //! the number of transactions which were rejected by the filter
+    uint64_t get_rejected() const { return rejected_cnt; }
+
+private:
+    static constexpr unsigned all_cmds =
+        (1U << tlm::TLM_READ_COMMAND) | (1U << tlm::TLM_WRITE_COMMAND) | (1U << tlm::TLM_IGNORE_COMMAND);
+
+    void update_active() { active = !ranges.empty() || cmd_mask != all_cmds || sample_rate > 1 || rate_max > 0; }
+
+    bool in_range(uint64_t addr, unsigned length) const {
+        if(ranges.empty())
+            return true;
+        auto last = length ? addr + length - 1 : addr;
+        if(last < addr)
+            last = UINT64_MAX;
+        // the first range starting behind the last accessed address, the one before is the only candidate
+        auto it = std::upper_bound(std::begin(ranges), std::end(ranges), last,
+                                   [](uint64_t v, std::pair<uint64_t, uint64_t> const& r) { return v < r.first; });
+        return it != std::begin(ranges) && std::prev(it)->second >= addr;
+    }
+
+    bool sampled() {
+        if(sample_rate < 2)
+            return true;
+        if(++sample_cnt < sample_rate)
+            return false;
+        sample_cnt = 0;
+        return true;
+    }
+
+    bool within_rate(uint64_t now) {
+        if(!rate_max)
+            return true;
+        if(now - rate_start >= rate_window) {
+            rate_start = now - (now - rate_start) % rate_window;
+            rate_cnt = 0;
+        }
+        return rate_cnt++ < rate_max;
+    }
+
+    bool parse_clause(std::string const& key, std::string const& value) {
+        if(key == "cmd") {
+            bool rd{false}, wr{false}, ign{false};
+            for(auto const& c : split(value, ',')) {
+                if(c == "read")
+                    rd = true;
+                else if(c == "write")
+                    wr = true;
+                else if(c == "ignore")
+                    ign = true;
+                else
+                    return false;
+            }
+            set_commands(rd, wr, ign);
+            return true;
+        } else if(key == "addr") {
+            for(auto const& r : split(value, ',')) {
+                uint64_t start, end;
+                auto dash = r.find('-');
+                if(!to_uint(r.substr(0, dash), start) || (dash != std::string::npos && !to_uint(r.substr(dash + 1), end)))
+                    return false;
+                add_address_range(start, dash != std::string::npos ? end : start);
+            }
+            return true;
+        } else if(key == "sample") {
+            uint64_t n;
+            if(!to_uint(value, n) || n > std::numeric_limits<unsigned>::max())
+                return false;
+            set_sampling(static_cast<unsigned>(n));
+            return true;
+        } else if(key == "rate") {
+            auto slash = value.find('/');
+            uint64_t n;
+            sc_core::sc_time window;
+            if(slash == std::string::npos || !to_uint(value.substr(0, slash), n) || !to_time(trim(value.substr(slash + 1)), window))
+                return false;
+            set_rate_limit(n, window);
+            return true;
+        }
+        return false;
+    }
+
+    static std::string trim(std::string const& s) {
+        auto b = s.find_first_not_of(" \t");
+        if(b == std::string::npos)
+            return {};
+        return s.substr(b, s.find_last_not_of(" \t") - b + 1);
+    }
+
+    static std::vector<std::string> split(std::string const& s, char delim) {
+        std::vector<std::string> res;
+        size_t pos = 0;
+        do {
+            auto end = s.find(delim, pos);
+            if(end == std::string::npos)
+                end = s.size();
+            res.push_back(trim(s.substr(pos, end - pos)));
+            pos = end + 1;
+        } while(pos <= s.size());
+        return res;
+    }
+
+    // strtoull accepts a sign and wraps negative numbers around, so the number has to start with a digit
+    static bool to_uint(std::string const& s, uint64_t& v) {
+        auto str = trim(s);
+        if(str.empty() || !std::isdigit(static_cast<unsigned char>(str[0])))
+            return false;
+        char* end = nullptr;
+        errno = 0;
+        v = std::strtoull(str.c_str(), &end, 0);
+        return *end == 0 && errno != ERANGE;
+    }
+
+    static bool to_time(std::string const& s, sc_core::sc_time& t) {
+        char* end = nullptr;
+        auto v = std::strtod(s.c_str(), &end);
+        if(end == s.c_str())
+            return false;
+        auto unit = trim(end);
+        if(unit == "fs")
+            t = sc_core::sc_time(v, sc_core::SC_FS);
+        else if(unit == "ps")
+            t = sc_core::sc_time(v, sc_core::SC_PS);
+        else if(unit == "ns")
+            t = sc_core::sc_time(v, sc_core::SC_NS);
+        else if(unit == "us")
+            t = sc_core::sc_time(v, sc_core::SC_US);
+        else if(unit == "ms")
+            t = sc_core::sc_time(v, sc_core::SC_MS);
+        else if(unit == "s")
+            t = sc_core::sc_time(v, sc_core::SC_SEC);
+        else
+            return false;
+        return true;
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    unsigned cmd_mask{all_cmds};
+    unsigned sample_rate{1};
+    unsigned sample_cnt{0};
+    uint64_t rate_max{0};
+    uint64_t rate_window{0};
+    uint64_t rate_start{0};
+    uint64_t rate_cnt{0};
+    bool active{false};
+    uint64_t accepted_cnt{0};
+    uint64_t rejected_cnt{0};
+};
+} // namespace scc
+} // namespace tlm